@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui opengl quick quickwidgets network serialport
+QT       += core gui opengl quick quickwidgets network serialport concurrent
 
 CONFIG += console
 
@@ -30,6 +30,8 @@ DEFINES += QT_DEPRECATED_WARNINGS
 #DEFINES += DEBUG_VEC
 #DEFINES += TESTING
 #DEFINES += TEST_NMEA
+#DEFINES += BENCH_DUBINS
+#DEFINES += BENCH_TURN
 
 INCLUDEPATH += $$PWD/classes
 
@@ -47,11 +49,21 @@ SOURCES += main.cpp\
     classes/csection.cpp \
     testlists.cpp \
     classes/cnmea.cpp \
+    classes/cnmeaframer.cpp \
     classes/cvehicle.cpp \
     testnmea.cpp \
+    benchdubins.cpp \
+    benchturn.cpp \
     classes/ccontour.cpp \
+    classes/ccontourindex.cpp \
     formgps_opengl.cpp \
     classes/cboundary.cpp \
+    classes/cpolygonindex.cpp \
+    classes/cpolygonoffset.cpp \
+    classes/cpatchindex.cpp \
+    classes/cpatchfile.cpp \
+    classes/cfieldloader.cpp \
+    classes/ccoverageraster.cpp \
     formgps_ui.cpp \
     aogsettings.cpp \
     formgps_udpcomm.cpp \
@@ -60,6 +72,11 @@ SOURCES += main.cpp\
     formgps_sim.cpp \
     glutils.cpp \
     aogrenderer.cpp \
+    aogpositionworker.cpp \
+    aogsaveworker.cpp \
+    classes/cpositionsnapshot.cpp \
+    classes/cguidancesnapshot.cpp \
+    classes/clatencyhistogram.cpp \
     classes/cyouturn.cpp \
     classes/ctool.cpp \
     classes/ctram.cpp \
@@ -80,6 +97,8 @@ SOURCES += main.cpp\
     classes/crecordedpath.cpp \
     classes/cdubins.cpp \
     classes/csequence.cpp \
+    classes/csectionraster.cpp \
+    classes/cpatchbuffers.cpp \
     formgps_saveopen.cpp
 
 HEADERS  += formgps.h \
@@ -95,15 +114,28 @@ HEADERS  += formgps.h \
     classes/cmodulecomm.h \
     classes/csection.h \
     classes/cnmea.h \
+    classes/cnmeaframer.h \
     classes/cvehicle.h \
     classes/ccontour.h \
+    classes/ccontourindex.h \
     classes/cboundary.h \
+    classes/cpolygonindex.h \
+    classes/cpolygonoffset.h \
+    classes/cpatchindex.h \
+    classes/cpatchfile.h \
+    classes/cfieldloader.h \
+    classes/ccoverageraster.h \
     btnenum.h \
     qmlutil.h \
     aogsettings.h \ 
     common.h \
     glutils.h \
     aogrenderer.h \
+    aogpositionworker.h \
+    aogsaveworker.h \
+    classes/cpositionsnapshot.h \
+    classes/cguidancesnapshot.h \
+    classes/clatencyhistogram.h \
     classes/cyouturn.h \
     classes/ctool.h \
     classes/ctram.h \
@@ -123,7 +155,10 @@ HEADERS  += formgps.h \
     classes/cpointdata.h \
     classes/crecordedpath.h \
     classes/cdubins.h \
-    classes/csequence.h
+    classes/csequence.h \
+    classes/csectionraster.h \
+    classes/cpatchbuffers.h \
+    benchfield.h
 
 RESOURCES += \
     agopengps.qrc
@@ -0,0 +1,127 @@
+#include "aogpositionworker.h"
+#include <QSerialPort>
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+#include <QMutexLocker>
+#include <QDebug>
+#include "formgps.h"
+
+AOGPositionWorker::AOGPositionWorker(FormGPS *mf)
+    : QObject(), mf(mf), sp(NULL), udpSocket(NULL), serialOpen(0)
+{
+    clock.start();
+}
+
+void AOGPositionWorker::stop()
+{
+    stopUDP();
+    closeSerial();
+}
+
+void AOGPositionWorker::openSerial(const QString &portName, int baudRate)
+{
+    //close it first
+    closeSerial();
+
+    sp = new QSerialPort(this);
+    sp->setDataBits(QSerialPort::Data8);
+    sp->setParity(QSerialPort::NoParity);
+    sp->setStopBits(QSerialPort::OneStop);
+    sp->setPortName(portName);
+    sp->setBaudRate(baudRate);
+    connect(sp, SIGNAL(readyRead()), this, SLOT(readSerial()));
+
+    if (!sp->open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Couldn't open GPS port" << portName << ":" << sp->errorString();
+        emit serialError(portName, sp->errorString());
+        delete sp;
+        sp = NULL;
+        return;
+    }
+
+    //discard any stuff in the buffers
+    sp->clear(QSerialPort::AllDirections);
+    serialOpen.storeRelease(1);
+}
+
+void AOGPositionWorker::closeSerial()
+{
+    serialOpen.storeRelease(0);
+
+    if (sp)
+    {
+        sp->close();
+        delete sp;
+        sp = NULL;
+    }
+}
+
+void AOGPositionWorker::startUDP(int port)
+{
+    if (udpSocket) stopUDP();
+
+    udpSocket = new QUdpSocket(this);
+    udpSocket->bind(port); //by default, bind to all interfaces.
+
+    connect(udpSocket, SIGNAL(readyRead()), this, SLOT(readUDP()));
+}
+
+void AOGPositionWorker::stopUDP()
+{
+    if (udpSocket)
+    {
+        udpSocket->close();
+        delete udpSocket;
+        udpSocket = NULL;
+    }
+}
+
+void AOGPositionWorker::appendRaw(const QByteArray &data)
+{
+    qint64 received = clock.nsecsElapsed();
+    mf->pn.appendRaw(data);
+    processFixes(received);
+}
+
+void AOGPositionWorker::readSerial()
+{
+    if (!sp) return;
+
+    //read whatever is in port
+    qint64 received = clock.nsecsElapsed();
+    mf->pn.appendRaw(sp->readAll());
+    processFixes(received);
+}
+
+void AOGPositionWorker::readUDP()
+{
+    qint64 received = clock.nsecsElapsed();
+
+    //the ring is a fixed size, a burst just drops the oldest bytes
+    while (udpSocket->hasPendingDatagrams())
+        mf->pn.appendRaw(udpSocket->receiveDatagram().data());
+
+    processFixes(received);
+}
+
+void AOGPositionWorker::processFixes(qint64 receivedNsec)
+{
+    //scanForNMEA() stops after each GGA, RMC or OGI, so a burst with
+    //more than one fix in it gets every fix processed in order
+    forever
+    {
+        bool isNewFix;
+        {
+            //GUI handlers that rebuild field data take the same lock
+            QMutexLocker lock(&mf->fixLock);
+            isNewFix = mf->scanForNMEA();
+        }
+        if (!isNewFix) break;
+
+        //steer angle and distance for this fix are ready to go out
+        mf->fixLatency.add((clock.nsecsElapsed() - receivedNsec) / 1000);
+
+        emit fixProcessed();
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef AOGPOSITIONWORKER_H
+#define AOGPOSITIONWORKER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QString>
+#include <QElapsedTimer>
+
+class FormGPS;
+class QSerialPort;
+class QUdpSocket;
+
+//Lives in FormGPS::positionThread. Owns the GPS serial port and the
+//UDP socket, feeds the NMEA framer and runs scanForNMEA() as soon as
+//the bytes come in, so a fix never waits on a timer, a busy GUI or a
+//slow frame. Everything here is called through queued slots from the
+//GUI thread.
+class AOGPositionWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AOGPositionWorker(FormGPS *mf);
+
+    //safe to ask from any thread
+    inline bool isSerialOpen() const { return serialOpen.loadAcquire() != 0; }
+
+public slots:
+    void stop();
+
+    void openSerial(const QString &portName, int baudRate);
+    void closeSerial();
+
+    void startUDP(int port);
+    void stopUDP();
+
+    //simulator and test data
+    void appendRaw(const QByteArray &data);
+
+private slots:
+    void readSerial();
+    void readUDP();
+
+signals:
+    //a new fix is done and published in FormGPS::positionSnapshot
+    void fixProcessed();
+
+    //the GPS port could not be opened, error is QSerialPort's reason
+    void serialError(const QString &portName, const QString &error);
+
+private:
+    FormGPS *mf;
+    QSerialPort *sp;
+    QUdpSocket *udpSocket;
+    QAtomicInt serialOpen;
+
+    //receive to steer output timing for FormGPS::fixLatency
+    QElapsedTimer clock;
+
+    void processFixes(qint64 receivedNsec);
+};
+
+#endif // AOGPOSITIONWORKER_H
@@ -0,0 +1,60 @@
+#include "aogsaveworker.h"
+#include <QDir>
+#include <QDebug>
+#include "cpatchfile.h"
+
+AOGSaveWorker::AOGSaveWorker(QObject *parent) :
+    QObject(parent), syncEachSave(1)
+{
+}
+
+void AOGSaveWorker::enqueue(const AOGSaveBatch &batch)
+{
+    {
+        QMutexLocker lock(&queueLock);
+        queue.enqueue(batch);
+    }
+
+    QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+}
+
+void AOGSaveWorker::flush()
+{
+    QMetaObject::invokeMethod(this, "drain", Qt::BlockingQueuedConnection);
+}
+
+void AOGSaveWorker::drain()
+{
+    bool isSync = syncEachSave.loadAcquire() != 0;
+
+    for (;;)
+    {
+        AOGSaveBatch batch;
+        {
+            QMutexLocker lock(&queueLock);
+            if (queue.isEmpty()) return;
+            batch = queue.dequeue();
+        }
+
+        write(batch, isSync);
+    }
+}
+
+void AOGSaveWorker::write(const AOGSaveBatch &batch, bool isSync)
+{
+    QDir saveDir(batch.directoryName);
+    if (!saveDir.exists())
+    {
+        if (!saveDir.mkpath(batch.directoryName))
+        {
+            qWarning() << "Couldn't create path " << batch.directoryName;
+            return;
+        }
+    }
+
+    CPatchFile::saveSections(batch.directoryName, batch.patches, isSync);
+    CPatchFile::saveContour(batch.directoryName, batch.contours, isSync);
+    CPatchFile::appendLog(batch.directoryName, "NMEA_log.txt", batch.nmea, isSync);
+    CPatchFile::appendLog(batch.directoryName, "Elevation.txt", batch.elevation, isSync);
+    CPatchFile::writeLog(batch.directoryName, "Coverage.txt", batch.coverage, isSync);
+}
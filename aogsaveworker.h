@@ -0,0 +1,59 @@
+#ifndef AOGSAVEWORKER_H
+#define AOGSAVEWORKER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QQueue>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QString>
+#include <QSharedPointer>
+#include "csection.h"
+#include "vec3.h"
+
+//Everything one save writes. The lists are handed over whole: sealed
+//patches and finished contour strips are never changed again, so the
+//save thread can write them while the fix carries on.
+struct AOGSaveBatch
+{
+    QString directoryName;
+    QVector<QSharedPointer<TriangleList>> patches;
+    QVector<QSharedPointer<QVector<Vec3>>> contours;
+    QByteArray nmea;
+    QByteArray elevation;
+    QByteArray coverage; //replaces Coverage.txt
+};
+
+//Lives in FormGPS::saveThread. Field saves are queued from any thread
+//and appended to the field files here, in the order they were queued,
+//so neither the GUI nor the positioning thread ever waits on the disk.
+class AOGSaveWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AOGSaveWorker(QObject *parent = 0);
+
+    //safe from any thread
+    void enqueue(const AOGSaveBatch &batch);
+
+    //push every save through to the disk before returning, so a power
+    //cut loses at most the save that was being written. Off leaves it
+    //to the OS. Safe from any thread.
+    inline void setSyncEachSave(bool isSync) { syncEachSave.fetchAndStoreRelaxed(isSync ? 1 : 0); }
+
+    //wait until everything queued so far is written. Not from the
+    //save thread.
+    void flush();
+
+public slots:
+    void drain();
+
+private:
+    QMutex queueLock;
+    QQueue<AOGSaveBatch> queue;
+    QAtomicInt syncEachSave;
+
+    void write(const AOGSaveBatch &batch, bool isSync);
+};
+
+#endif // AOGSAVEWORKER_H
@@ -4,19 +4,109 @@
 #include <QColor>
 #include "common.h"
 #include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+
+static QMutex snapshotMutex;
+static QSharedPointer<const AOGSettingsSnapshot> currentSnapshot;
+static QAtomicInt snapshotDirty(1);
 
 QVariant AOGSettings::value(const QString &key, const QVariant &defaultvalue)
 {
     QVariant val;
     val = QSettings::value(key,QVariant::Invalid);
     if (val == QVariant::Invalid) {
-        setValue(key,defaultvalue);
+        //writing the default doesn't change anything the snapshot sees
+        QSettings::setValue(key,defaultvalue);
         return defaultvalue;
     }
 
     return val;
 }
 
+void AOGSettings::setValue(const QString &key, const QVariant &value)
+{
+    QSettings::setValue(key, value);
+    snapshotDirty.storeRelease(1);
+}
+
+static AOGSettingsSnapshot *loadSnapshot()
+{
+    USE_SETTINGS;
+    AOGSettingsSnapshot *s = new AOGSettingsSnapshot;
+
+    //vehicle
+    s->vehicleWheelbase = SETTINGS_VEHICLE_WHEELBASE;
+    s->vehicleAntennaPivot = SETTINGS_VEHICLE_ANTENNAPIVOT;
+    s->vehicleAntennaHeight = SETTINGS_VEHICLE_ANTENNAHEIGHT;
+    s->vehicleAntennaOffset = SETTINGS_VEHICLE_ANTENNAOFFSET;
+    s->vehicleMinFixStep = SETTINGS_VEHICLE_MINFIXSTEP;
+    s->vehicleHydLiftLookAhead = SETTINGS_VEHICLE_HYDLIFTLOOKAHEAD;
+    s->vehicleIsHydLiftOn = SETTINGS_VEHICLE_ISHYDLIFTON;
+    s->vehicleIsUsingDubinsTurn = SETTINGS_VEHICLE_ISUSINGDUBINSTURN;
+    s->vehicleMaxSteerAngle = SETTINGS_VEHICLE_MAXSTEERANGLE;
+    s->vehicleMaxAngularVelocity = SETTINGS_VEHICLE_MAXANGULARVELOCITY;
+    s->vehicleIsStanleyUsed = SETTINGS_VEHICLE_ISSTANLEYUSED;
+    s->vehicleStanleyGain = SETTINGS_VEHICLE_STANLEYGAIN;
+    s->vehicleStanleyHeadingErrorGain = SETTINGS_VEHICLE_STANLEYHEADINGERRORGAIN;
+    s->vehicleGoalPointLookAhead = SETTINGS_VEHICLE_GOALPOINTLOOKAHEAD;
+    s->vehicleDistanceMultiplier = SETTINGS_VEHICLE_DISTANCEMULTIPLIER;
+    s->vehicleLookAheadMinimum = SETTINGS_VEHICLE_LOOKAHEADMINIMUM;
+    s->vehicleLookAheadUTurnMult = SETTINGS_VEHICLE_LOOKAHEADUTURNMULT;
+    s->vehicleMinTurningRadius = SETTINGS_VEHICLE_MINTURNINGRADIUS;
+    s->vehicleYouTurnDistance = SETTINGS_VEHICLE_YOUTURNDISTANCE;
+    s->vehicleYouSkipWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
+
+    //tool
+    s->toolWidth = SETTINGS_TOOL_WIDTH;
+    s->toolOverlap = SETTINGS_TOOL_OVERLAP;
+    s->toolOffset = SETTINGS_TOOL_OFFSET;
+    s->toolHitchLength = SETTINGS_TOOL_HITCHLENGTH;
+    s->toolTrailingHitchLength = SETTINGS_TOOL_TRAILINGHITCHLENGTH;
+    s->toolTankTrailingHitchLength = SETTINGS_TOOL_TANKTRAILINGHITCHLENGTH;
+    s->toolIsTrailing = SETTINGS_TOOL_ISTRAILING;
+    s->toolIsTBT = SETTINGS_TOOL_ISTBT;
+    s->toolNumSections = SETTINGS_TOOL_NUMSECTIONS;
+    s->toolLookAheadOn = SETTINGS_TOOL_LOOKAHEADON;
+    s->toolLookAheadOff = SETTINGS_TOOL_LOOKAHEADOFF;
+    s->toolMinApplied = SETTINGS_TOOL_MINAPPLIED;
+    s->toolSlowSpeedCutoff = SETTINGS_TOOL_SLOWSPEEDCUTOFF;
+    s->toolOffDelay = SETTINGS_TOOL_OFFDELAY;
+    s->toolIsWorkSwitchEnabled = SETTINGS_TOOL_ISWORKSWITCHENABLED;
+
+    //gps
+    s->gpsLogNMEA = SETTINGS_GPS_LOGNMEA;
+    s->gpsLogElevation = SETTINGS_GPS_LOGELEVATION;
+    s->gpsIsRollFromGPS = SETTINGS_GPS_ISROLLFROMGPS;
+    s->gpsIsRollFromOGI = SETTINGS_GPS_ISROLLFROMOGI;
+    s->gpsIsRollFromAutosteer = SETTINGS_GPS_ISROLLFROMAUTOSTEER;
+    s->gpsIMURollZeroX16 = SETTINGS_GPS_IMUROLLZEROX16;
+    s->gpsIsHeadingCorrectionFromBrick = SETTINGS_GPS_ISHEADINGCORRECTIONFROMBRICK;
+    s->gpsIsHeadingCorrectionFromAutoSteer = SETTINGS_GPS_ISHEADINGCORRECTIONFROMAUTOSTEER;
+    s->gpsIsHeadingCorrectionFromExtUdp = SETTINGS_GPS_ISHEADINGCORRECTIONFROMEXTUDP;
+
+    //communications
+    s->commUdpIsOn = SETTINGS_COMM_UDPISON;
+
+    //display
+    s->displayShowBack = SETTINGS_DISPLAY_SHOWBACK;
+    s->displaySectionsColorDay = parseColorVector(SETTINGS_DISPLAY_SECTIONSCOLORDAY);
+
+    return s;
+}
+
+QSharedPointer<const AOGSettingsSnapshot> AOGSettings::snapshot()
+{
+    QMutexLocker lock(&snapshotMutex);
+
+    //readers holding the old one keep it until they are done
+    if (snapshotDirty.testAndSetOrdered(1, 0) || currentSnapshot.isNull())
+        currentSnapshot = QSharedPointer<const AOGSettingsSnapshot>(loadSnapshot());
+
+    return currentSnapshot;
+}
+
 QColor parseColor(QString setcolor)
 {
     //qDebug() << setcolor;
@@ -7,11 +7,79 @@
 #include <QVector3D>
 
 #include <QColor>
+#include <QSharedPointer>
+
+//Typed copy of the settings read on every fix. It is built once from
+//QSettings and replaced as a whole whenever a setting changes, so the
+//guidance and section code just reads plain fields.
+struct AOGSettingsSnapshot
+{
+    //vehicle
+    double vehicleWheelbase;
+    double vehicleAntennaPivot;
+    double vehicleAntennaHeight;
+    double vehicleAntennaOffset;
+    double vehicleMinFixStep;
+    double vehicleHydLiftLookAhead;
+    bool vehicleIsHydLiftOn;
+    bool vehicleIsUsingDubinsTurn;
+    double vehicleMaxSteerAngle;
+    double vehicleMaxAngularVelocity;
+    bool vehicleIsStanleyUsed;
+    double vehicleStanleyGain;
+    double vehicleStanleyHeadingErrorGain;
+    double vehicleGoalPointLookAhead;
+    double vehicleDistanceMultiplier;
+    double vehicleLookAheadMinimum;
+    double vehicleLookAheadUTurnMult;
+    double vehicleMinTurningRadius;
+    int vehicleYouTurnDistance;
+    int vehicleYouSkipWidth;
+
+    //tool
+    double toolWidth;
+    double toolOverlap;
+    double toolOffset;
+    double toolHitchLength;
+    double toolTrailingHitchLength;
+    double toolTankTrailingHitchLength;
+    bool toolIsTrailing;
+    bool toolIsTBT;
+    int toolNumSections;
+    double toolLookAheadOn;
+    double toolLookAheadOff;
+    int toolMinApplied;
+    double toolSlowSpeedCutoff;
+    double toolOffDelay;
+    bool toolIsWorkSwitchEnabled;
+
+    //gps
+    bool gpsLogNMEA;
+    bool gpsLogElevation;
+    bool gpsIsRollFromGPS;
+    bool gpsIsRollFromOGI;
+    bool gpsIsRollFromAutosteer;
+    int gpsIMURollZeroX16;
+    bool gpsIsHeadingCorrectionFromBrick;
+    bool gpsIsHeadingCorrectionFromAutoSteer;
+    bool gpsIsHeadingCorrectionFromExtUdp;
+
+    //communications
+    bool commUdpIsOn;
+
+    //display
+    bool displayShowBack;
+    QVector3D displaySectionsColorDay;
+};
 
 class AOGSettings : public QSettings
 {
 public:
     QVariant value(const QString &key, const QVariant &defaultvalue);
+    void setValue(const QString &key, const QVariant &value);
+
+    //current snapshot, rebuilt on first use after any setValue()
+    static QSharedPointer<const AOGSettingsSnapshot> snapshot();
 };
 
 QColor parseColor(QString setcolor);
@@ -22,6 +90,7 @@ int colorSettingStringToInt(QString colorSettingString);
 //Macros to use settings in a consistant way
 #define USE_SETTINGS AOGSettings settings
 #define SYNC_SETTINGS settings.sync()
+#define USE_SETTINGS_SNAPSHOT QSharedPointer<const AOGSettingsSnapshot> snapshot = AOGSettings::snapshot()
 
 // TOOL-related settings
 #define SETTINGS_TOOL_NAME			settings.   value("tool/name", "unnamed").toQString()
@@ -315,9 +384,18 @@ int colorSettingStringToInt(QString colorSettingString);
 #define SETTINGS_GPS_LOGNMEA			settings.   value("gps/logNMEA", false).toBool()
 #define SETTINGS_SET_GPS_LOGNMEA(VAL)	settings.setValue("gps/logNMEA",VAL)
 
+#define SETTINGS_GPS_LOGFIXLATENCY			settings.   value("gps/logFixLatency", false).toBool()
+#define SETTINGS_SET_GPS_LOGFIXLATENCY(VAL)	settings.setValue("gps/logFixLatency",VAL)
+
 #define SETTINGS_GPS_LOGELEVATION			settings.   value("gps/logElevation", false).toBool()
 #define SETTINGS_SET_GPS_LOGELEVATION(VAL)	settings.setValue("gps/logElevation",VAL)
 
+#define SETTINGS_FIELD_SYNCSAVES			settings.   value("field/syncSaves", true).toBool()
+#define SETTINGS_SET_FIELD_SYNCSAVES(VAL)	settings.setValue("field/syncSaves",VAL)
+
+#define SETTINGS_FIELD_COVERAGERESOLUTION			settings.   value("field/coverageResolution", 0.25).toDouble()
+#define SETTINGS_SET_FIELD_COVERAGERESOLUTION(VAL)	settings.setValue("field/coverageResolution",VAL)
+
 #define SETTINGS_GPS_EXPECTRTK			settings.   value("gps/expectRTK", true).toBool()
 #define SETTINGS_SET_GPS_EXPECTRTK(VAL)	settings.setValue("gps/expectRTK",VAL)
 
@@ -451,6 +529,9 @@ int colorSettingStringToInt(QString colorSettingString);
 #define SETTINGS_DISPLAY_SHOWBACK			settings.   value("display/showBack", false).toBool()
 #define SETTINGS_SET_DISPLAY_SHOWBACK(VAL)	settings.setValue("display/showBack",VAL)
 
+#define SETTINGS_DISPLAY_LOGFRAMESTATS			settings.   value("display/logFrameStats", false).toBool()
+#define SETTINGS_SET_DISPLAY_LOGFRAMESTATS(VAL)	settings.setValue("display/logFrameStats",VAL)
+
 //AUTOSTEER
 #define SETTINGS_AUTOSTEER_KO			settings.   value("autosteer/Ko", 5).toInt()
 #define SETTINGS_SET_AUTOSTEER_KO(VAL)	settings.setValue("autosteer/Ko",VAL)
@@ -0,0 +1,95 @@
+#ifdef BENCH_DUBINS
+#include <QElapsedTimer>
+#include <iostream>
+#include "cdubins.h"
+#include "cboundary.h"
+#include "cgeofence.h"
+#include "glm.h"
+#include "benchfield.h"
+
+//Times CDubins::GenerateDubins for the U-turns a headland pass asks
+//for, with and without the geofence check, and counts how many of the
+//fenced paths stray outside. The geofence is 6 m in from the bench
+//field's boundaries. Define BENCH_DUBINS along with TESTING, which
+//takes out the application's main.
+
+static void addFence(CGeoFence &gf, int bndNum)
+{
+    CGeoFenceLines fence;
+    fence.geoFenceLine = benchFieldLine(bndNum, 6);
+    fence.preCalcTurnLines();
+    gf.geoFenceArr.append(fence);
+}
+
+int main(int argc, char *argv[]) {
+    Q_UNUSED(argc);
+    Q_UNUSED(argv);
+
+    CBoundary bnd;
+    CGeoFence gf;
+
+    benchFieldBoundaries(bnd);
+    addFence(gf, 0);
+    addFence(gf, 1);
+
+    CDubinsTurningRadius = 8;
+    CDubins dubins;
+
+    const double toolWidth = 6;
+    const int passes = 25;
+    const int repeats = 200;
+
+    int found = 0;
+    int outside = 0;
+    int points = 0;
+
+    //make sure the paths are any good before timing them
+    for (int i = 0; i < passes; i++)
+    {
+        //heading north into the top headland, back down one tool width over
+        double e = -90 + i * toolWidth;
+        QVector<Vec3> path = dubins.GenerateDubins(Vec3(e, 225, 0), Vec3(e + toolWidth, 225, M_PI), bnd, gf);
+
+        if (path.size() > 0) found++;
+        points += path.size();
+        for (int j = 0; j < path.size(); j++)
+        {
+            if (!gf.isPointInsideGeoFences(bnd, path[j])) outside++;
+        }
+    }
+
+    std::cout << found << " of " << passes << " turns found, "
+              << points << " points, " << outside << " outside the fences" << std::endl;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int r = 0; r < repeats; r++)
+    {
+        for (int i = 0; i < passes; i++)
+        {
+            double e = -90 + i * toolWidth;
+            dubins.GenerateDubins(Vec3(e, 225, 0), Vec3(e + toolWidth, 225, M_PI), bnd, gf);
+        }
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    std::cout << "fenced: " << (nsecs / 1000.0) / (passes * repeats) << " us per call" << std::endl;
+
+    timer.restart();
+    for (int r = 0; r < repeats; r++)
+    {
+        for (int i = 0; i < passes; i++)
+        {
+            double e = -90 + i * toolWidth;
+            dubins.GenerateDubins(Vec3(e, 225, 0), Vec3(e + toolWidth, 225, M_PI));
+        }
+    }
+
+    nsecs = timer.nsecsElapsed();
+    std::cout << "unfenced: " << (nsecs / 1000.0) / (passes * repeats) << " us per call" << std::endl;
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef BENCHFIELD_H
+#define BENCHFIELD_H
+
+#include <QVector>
+#include "vec2.h"
+#include "cboundary.h"
+
+//The field benchdubins.cpp and benchturn.cpp both run on: a 200 x 250
+//boundary with a 28 x 28 obstacle in the middle, both rectangles.
+
+//the outer boundary and the obstacle, as set boundaries
+static inline void benchFieldBoundaries(CBoundary &bnd)
+{
+    CBoundaryLines outer, obstacle;
+    outer.isSet = true;
+    obstacle.isSet = true;
+    bnd.bndArr.append(outer);
+    bnd.bndArr.append(obstacle);
+}
+
+//boundary bndNum moved inset metres into the work area, so the outer
+//one shrinks and the obstacle grows. Roughly the 2 m point spacing the
+//fence and turn lines are built with.
+static inline QVector<Vec2> benchFieldLine(int bndNum, double inset)
+{
+    double minE, minN, maxE, maxN;
+    if (bndNum == 0)
+    {
+        minE = -100 + inset; maxE = 100 - inset;
+        minN = 0 + inset; maxN = 250 - inset;
+    }
+    else
+    {
+        minE = -14 - inset; maxE = 14 + inset;
+        minN = 106 - inset; maxN = 134 + inset;
+    }
+
+    QVector<Vec2> line;
+    for (double e = minE; e < maxE; e += 2) line.append(Vec2(e, minN));
+    for (double n = minN; n < maxN; n += 2) line.append(Vec2(maxE, n));
+    for (double e = maxE; e > minE; e -= 2) line.append(Vec2(e, maxN));
+    for (double n = maxN; n > minN; n -= 2) line.append(Vec2(minE, n));
+    return line;
+}
+
+#endif // BENCHFIELD_H
@@ -0,0 +1,118 @@
+#ifdef BENCH_TURN
+#include <QElapsedTimer>
+#include <iostream>
+#include <math.h>
+#include <stdlib.h>
+#include "cturn.h"
+#include "cboundary.h"
+#include "glm.h"
+#include "benchfield.h"
+
+//Checks CTurn::rayCastTurnLines against the 2 m stepping search
+//findClosestTurnPoint used to do, from random spots and headings in the
+//work area, then times both. The turn lines are 12 m in from the bench
+//field's boundaries. Define BENCH_TURN along with TESTING, which takes
+//out the application's main.
+
+static void addTurnLine(CTurn &turn, int bndNum)
+{
+    CTurnLines turnLine;
+    foreach (const Vec2 &pt, benchFieldLine(bndNum, 12))
+        turnLine.turnLine.append(Vec3(pt.easting, pt.northing, 0));
+    turnLine.calculateTurnHeadings();
+    turnLine.preCalcTurnLines();
+    turn.turnArr.append(turnLine);
+}
+
+//the old search, stepping along the ray testing every turn area
+static int steppingSearch(CTurn &turn, const CBoundary &bnd, Vec3 fromPt, double headAB, Vec3 &rayPt)
+{
+    Vec3 pt;
+
+    double cosHead = cos(headAB);
+    double sinHead = sin(headAB);
+
+    for (int b = 1; b < 1500; b += 2)
+    {
+        pt.easting = fromPt.easting + (sinHead * b);
+        pt.northing = fromPt.northing + (cosHead * b);
+
+        if (turn.turnArr[0].isPointInTurnWorkArea(pt))
+        {
+            for (int t = 1; t < bnd.bndArr.size(); t++)
+            {
+                if (!bnd.bndArr[t].isSet) continue;
+                if (bnd.bndArr[t].isDriveThru) continue;
+                if (bnd.bndArr[t].isDriveAround) continue;
+                if (turn.turnArr[t].isPointInTurnWorkArea(pt))
+                {
+                    rayPt = pt;
+                    return t;
+                }
+            }
+        }
+        else
+        {
+            rayPt = pt;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char *argv[]) {
+    Q_UNUSED(argc);
+    Q_UNUSED(argv);
+
+    CBoundary bnd;
+    CTurn turn;
+
+    benchFieldBoundaries(bnd);
+    addTurnLine(turn, 0);
+    addTurnLine(turn, 1);
+
+    //random spots in the work area with random headings
+    const int rays = 5000;
+    QVector<Vec3> from;
+    srand(1);
+    while (from.size() < rays)
+    {
+        Vec3 pt(-85 + 170.0 * rand() / RAND_MAX, 15 + 220.0 * rand() / RAND_MAX,
+                glm::twoPI * rand() / RAND_MAX);
+        if (!turn.turnArr[0].isPointInTurnWorkArea(pt) || turn.turnArr[1].isPointInTurnWorkArea(pt)) continue;
+        from.append(pt);
+    }
+
+    //make sure they agree before timing them
+    int sameTurn = 0;
+    double maxOff = 0;
+    Vec3 stepPt, exactPt;
+    for (int i = 0; i < rays; i++)
+    {
+        int stepNum = steppingSearch(turn, bnd, from[i], from[i].heading, stepPt);
+        int exactNum = turn.rayCastTurnLines(bnd, from[i], from[i].heading, 1500, exactPt);
+        if (stepNum != exactNum) continue;
+        sameTurn++;
+
+        double off = glm::distance(stepPt, exactPt);
+        if (off > maxOff) maxOff = off;
+    }
+
+    std::cout << sameTurn << " of " << rays << " found the same turn line, stepping is up to "
+              << maxOff << " m off" << std::endl;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < rays; i++) steppingSearch(turn, bnd, from[i], from[i].heading, stepPt);
+    qint64 nsecs = timer.nsecsElapsed();
+    std::cout << "stepping: " << (nsecs / 1000.0) / rays << " us per ray" << std::endl;
+
+    timer.restart();
+    for (int i = 0; i < rays; i++) turn.rayCastTurnLines(bnd, from[i], from[i].heading, 1500, exactPt);
+    nsecs = timer.nsecsElapsed();
+    std::cout << "ray cast: " << (nsecs / 1000.0) / rays << " us per ray" << std::endl;
+
+    return 0;
+}
+
+#endif
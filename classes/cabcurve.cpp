@@ -12,16 +12,16 @@
 #include "ctram.h"
 #include "ccamera.h"
 #include "cnmea.h"
+#include "cguidancesnapshot.h"
 #include "aogsettings.h"
 
 CABCurve::CABCurve(QObject *parent) : QObject(parent)
 {
-
+    tramGeneration = nextGeometryGeneration();
 }
 
-void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
-                         const CVehicle &vehicle,
-                         CYouTurn &yt, CTram &tram, const CCamera &camera)
+void CABCurve::drawCurve(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
+                         const CYouTurn &yt, CTram &tram, const CCamera &camera)
 {
     USE_SETTINGS;
 
@@ -33,49 +33,49 @@ void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
     GLHelperOneColor gldraw;
     ColorVertex cv;
 
-    if (!isEditing)
+    if (!g.isCurveEditing)
     {
-        int ptCount = refList.size();
-        if (refList.size() == 0) return;
+        int ptCount = g.refList.size();
+        if (g.refList.size() == 0) return;
 
         gl->glLineWidth(SETTINGS_DISPLAY_LINEWIDTH);
 
         cv.color = QVector4D(0.96, 0.2f, 0.2f, 1.0f);
         for (int h = 0; h < ptCount; h++) {
-            cv.vertex = QVector3D(refList[h].easting, refList[h].northing, 0);
+            cv.vertex = QVector3D(g.refList[h].easting, g.refList[h].northing, 0);
             gldraw_colors.append(cv);
         }
 
-        if (!isCurveSet)
+        if (!g.isCurveSet)
         {
             cv.color = QVector4D(0.930f, 0.0692f, 0.260f, 1.0f);
             ptCount--;
-            cv.vertex = QVector3D(refList[ptCount].easting, refList[ptCount].northing, 0);
+            cv.vertex = QVector3D(g.refList[ptCount].easting, g.refList[ptCount].northing, 0);
             gldraw_colors.append(cv);
 
-            cv.vertex = QVector3D(vehicle.pivotAxlePos.easting, vehicle.pivotAxlePos.northing, 0);
+            cv.vertex = QVector3D(g.pivotAxlePos.easting, g.pivotAxlePos.northing, 0);
         }
 
         gldraw_colors.draw(gl, mvp, GL_LINES, SETTINGS_DISPLAY_LINEWIDTH);
 
-        if (isFontOn && refList.size() > 410)
+        if (isFontOn && g.refList.size() > 410)
         {
             QColor color = QColor::fromRgbF(0.40f, 0.90f, 0.95f);
-            drawText3D(camera, gl, mvp, refList[201].easting, refList[201].northing, "&A", 1.0, true, color);
-            drawText3D(camera, gl, mvp, refList[refList.size() - 200].easting, refList[refList.size() - 200].northing, "&B", 1.0, true, color);
+            drawText3D(camera, gl, mvp, g.refList[201].easting, g.refList[201].northing, "&A", 1.0, true, color);
+            drawText3D(camera, gl, mvp, g.refList[g.refList.size() - 200].easting, g.refList[g.refList.size() - 200].northing, "&B", 1.0, true, color);
         }
 
         //just draw ref and smoothed line if smoothing window is open
-        if (isSmoothWindowOpen)
+        if (g.isSmoothWindowOpen)
         {
-            ptCount = smooList.size();
-            if (smooList.size() == 0) return;
+            ptCount = g.smooList.size();
+            if (g.smooList.size() == 0) return;
 
             gl->glLineWidth(SETTINGS_DISPLAY_LINEWIDTH);
             gldraw.clear();
 
             for (int h = 0; h < ptCount; h++)
-                gldraw.append(QVector3D(smooList[h].easting, smooList[h].northing, 0));
+                gldraw.append(QVector3D(g.smooList[h].easting, g.smooList[h].northing, 0));
 
             gldraw.draw(gl, mvp, QColor::fromRgbF(0.930f, 0.92f, 0.260f),
                         GL_LINES, SETTINGS_DISPLAY_LINEWIDTH);
@@ -83,33 +83,33 @@ void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
         }
         else //normal. Smoothing window is not open.
         {
-            ptCount = curList.size();
-            if (ptCount > 0 && isCurveSet)
+            ptCount = g.curList.size();
+            if (ptCount > 0 && g.isCurveSet)
             {
                 gldraw.clear();
 
                 for (int h = 0; h < ptCount; h++)
-                    gldraw.append(QVector3D(curList[h].easting, curList[h].northing, 0));
+                    gldraw.append(QVector3D(g.curList[h].easting, g.curList[h].northing, 0));
 
                 gldraw.draw(gl, mvp, QColor::fromRgbF(0.95f, 0.2f, 0.95f),
                             GL_LINE_STRIP, 2.0f);
 
                 if (SETTINGS_DISPLAY_ISPUREON && !SETTINGS_VEHICLE_ISSTANLEYUSED)
                 {
-                    if (ppRadiusCu < 100 && ppRadiusCu > -100)
+                    if (g.ppRadiusCu < 100 && g.ppRadiusCu > -100)
                     {
                         const int numSegments = 100;
                         double theta = glm::twoPI / numSegments;
                         double c = cos(theta);//precalculate the sine and cosine
                         double s = sin(theta);
-                        double x = ppRadiusCu;//we start at angle = 0
+                        double x = g.ppRadiusCu;//we start at angle = 0
                         double y = 0;
 
                         gl->glLineWidth(1);
                         gldraw.clear();
                         for (int ii = 0; ii < numSegments; ii++)
                         {
-                            gldraw.append(QVector3D(x + radiusPointCu.easting, y + radiusPointCu.northing, 0));//output vertex
+                            gldraw.append(QVector3D(x + g.radiusPointCu.easting, y + g.radiusPointCu.northing, 0));//output vertex
                             double t = x;//apply the rotation matrix
                             x = (c * x) - (s * y);
                             y = (s * t) + (c * y);
@@ -120,22 +120,22 @@ void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
 
                     //Draw lookahead Point
                     gldraw.clear();
-                    gldraw.append(QVector3D(goalPointCu.easting, goalPointCu.northing, 0.0));
+                    gldraw.append(QVector3D(g.goalPointCu.easting, g.goalPointCu.northing, 0.0));
                     gldraw.draw(gl, mvp, QColor::fromRgbF(1.0f, 0.5f, 0.95f),
                                 GL_POINTS, 4.0f);
                 }
 
-                yt.drawYouTurn(gl, mvp);
+                yt.drawYouTurn(g, gl, mvp);
 
-                if (yt.isYouTurnTriggered)
+                if (g.isYouTurnTriggered)
                 {
-                    ptCount = yt.ytList.size();
+                    ptCount = g.ytList.size();
                     if (ptCount > 0)
                     {
                         gldraw.clear();
                         for (int i = 0; i < ptCount; i++)
                         {
-                            gldraw.append(QVector3D(yt.ytList[i].easting, yt.ytList[i].northing, 0));
+                            gldraw.append(QVector3D(g.ytList[i].easting, g.ytList[i].northing, 0));
                         }
                         gldraw.draw(gl, mvp, QColor::fromRgbF(0.95f, 0.95f, 0.25f),
                                     GL_POINTS, 4.0f);
@@ -146,27 +146,27 @@ void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
         }
     }
 
-    if (isEditing)
+    if (g.isCurveEditing)
     {
-        int ptCount = refList.size();
-        if (refList.size() == 0) return;
+        int ptCount = g.refList.size();
+        if (g.refList.size() == 0) return;
 
         gl->glLineWidth(SETTINGS_DISPLAY_LINEWIDTH);
         gldraw.clear();
         for (int h = 0; h < ptCount; h++)
-            gldraw.append(QVector3D(refList[h].easting, refList[h].northing, 0));
+            gldraw.append(QVector3D(g.refList[h].easting, g.refList[h].northing, 0));
 
         gldraw.draw(gl, mvp, QColor::fromRgbF(0.930f, 0.2f, 0.260f),
                     GL_LINES, SETTINGS_DISPLAY_LINEWIDTH);
 
         //current line
-        if (curList.size() > 0 && isCurveSet)
+        if (g.curList.size() > 0 && g.isCurveSet)
         {
-            ptCount = curList.size();
+            ptCount = g.curList.size();
             gldraw.clear();
 
             for (int h = 0; h < ptCount; h++)
-                gldraw.append(QVector3D(curList[h].easting, curList[h].northing, 0));
+                gldraw.append(QVector3D(g.curList[h].easting, g.curList[h].northing, 0));
 
             gldraw.draw(gl, mvp, QColor::fromRgbF(0.95f, 0.2f, 0.950f),
                         GL_LINE_STRIP, SETTINGS_DISPLAY_LINEWIDTH);
@@ -176,15 +176,15 @@ void CABCurve::drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
         if (camera.camSetDistance > -200)
         {
             double toolWidth2 = tool_toolWidth - tool_toolOverlap;
-            double cosHeading2 = cos(-aveLineHeading);
-            double sinHeading2 = sin(-aveLineHeading);
+            double cosHeading2 = cos(-g.aveLineHeading);
+            double sinHeading2 = sin(-g.aveLineHeading);
 
             gldraw.clear();
             for (int i = 1; i <= 6; i++)
             {
                 for (int h = 0; h < ptCount; h++)
-                    gldraw.append(QVector3D((cosHeading2 * toolWidth2) + refList[h].easting,
-                                            (sinHeading2 * toolWidth2) + refList[h].northing, 0));
+                    gldraw.append(QVector3D((cosHeading2 * toolWidth2) + g.refList[h].easting,
+                                            (sinHeading2 * toolWidth2) + g.refList[h].northing, 0));
                 toolWidth2 = toolWidth2 + tool_toolWidth - tool_toolOverlap;
             }
             gldraw.draw(gl, mvp, QColor::fromRgbF(0.8f, 0.3f, 0.2f),
@@ -202,22 +202,35 @@ void CABCurve::drawTram(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
 {
     USE_SETTINGS;
 
-    GLHelperColors gldraw_colors;
-    ColorVertex cv;
+    if (tramList.size() < 1) return;
 
-    cv.color = QVector4D(0.8630f, 0.93692f, 0.3260f, 0.22);
-
-    for (int i = 0; i < tramList.size(); i++)
+    if (!isGeometryCurrent(&tramList, tramGeneration))
     {
-        gldraw_colors.clear();
-        for (int h = 0; h < tramList[i].size(); h++) {
-            cv.vertex = QVector3D(tramList[i][h].easting, tramList[i][h].northing, 0);
-            gldraw_colors.append(cv);
+        //all the tram lines in one strip, joined by triangles with no
+        //area like the sealed section patches
+        QVector<QVector3D> strip;
+
+        for (int i = 0; i < tramList.size(); i++)
+        {
+            if (tramList[i].size() < 2) continue;
+
+            if (strip.size() > 0)
+            {
+                strip.append(strip.last());
+                strip.append(QVector3D(tramList[i][0].easting, tramList[i][0].northing, 0));
+                if (strip.size() & 1) strip.append(strip.last());
+            }
+
+            for (int h = 0; h < tramList[i].size(); h++)
+                strip.append(QVector3D(tramList[i][h].easting, tramList[i][h].northing, 0));
         }
 
-        gldraw_colors.draw(gl, mvp, GL_TRIANGLE_STRIP, SETTINGS_DISPLAY_LINEWIDTH);
+        uploadGeometry(&tramList, tramGeneration, strip);
     }
 
+    drawGeometry(gl, mvp, &tramList, QColor::fromRgbF(0.8630f, 0.93692f, 0.3260f, 0.22),
+                 GL_TRIANGLE_STRIP, SETTINGS_DISPLAY_LINEWIDTH);
+
     /*TODO implement font drawing
     if (mf.font.isFontOn)
     {
@@ -283,6 +296,8 @@ void CABCurve::buildTram(CBoundary &bnd, CTram &tram)
         }
         tramList.append(tramArr); //TODO: not sure about this translation, might have to play with SharedPointers
     }
+
+    tramGeneration = nextGeometryGeneration();
 }
 
 void CABCurve::smoothAB(int smPts)
@@ -351,6 +366,7 @@ void CABCurve::calculateTurnHeadings()
             refList.append(pt3);
         }
     }
+    refListChanged();
 }
 
 void CABCurve::saveSmoothAsRefList()
@@ -372,20 +388,21 @@ void CABCurve::saveSmoothAsRefList()
         if (arr[i].heading < 0) arr[i].heading += glm::twoPI;
         refList.append(arr[i]);
     }
+    refListChanged();
 }
 
 void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
                                    CVehicle &vehicle, CYouTurn &yt,
                                    CNMEA &pn)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double wheelbase = SETTINGS_VEHICLE_WHEELBASE;
-    double maxSteerAngle = SETTINGS_VEHICLE_MAXSTEERANGLE;
-    double maxAngularVelocity = SETTINGS_VEHICLE_MAXANGULARVELOCITY;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    double wheelbase = snapshot->vehicleWheelbase;
+    double maxSteerAngle = snapshot->vehicleMaxSteerAngle;
+    double maxAngularVelocity = snapshot->vehicleMaxAngularVelocity;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
     int ptCount = refList.size();
     int ptCnt = ptCount - 1;
@@ -409,18 +426,34 @@ void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
     boxB.easting -= (sin(aveLineHeading) * 1.0);
     boxB.northing -= (cos(aveLineHeading) * 1.0);
 
-    //determine if point are in frustum box
-    for (int s = 0; s < ptCnt; s++)
+    //determine if point are in frustum box, near where it was last
+    //fix first and the whole line only if it's not there
+    bool isFound = false;
+    if (closestRefIndex < ptCnt)
     {
-        if ((((boxB.easting - boxA.easting) * (refList[s].northing - boxA.northing))
-                - ((boxB.northing - boxA.northing) * (refList[s].easting - boxA.easting))) < 0) { continue; }
+        int start = qMax(0, closestRefIndex - SEARCHWINDOW);
+        int end = qMin(ptCnt, closestRefIndex + SEARCHWINDOW + 1);
+        for (int s = start; s < end; s++)
+        {
+            if (!isRefPointInBox(s)) continue;
 
-        if ((((boxD.easting - boxC.easting) * (refList[s].northing - boxC.northing))
-                - ((boxD.northing - boxC.northing) * (refList[s].easting - boxC.easting))) < 0) { continue; }
+            closestRefIndex = s;
+            isFound = true;
+            break;
+        }
+    }
+
+    if (!isFound)
+    {
+        for (int s = 0; s < ptCnt; s++)
+        {
+            if (!isRefPointInBox(s)) continue;
 
-        closestRefIndex = s;
-        break;
+            closestRefIndex = s;
+            break;
+        }
     }
+    if (closestRefIndex >= ptCnt) closestRefIndex = 0;
 
     double dist = ((pivot.easting - refList[closestRefIndex].easting) * (pivot.easting - refList[closestRefIndex].easting))
                     + ((pivot.northing - refList[closestRefIndex].northing) * (pivot.northing - refList[closestRefIndex].northing));
@@ -477,43 +510,40 @@ void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
 
     //double toolOffset = tool_toolOffset;
 
-    //build the current line
-    curList.clear();
-    for (int i = 0; i < ptCount; i++)
+    //build the current line, only if it's a different pass or the ref
+    //line changed since last time
+    double offsetEasting = sin(piSide + aveLineHeading) * ((widthMinusOverlap * howManyPathsAway));
+    double offsetNorthing = cos(piSide + aveLineHeading) * ((widthMinusOverlap * howManyPathsAway));
+
+    bool isRefChanged = curListRefData != refList.constData() || curListRefSize != ptCount
+            || curListRefVersion != refListVersion;
+
+    if (isRefChanged || curListOffsetEasting != offsetEasting
+            || curListOffsetNorthing != offsetNorthing || curList.size() != ptCount)
     {
-        Vec3 point = Vec3(
-            refList[i].easting + (sin(piSide + aveLineHeading) * ((widthMinusOverlap * howManyPathsAway))),
-            refList[i].northing + (cos(piSide + aveLineHeading) * ((widthMinusOverlap * howManyPathsAway))),
-            refList[i].heading);
-        curList.append(point);
-    }
+        curList.resize(ptCount);
+        for (int i = 0; i < ptCount; i++)
+        {
+            curList[i].easting = refList[i].easting + offsetEasting;
+            curList[i].northing = refList[i].northing + offsetNorthing;
+            curList[i].heading = refList[i].heading;
+        }
 
-    double minDistA = 1000000, minDistB = 1000000;
+        curListOffsetEasting = offsetEasting;
+        curListOffsetNorthing = offsetNorthing;
+        curListRefData = refList.constData();
+        curListRefSize = ptCount;
+        curListRefVersion = refListVersion;
+    }
 
     ptCount = curList.size();
 
     if (ptCount > 0)
     {
-        if (SETTINGS_VEHICLE_ISSTANLEYUSED)
+        if (snapshot->vehicleIsStanleyUsed)
         {
             //find the closest 2 points to current fix
-            for (int t = 0; t < ptCount; t++)
-            {
-                dist = ((steer.easting - curList[t].easting) * (steer.easting - curList[t].easting))
-                                + ((steer.northing - curList[t].northing) * (steer.northing - curList[t].northing));
-                if (dist < minDistA)
-                {
-                    minDistB = minDistA;
-                    B = A;
-                    minDistA = dist;
-                    A = t;
-                }
-                else if (dist < minDistB)
-                {
-                    minDistB = dist;
-                    B = t;
-                }
-            }
+            findClosestCurPoints(steer, isRefChanged);
 
             //just need to make sure the points continue ascending or heading switches all over the place
             if (A > B) { C = A; A = B; B = C; }
@@ -580,11 +610,11 @@ void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
             if (abFixHeadingDelta > glm::PIBy2) abFixHeadingDelta -= M_PI;
             else if (abFixHeadingDelta < -glm::PIBy2) abFixHeadingDelta += M_PI;
 
-            abFixHeadingDelta *= SETTINGS_VEHICLE_STANLEYHEADINGERRORGAIN;
+            abFixHeadingDelta *= snapshot->vehicleStanleyHeadingErrorGain;
             if (abFixHeadingDelta > 0.74) abFixHeadingDelta = 0.74;
             if (abFixHeadingDelta < -0.74) abFixHeadingDelta = -0.74;
 
-            steerAngleCu = atan((distanceFromCurrentLine * SETTINGS_VEHICLE_STANLEYGAIN) /
+            steerAngleCu = atan((distanceFromCurrentLine * snapshot->vehicleStanleyGain) /
                                 ((fabs(pn.speed) * 0.277777) + 1));
 
             if (steerAngleCu > 0.74) steerAngleCu = 0.74;
@@ -604,23 +634,7 @@ void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
         else
         {
             //find the closest 2 points to current fix
-            for (int t = 0; t < ptCount; t++)
-            {
-                dist = ((pivot.easting - curList[t].easting) * (pivot.easting - curList[t].easting))
-                                + ((pivot.northing - curList[t].northing) * (pivot.northing - curList[t].northing));
-                if (dist < minDistA)
-                {
-                    minDistB = minDistA;
-                    B = A;
-                    minDistA = dist;
-                    A = t;
-                }
-                else if (dist < minDistB)
-                {
-                    minDistB = dist;
-                    B = t;
-                }
-            }
+            findClosestCurPoints(pivot, isRefChanged);
 
             //just need to make sure the points continue ascending or heading switches all over the place
             if (A > B) { C = A; A = B; B = C; }
@@ -841,6 +855,63 @@ void CABCurve::getCurrentCurveLine(Vec3 pivot, Vec3 steer,
     }
 }
 
+bool CABCurve::isRefPointInBox(int s) const
+{
+    if ((((boxB.easting - boxA.easting) * (refList[s].northing - boxA.northing))
+            - ((boxB.northing - boxA.northing) * (refList[s].easting - boxA.easting))) < 0) { return false; }
+
+    if ((((boxD.easting - boxC.easting) * (refList[s].northing - boxC.northing))
+            - ((boxD.northing - boxC.northing) * (refList[s].easting - boxC.easting))) < 0) { return false; }
+
+    return true;
+}
+
+//Sets A and B to the two curList points closest to pos. Only looks
+//around last fix's currentLocationIndex unless the line is new or the
+//closest point is right at the edge of that window.
+void CABCurve::findClosestCurPoints(const Vec3 &pos, bool isFullSearch)
+{
+    int ptCount = curList.size();
+
+    if (isFullSearch || currentLocationIndex < 0 || currentLocationIndex >= ptCount)
+    {
+        closestTwoCurPoints(pos, 0, ptCount);
+        return;
+    }
+
+    int start = qMax(0, currentLocationIndex - SEARCHWINDOW);
+    int end = qMin(ptCount, currentLocationIndex + SEARCHWINDOW + 1);
+    closestTwoCurPoints(pos, start, end);
+
+    //moved further than the window, do the whole thing
+    if ((A == start && start > 0) || (A == end - 1 && end < ptCount))
+        closestTwoCurPoints(pos, 0, ptCount);
+}
+
+void CABCurve::closestTwoCurPoints(const Vec3 &pos, int start, int end)
+{
+    double minDistA = 1000000, minDistB = 1000000;
+    double dist;
+
+    for (int t = start; t < end; t++)
+    {
+        dist = ((pos.easting - curList[t].easting) * (pos.easting - curList[t].easting))
+                        + ((pos.northing - curList[t].northing) * (pos.northing - curList[t].northing));
+        if (dist < minDistA)
+        {
+            minDistB = minDistA;
+            B = A;
+            minDistA = dist;
+            A = t;
+        }
+        else if (dist < minDistB)
+        {
+            minDistB = dist;
+            B = t;
+        }
+    }
+}
+
 void CABCurve::snapABCurve()
 {
     double headingAt90;
@@ -875,6 +946,7 @@ void CABCurve::snapABCurve()
         arr[i].northing = (cos(headingAt90 + arr[i].heading) * fabs(distanceFromCurrentLine) * 0.001) + arr[i].northing;
         refList.append(arr[i]);
     }
+    refListChanged();
 }
 
 void CABCurve::moveABCurve(double dist)
@@ -904,7 +976,7 @@ void CABCurve::moveABCurve(double dist)
         arr[i].northing = (cos(headingAt90 + arr[i].heading) * dist) + arr[i].northing;
         refList.append(arr[i]);
     }
-
+    refListChanged();
 }
 
 bool CABCurve::pointOnLine(Vec3 pt1, Vec3 pt2, Vec3 pt)
@@ -952,13 +1024,14 @@ void CABCurve::addFirstLastPoints()
         pt.northing -= (cos(pt.heading) * i);
         refList.insert(0, pt);
     }
-
+    refListChanged();
 }
 
 void CABCurve::resetCurveLine()
 {
     curList.clear();
     refList.clear();
+    refListChanged();
     isCurveSet = false;
     isOkToAddPoints = false;
     closestRefIndex = 0;
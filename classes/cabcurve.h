@@ -12,6 +12,7 @@ class CVehicle;
 class CYouTurn;
 class CTram;
 class CCamera;
+struct CGuidanceState;
 class CBoundary;
 class CNMEA;
 
@@ -33,6 +34,20 @@ private:
     int closestRefIndex = 0;
     int A, B, C;
 
+    //curList is refList moved over by this much. It's only rebuilt
+    //when the pass or the ref line changes.
+    double curListOffsetEasting = 0, curListOffsetNorthing = 0;
+    const Vec3 *curListRefData = NULL;
+    int curListRefSize = -1, curListRefVersion = -1;
+    int refListVersion = 0;
+
+    //how far either side of last fix's index to look, in points
+    static const int SEARCHWINDOW = 40;
+
+    bool isRefPointInBox(int s) const;
+    void findClosestCurPoints(const Vec3 &pos, bool isFullSearch);
+    void closestTwoCurPoints(const Vec3 &pos, int start, int end);
+
 public:
     //flag for starting stop adding points
     bool isBtnCurveOn, isOkToAddPoints, isCurveSet;
@@ -76,12 +91,14 @@ public:
     bool isEditing;
     QVector<Vec2> tramArr;
     QVector<QVector<Vec2>> tramList;
+    //new every time buildTram() runs, so the tram strips are only
+    //uploaded again when they change
+    int tramGeneration;
 
     explicit CABCurve(QObject *parent = 0);
-    void drawCurve(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
-                   const CVehicle &vehicle,
-                   CYouTurn &yt, CTram &tram, const CCamera &camera
-                   );
+    //draws the curve as it was at the last fix
+    void drawCurve(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
+                   const CYouTurn &yt, CTram &tram, const CCamera &camera);
 
     void drawTram(QOpenGLFunctions *gl, const QMatrix4x4 &mvp);
 
@@ -97,6 +114,9 @@ public:
     void addFirstLastPoints();
     void resetCurveLine();
 
+    //call after changing refList in place
+    inline void refListChanged() { refListVersion++; }
+
 
 signals:
     void doSequence(CYouTurn &yt);
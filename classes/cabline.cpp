@@ -10,6 +10,7 @@
 #include <QColor>
 #include "glutils.h"
 #include "cnmea.h"
+#include "cguidancesnapshot.h"
 
 //??? why does CABLine refer to mf.ABLine? Isn't there only one instance and
 //thus was can just use "this."  If this is wrong, we'll remove this and fix it.
@@ -104,16 +105,16 @@ void CABLine::snapABLine()
 //called from main form
 void CABLine::getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTurn &yt, CNMEA &pn)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double wheelbase = SETTINGS_VEHICLE_WHEELBASE;
-    double maxSteerAngle = SETTINGS_VEHICLE_MAXSTEERANGLE;
-    double maxAngularVelocity = SETTINGS_VEHICLE_MAXANGULARVELOCITY;
+    double wheelbase = snapshot->vehicleWheelbase;
+    double maxSteerAngle = snapshot->vehicleMaxSteerAngle;
+    double maxAngularVelocity = snapshot->vehicleMaxAngularVelocity;
 
-    double toolWidth = SETTINGS_TOOL_WIDTH;
-    double toolOverlap = SETTINGS_TOOL_OVERLAP;
+    double toolWidth = snapshot->toolWidth;
+    double toolOverlap = snapshot->toolOverlap;
 
-    if (SETTINGS_VEHICLE_ISSTANLEYUSED) {
+    if (snapshot->vehicleIsStanleyUsed) {
         //move the ABLine over based on the overlap amount set in vehicle
         double widthMinusOverlap = toolWidth - toolOverlap;
 
@@ -141,7 +142,7 @@ void CABLine::getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTu
         passNumber = int(refLineSide * howManyPathsAway);
 
         //calculate the new point that is number of implement widths over
-        double toolOffset = SETTINGS_TOOL_OFFSET;
+        double toolOffset = snapshot->toolOffset;
         Vec2 point1;
 
         //depending which way you are going, the offset can be either side
@@ -225,11 +226,11 @@ void CABLine::getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTu
         if (abFixHeadingDelta > glm::PIBy2) abFixHeadingDelta -= M_PI;
         else if (abFixHeadingDelta < -glm::PIBy2) abFixHeadingDelta += M_PI;
 
-        abFixHeadingDelta *= SETTINGS_VEHICLE_STANLEYHEADINGERRORGAIN;
+        abFixHeadingDelta *= snapshot->vehicleStanleyHeadingErrorGain;
         if (abFixHeadingDelta > 0.4) abFixHeadingDelta = 0.4;
         if (abFixHeadingDelta < -0.4) abFixHeadingDelta = -0.4;
 
-        steerAngleAB = atan((distanceFromCurrentLine * SETTINGS_VEHICLE_STANLEYGAIN) / ((fabs(pn.speed) * 0.277777) + 1));
+        steerAngleAB = atan((distanceFromCurrentLine * snapshot->vehicleStanleyGain) / ((fabs(pn.speed) * 0.277777) + 1));
 
         if (steerAngleAB > 0.4) steerAngleAB = 0.4;
         if (steerAngleAB < -0.4) steerAngleAB = -0.4;
@@ -274,7 +275,7 @@ void CABLine::getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTu
         passNumber = int(refLineSide * howManyPathsAway);
 
         //calculate the new point that is number of implement widths over
-        double toolOffset = SETTINGS_TOOL_OFFSET;
+        double toolOffset = snapshot->toolOffset;
         Vec2 point1;
 
         //depending which way you are going, the offset can be either side
@@ -418,8 +419,8 @@ void CABLine::getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTu
     }
 }
 
-void CABLine::drawABLines(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
-                          CYouTurn &yt, CTram &tram, const CCamera &camera)
+void CABLine::drawABLines(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
+                          const CYouTurn &yt, CTram &tram, const CCamera &camera)
 {
     USE_SETTINGS;
 
@@ -427,193 +428,128 @@ void CABLine::drawABLines(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
     double tool_toolOffset = SETTINGS_TOOL_OFFSET;
     double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
 
-	QOpenGLBuffer abBuffer;
+	GLHelperOneColor gldraw;
+	GLHelperColors gldrawcolors;
 	QColor color;
 
 
     //Draw AB Points
-    ColorVertex abpoints[2] = { { QVector3D(refPoint1.easting, refPoint1.northing, 0.0), 
-                                  QVector4D(0.95f, 0.0f, 0.0f, 1.0f) },
-
-                                { QVector3D(refPoint2.easting, refPoint2.northing, 0.0),
-                                  QVector4D(0.0f, 0.9f, 0.95f, 1.0f) } };
-
-    abBuffer.create();
-    abBuffer.bind();
-    abBuffer.allocate(abpoints, 2 * sizeof(ColorVertex));
-    abBuffer.release();
+    gldrawcolors.append({ QVector3D(g.refPoint1.easting, g.refPoint1.northing, 0.0),
+                          QVector4D(0.95f, 0.0f, 0.0f, 1.0f) });
+    gldrawcolors.append({ QVector3D(g.refPoint2.easting, g.refPoint2.northing, 0.0),
+                          QVector4D(0.0f, 0.9f, 0.95f, 1.0f) });
 
-    glDrawArraysColors(gl, mvp,
-                       GL_POINTS, abBuffer,
-                       GL_FLOAT, 2, 8.0f);
+    gldrawcolors.draw(gl, mvp, GL_POINTS, 8.0f);
 
-    drawText3D(camera, gl, mvp, refPoint1.easting, refPoint1.northing, "&A");
-    drawText3D(camera, gl, mvp, refPoint2.easting, refPoint2.northing, "&B");
+    drawText3D(camera, gl, mvp, g.refPoint1.easting, g.refPoint1.northing, "&A");
+    drawText3D(camera, gl, mvp, g.refPoint2.easting, g.refPoint2.northing, "&B");
 
     //Draw reference AB line
 
-    QVector3D abline[2] = { QVector3D(refABLineP1.easting, refABLineP1.northing, 0),
-                            QVector3D(refABLineP2.easting, refABLineP2.northing, 0) };
-
-    if (abBuffer.isCreated())
-        abBuffer.destroy();
-    abBuffer.create();
-    abBuffer.bind();
-    abBuffer.allocate(abline, 2 * sizeof(QVector3D));
-    abBuffer.release();
-
+    gldraw.append(QVector3D(g.refABLineP1.easting, g.refABLineP1.northing, 0));
+    gldraw.append(QVector3D(g.refABLineP2.easting, g.refABLineP2.northing, 0));
 
     //TODO: make a dotted line in OpenGL ES with shader
     //gl->glLineStipple(1, 0x07F0);
     color = QColor::fromRgbF(0.93f, 0.2f, 0.2f, 1.0f);
-    glDrawArraysColor(gl,mvp,
-                      GL_LINES, color, abBuffer,
-                      GL_FLOAT, 2, 1.0f);
-
-    //draw current AB Line, reuse old array and buffer
-    abline[0] = QVector3D(currentABLineP1.easting, currentABLineP1.northing, 0.0);
-    abline[1] = QVector3D(currentABLineP2.easting, currentABLineP2.northing, 0.0);
+    gldraw.draw(gl, mvp, color, GL_LINES, 1.0f);
 
-    if (abBuffer.isCreated())
-        abBuffer.destroy();
-    abBuffer.create();
-    abBuffer.bind();
-    abBuffer.allocate(abline, 2 * sizeof(QVector3D));
-    abBuffer.release();
+    //draw current AB Line
+    gldraw.clear();
+    gldraw.append(QVector3D(g.currentABLineP1.easting, g.currentABLineP1.northing, 0.0));
+    gldraw.append(QVector3D(g.currentABLineP2.easting, g.currentABLineP2.northing, 0.0));
 
     color = QColor::fromRgbF(0.95f, 0.0f, 0.95f, 1.0f);
-    glDrawArraysColor(gl,mvp,
-                      GL_LINES, color, abBuffer,
-                      GL_FLOAT, 2, 1.0f);
+    gldraw.draw(gl, mvp, color, GL_LINES, 1.0f);
 
-    if (!isEditing) {
+    if (!g.isABEditing) {
         if (SETTINGS_DISPLAY_SIDEGUIDELINES && camera.camSetDistance > tool_toolWidth * -120) {
             //get the tool offset and width
             double toolOffset = tool_toolOffset * 2;
             double toolWidth = tool_toolWidth - tool_toolOverlap;
-            double cosHeading = cos(-abHeading);
-            double sinHeading = sin(-abHeading);
+            double cosHeading = cos(-g.abHeading);
+            double sinHeading = sin(-g.abHeading);
 
-            QVector<QVector3D> vertices;
-            if (isABSameAsVehicleHeading) {
-                vertices.append(QVector3D((cosHeading * (toolWidth + toolOffset)) + currentABLineP1.easting, (sinHeading * (toolWidth + toolOffset)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (toolWidth + toolOffset)) + currentABLineP2.easting, (sinHeading * (toolWidth + toolOffset)) + currentABLineP2.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth + toolOffset)) + currentABLineP1.easting, (sinHeading * (-toolWidth + toolOffset)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth + toolOffset)) + currentABLineP2.easting, (sinHeading * (-toolWidth + toolOffset)) + currentABLineP2.northing, 0));
+            GLHelperOneColor vertices;
+            if (g.isABSameAsVehicleHeading) {
+                vertices.append(QVector3D((cosHeading * (toolWidth + toolOffset)) + g.currentABLineP1.easting, (sinHeading * (toolWidth + toolOffset)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (toolWidth + toolOffset)) + g.currentABLineP2.easting, (sinHeading * (toolWidth + toolOffset)) + g.currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth + toolOffset)) + g.currentABLineP1.easting, (sinHeading * (-toolWidth + toolOffset)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth + toolOffset)) + g.currentABLineP2.easting, (sinHeading * (-toolWidth + toolOffset)) + g.currentABLineP2.northing, 0));
 
                 toolWidth *= 2;
-                vertices.append(QVector3D((cosHeading * toolWidth) + currentABLineP1.easting, (sinHeading * toolWidth) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * toolWidth) + currentABLineP2.easting, (sinHeading * toolWidth) + currentABLineP2.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth)) + currentABLineP1.easting, (sinHeading * (-toolWidth)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth)) + currentABLineP2.easting, (sinHeading * (-toolWidth)) + currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * toolWidth) + g.currentABLineP1.easting, (sinHeading * toolWidth) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * toolWidth) + g.currentABLineP2.easting, (sinHeading * toolWidth) + g.currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth)) + g.currentABLineP1.easting, (sinHeading * (-toolWidth)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth)) + g.currentABLineP2.easting, (sinHeading * (-toolWidth)) + g.currentABLineP2.northing, 0));
             } else {
-                vertices.append(QVector3D((cosHeading * (toolWidth - toolOffset)) + currentABLineP1.easting, (sinHeading * (toolWidth - toolOffset)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (toolWidth - toolOffset)) + currentABLineP2.easting, (sinHeading * (toolWidth - toolOffset)) + currentABLineP2.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth - toolOffset)) + currentABLineP1.easting, (sinHeading * (-toolWidth - toolOffset)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth - toolOffset)) + currentABLineP2.easting, (sinHeading * (-toolWidth - toolOffset)) + currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * (toolWidth - toolOffset)) + g.currentABLineP1.easting, (sinHeading * (toolWidth - toolOffset)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (toolWidth - toolOffset)) + g.currentABLineP2.easting, (sinHeading * (toolWidth - toolOffset)) + g.currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth - toolOffset)) + g.currentABLineP1.easting, (sinHeading * (-toolWidth - toolOffset)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth - toolOffset)) + g.currentABLineP2.easting, (sinHeading * (-toolWidth - toolOffset)) + g.currentABLineP2.northing, 0));
 
                 toolWidth *= 2;
-                vertices.append(QVector3D((cosHeading * toolWidth) + currentABLineP1.easting, (sinHeading * toolWidth) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * toolWidth) + currentABLineP2.easting, (sinHeading * toolWidth) + currentABLineP2.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth)) + currentABLineP1.easting, (sinHeading * (-toolWidth)) + currentABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading * (-toolWidth)) + currentABLineP2.easting, (sinHeading * (-toolWidth)) + currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * toolWidth) + g.currentABLineP1.easting, (sinHeading * toolWidth) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * toolWidth) + g.currentABLineP2.easting, (sinHeading * toolWidth) + g.currentABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth)) + g.currentABLineP1.easting, (sinHeading * (-toolWidth)) + g.currentABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading * (-toolWidth)) + g.currentABLineP2.easting, (sinHeading * (-toolWidth)) + g.currentABLineP2.northing, 0));
             }
 
-            //reuse abBuffer
-            if (abBuffer.isCreated())
-                abBuffer.destroy();
-            abBuffer.create();
-            abBuffer.bind();
-            abBuffer.allocate(vertices.data(), vertices.length() * sizeof(QVector3D));
-            abBuffer.release();
-
             color = QColor::fromRgbF(0.56f, 0.65f, 0.65f, 1.0f);
-            glDrawArraysColor(gl,mvp,
-                              GL_LINES, color, abBuffer,
-                              GL_FLOAT, vertices.length(), 1.0f);
+            vertices.draw(gl, mvp, color, GL_LINES, 1.0f);
         }
     }
-    if(isEditing) {
+    if(g.isABEditing) {
         double toolWidth2 = tool_toolWidth - tool_toolOverlap;
-        double cosHeading2 = cos(-abHeading);
-        double sinHeading2 = sin(-abHeading);
+        double cosHeading2 = cos(-g.abHeading);
+        double sinHeading2 = sin(-g.abHeading);
 
         if (camera.camSetDistance > -200)
         {
-            QVector<QVector3D> vertices;
+            GLHelperOneColor vertices;
 
             for (int i = 1; i <= 6; i++)
             {
-                vertices.append(QVector3D((cosHeading2 * toolWidth2) + refABLineP1.easting, (sinHeading2 * toolWidth2) + refABLineP1.northing, 0));
-                vertices.append(QVector3D((cosHeading2 * toolWidth2) + refABLineP2.easting, (sinHeading2 * toolWidth2) + refABLineP2.northing, 0));
+                vertices.append(QVector3D((cosHeading2 * toolWidth2) + g.refABLineP1.easting, (sinHeading2 * toolWidth2) + g.refABLineP1.northing, 0));
+                vertices.append(QVector3D((cosHeading2 * toolWidth2) + g.refABLineP2.easting, (sinHeading2 * toolWidth2) + g.refABLineP2.northing, 0));
                 toolWidth2 = toolWidth2 + tool_toolWidth - tool_toolOverlap;
             }
 
-            //reuse abBuffer
-            if (abBuffer.isCreated())
-                abBuffer.destroy();
-            abBuffer.create();
-            abBuffer.bind();
-            abBuffer.allocate(vertices.data(), vertices.length() * sizeof(QVector3D));
-            abBuffer.release();
-
             color = QColor::fromRgbF(0.9630f, 0.2f, 0.2f, 1.0f);
             //TODO: dotted line with shader
             //GL.Enable(EnableCap.LineStipple);
             gl->glLineWidth(SETTINGS_DISPLAY_LINEWIDTH);
-            glDrawArraysColor(gl,mvp,
-                              GL_LINES, color, abBuffer,
-                              GL_FLOAT, vertices.length(),
-                              SETTINGS_DISPLAY_LINEWIDTH);
+            vertices.draw(gl, mvp, color, GL_LINES, SETTINGS_DISPLAY_LINEWIDTH);
         }
 
     }
 
     if (SETTINGS_DISPLAY_ISPUREON && !SETTINGS_VEHICLE_ISSTANLEYUSED) {
         //Draw lookahead Point
-        abline[0] = QVector3D( goalPointAB.easting, goalPointAB.northing, 0.0 );
-
-        //reuse abBuffer
-        if (abBuffer.isCreated())
-            abBuffer.destroy();
-        abBuffer.create();
-        abBuffer.bind();
-        abBuffer.allocate(abline, 1 * sizeof(QVector3D));
-        abBuffer.release();
+        gldraw.clear();
+        gldraw.append(QVector3D( g.goalPointAB.easting, g.goalPointAB.northing, 0.0 ));
 
         color = QColor::fromRgbF(1.0f, 1.0f, 0.0f, 1.0f);
 
-        glDrawArraysColor(gl, mvp,
-                          GL_POINTS, color, abBuffer,
-                          GL_FLOAT, 2, 1.0f);
+        gldraw.draw(gl, mvp, color, GL_POINTS, 1.0f);
     }
 
-    yt.drawYouTurn(gl, mvp);
+    yt.drawYouTurn(g, gl, mvp);
 
-    if (yt.isRecordingCustomYouTurn) {
+    if (g.isRecordingCustomYouTurn) {
 
-        int ptCount = yt.youFileList.length();
+        int ptCount = g.youFileList.length();
         if (ptCount > 1)
         {
-            QVector<QVector3D> points;
+            GLHelperOneColor points;
             for (int i = 1; i < ptCount; i++)
             {
-                points.append(QVector3D(yt.youFileList[i].easting + yt.youFileList[0].easting, yt.youFileList[i].northing + yt.youFileList[0].northing, 0));
+                points.append(QVector3D(g.youFileList[i].easting + g.youFileList[0].easting, g.youFileList[i].northing + g.youFileList[0].northing, 0));
             }
 
-            //reuse abBuffer
-            if (abBuffer.isCreated())
-                abBuffer.destroy();
-            abBuffer.create();
-            abBuffer.bind();
-            abBuffer.allocate(points.data(), points.length() * sizeof(QVector3D));
-            abBuffer.release();
-
             color = QColor::fromRgbF(0.05f, 0.05f, 0.95f, 1.0f);
 
-            glDrawArraysColor(gl, mvp,
-                              GL_POINTS, color, abBuffer,
-                              GL_FLOAT, points.length(), 2.0f);
+            points.draw(gl, mvp, color, GL_POINTS, 2.0f);
         }
     }
 
@@ -628,8 +564,7 @@ void CABLine::drawABLines(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
 
 void CABLine::drawTram(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
 {
-    QVector<QVector3D> vertices;
-    QOpenGLBuffer tramBuffer;
+    GLHelperOneColor vertices;
     QColor color;
     USE_SETTINGS;
 
@@ -639,18 +574,8 @@ void CABLine::drawTram(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
         for (int h = 0; h < tramList[i].size(); h++)
             vertices.append(QVector3D(tramList[i][h].easting, tramList[i][h].northing, 0));
 
-        if (tramBuffer.isCreated())
-            tramBuffer.destroy();
-        tramBuffer.create();
-        tramBuffer.bind();
-        tramBuffer.allocate(vertices.data(), vertices.length() * sizeof(QVector3D));
-        tramBuffer.release();
-
         color = QColor::fromRgbF(0.8630f, 0.93692f, 0.3260f, 0.22f);
-        glDrawArraysColor(gl, mvp,
-                          GL_TRIANGLE_STRIP, color,
-                          tramBuffer,
-                          GL_FLOAT, vertices.length(), 1.0f);
+        vertices.draw(gl, mvp, color, GL_TRIANGLE_STRIP, 1.0f);
     }
 
     //draw tram numbers at end and beggining of line
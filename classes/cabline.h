@@ -16,6 +16,7 @@ class CTool;
 class CNMEA;
 class CTram;
 class CCamera;
+struct CGuidanceState;
 
 class CABLines
 {
@@ -95,7 +96,8 @@ public:
     void setABLineByHeading(double heading); //do we need to pass in heading somewhere from the main form?
     void snapABLine();
     void getCurrentABLine(Vec3 pivot, Vec3 steer, CVehicle &vehicle, CYouTurn &yt, CNMEA &pn);
-    void drawABLines(QOpenGLFunctions *g, const QMatrix4x4 &mvp, CYouTurn &yt, CTram &tram, const CCamera &camera);
+    //draws the lines as they were at the last fix
+    void drawABLines(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp, const CYouTurn &yt, CTram &tram, const CCamera &camera);
     void drawTram(QOpenGLFunctions *g, const QMatrix4x4 &mvp);
     void buildTram();
     void moveABLine(double dist);
@@ -12,6 +12,7 @@ CBoundaryLines::CBoundaryLines()
     isSet = false;
     isDriveAround = false;
     isDriveThru = false;
+    generation = nextGeometryGeneration();
 }
 
 void CBoundaryLines::calculateBoundaryHeadings()
@@ -42,6 +43,8 @@ void CBoundaryLines::calculateBoundaryHeadings()
     pt3.heading = atan2(arr[0].easting - arr[cnt - 1].easting, arr[0].northing - arr[cnt - 1].northing);
     if (pt3.heading < 0) pt3.heading += glm::twoPI;
     bndLine.append(pt3);
+
+    generation = nextGeometryGeneration();
 }
 
 void CBoundaryLines::fixBoundaryLine(int bndNum, double spacing)
@@ -144,6 +147,8 @@ void CBoundaryLines::reverseWinding()
         if (arr[i].heading < 0) arr[i].heading += glm::twoPI;
         bndLine.append(arr[i]);
     }
+
+    generation = nextGeometryGeneration();
 }
 
 void CBoundaryLines::preCalcBoundaryLines()
@@ -172,42 +177,20 @@ void CBoundaryLines::preCalcBoundaryLines()
             calcList.append(constantMultiple);
         }
     }
+
+    calcIndex.build(bndLine, calcList);
+
+    generation = nextGeometryGeneration();
 }
 
 bool CBoundaryLines::isPointInsideBoundary(Vec3 testPointv3) const
 {
-    if (calcList.size() < 3) return false;
-    int j = bndLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < bndLine.size(); j = i++)
-    {
-        if ((bndLine[i].northing < testPointv3.northing && bndLine[j].northing >= testPointv3.northing)
-        || (bndLine[j].northing < testPointv3.northing && bndLine[i].northing >= testPointv3.northing))
-        {
-            oddNodes ^= ((testPointv3.northing * calcList[i].northing) + calcList[i].easting < testPointv3.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv3); //true means inside.
 }
 
 bool CBoundaryLines::isPointInsideBoundary(Vec2 testPointv2) const
 {
-    if (calcList.size() < 3) return false;
-    int j = bndLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < bndLine.size(); j = i++)
-    {
-        if ((bndLine[i].northing < testPointv2.northing && bndLine[j].northing >= testPointv2.northing)
-        || (bndLine[j].northing < testPointv2.northing && bndLine[i].northing >= testPointv2.northing))
-        {
-            oddNodes ^= ((testPointv2.northing * calcList[i].northing) + calcList[i].easting < testPointv2.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv2); //true means inside.
 }
 
 void CBoundaryLines::drawBoundaryLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, QColor color)
@@ -217,15 +200,19 @@ void CBoundaryLines::drawBoundaryLine(QOpenGLFunctions *gl, const QMatrix4x4 &mv
 
 
     gl->glLineWidth(2);
-    int ptCount = bndLine.size();
 
-    GLHelperOneColor gldraw;
+    if (!isGeometryCurrent(this, generation))
+    {
+        int ptCount = bndLine.size();
+        QVector<QVector3D> vertices;
 
-    for (int h = 0; h < ptCount; h++)
-        gldraw.append(QVector3D(bndLine[h].easting, bndLine[h].northing, 0));
+        for (int h = 0; h < ptCount; h++)
+            vertices.append(QVector3D(bndLine[h].easting, bndLine[h].northing, 0));
+
+        uploadGeometry(this, generation, vertices);
+    }
 
-    gldraw.draw(gl,mvp,color,
-                GL_LINES, 2.0);
+    drawGeometry(gl, mvp, this, color, GL_LINES, 2.0);
 }
 
 void CBoundaryLines::calculateBoundaryArea()
@@ -2,6 +2,7 @@
 #define CBOUNDARYLINES_H
 #include "vec3.h"
 #include "vec2.h"
+#include "cpolygonindex.h"
 #include <QVector>
 
 class QOpenGLFunctions;
@@ -14,6 +15,11 @@ public:
     QVector<Vec3> bndLine;
     //the list of constants and multiples of the boundary
     QVector<Vec2> calcList;
+    //slabs over the same edges for the inside tests
+    CPolygonIndex calcIndex;
+    //new every time the points are rebuilt, so the GPU copy of the
+    //line is only uploaded again after an edit or load
+    int generation;
 
     double area;
     bool isSet, isDriveAround, isDriveThru;
@@ -3,6 +3,7 @@
 #include "cvec.h"
 #include <math.h>
 #include <limits>
+#include <algorithm>
 #include <QOpenGLFunctions>
 #include "glm.h"
 #include "cvehicle.h"
@@ -11,6 +12,7 @@
 #include "cboundary.h"
 #include "aogsettings.h"
 #include "cnmea.h"
+#include "cguidancesnapshot.h"
 #include "common.h"
 
 CContour::CContour(QObject *parent)
@@ -25,7 +27,8 @@ void CContour::startContourLine(Vec3 pivot) {
     isContourOn = true;
     if (!ptList.isNull() && ptList->size() == 1)
     {
-        //reuse ptList
+        //reuse ptList, it's always the last strip
+        stripIndex.removeStrip(stripList.size() - 1, *ptList);
         ptList->clear();
     }
     else
@@ -35,11 +38,13 @@ void CContour::startContourLine(Vec3 pivot) {
         stripList.append(ptList);
     }
 
+    stripIndex.addPoint(stripList.size() - 1, ptList->size(), pivot);
     ptList->append(pivot);
 }
 
 //Add current position to stripList
 void CContour::addPoint(Vec3 pivot) {
+    stripIndex.addPoint(stripList.size() - 1, ptList->size(), pivot);
     ptList->append(pivot);
 }
 
@@ -50,6 +55,7 @@ void CContour::stopContourLine(Vec3 pivot, QVector<QSharedPointer<QVector<Vec3>>
     //make sure its long enough to bother
     if (ptList->size() > 10)
     {
+        stripIndex.addPoint(stripList.size() - 1, ptList->size(), pivot);
         ptList->append(pivot);
 
         //add the point list to the save list for appending to contour file
@@ -59,6 +65,7 @@ void CContour::stopContourLine(Vec3 pivot, QVector<QSharedPointer<QVector<Vec3>>
     //delete ptList
     else
     {
+        stripIndex.removeStrip(stripList.size() - 1, *ptList);
         ptList->clear();
         stripList.pop_back(); //remove the last list in the list
     }
@@ -122,6 +129,7 @@ void CContour::buildBoundaryContours(CBoundary &bnd, int pass, int spacingInt)
         if (point.heading < -glm::twoPI) point.heading += glm::twoPI;
         ptList->append(point);
     }
+    stripIndex.addStrip(stripList.size() - 1, *ptList);
 
     //totalHeadWidth = (tool_toolWidth - tool_toolOverlap) * 0.5 + 0.2 + (tool_toolWidth - tool_toolOverlap);
 
@@ -146,6 +154,7 @@ void CContour::buildBoundaryContours(CBoundary &bnd, int pass, int spacingInt)
             //only add if inside actual field boundary
             ptList->append(point);
         }
+        stripIndex.addStrip(stripList.size() - 1, *ptList);
 
         //add the point list to the save list for appending to contour file
         //mf.contourSaveList.append(ptList);
@@ -162,11 +171,11 @@ void CContour::buildBoundaryContours(CBoundary &bnd, int pass, int spacingInt)
 //determine closest point on applied
 void CContour::buildContourGuidanceLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
     double toolWid = tool_toolWidth;
 
@@ -247,150 +256,18 @@ void CContour::buildContourGuidanceLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot
     int stripCount = stripList.size();
     if (stripCount == 0) return;
 
-    CVec pointC;
     if (isRightPriority)
     {
-        //determine if points are in right side frustum box
-        for (int s = 0; s < stripCount; s++)
-        {
-            ptCount = stripList[s]->size();
-            for (int p = 0; p < ptCount; p++)
-            {
-                //FHCBF
-                if ((((boxH.easting - boxC.easting) * ((*stripList[s])[p].northing - boxC.northing))
-                        - ((boxH.northing - boxC.northing) * ((*stripList[s])[p].easting - boxC.easting))) < 0) { continue; }
-
-                if ((((boxC.easting - boxB.easting) * ((*stripList[s])[p].northing - boxB.northing))
-                        - ((boxC.northing - boxB.northing) * ((*stripList[s])[p].easting - boxB.easting))) < 0) { continue; }
-
-                if ((((boxB.easting - boxF.easting) * ((*stripList[s])[p].northing - boxF.northing))
-                        - ((boxB.northing - boxF.northing) * ((*stripList[s])[p].easting - boxF.easting))) < 0) { continue; }
-
-                if ((((boxF.easting - boxH.easting) * ((*stripList[s])[p].northing - boxH.northing))
-                        - ((boxF.northing - boxH.northing) * ((*stripList[s])[p].easting - boxH.easting))) < 0) { continue; }
-
-                //in the box so is it parallelish or perpedicularish to current heading
-                ref2 = M_PI - fabs(fabs(vehicle.fixHeading - (*stripList[s])[p].heading) - M_PI);
-                if (ref2 < 1.2 || ref2 > 1.9)
-                {
-                    //it's in the box and parallelish so add to list
-                    pointC.x = (*stripList[s])[p].easting;
-                    pointC.z = (*stripList[s])[p].northing;
-                    pointC.h = (*stripList[s])[p].heading;
-                    pointC.strip = s;
-                    pointC.pt = p;
-                    conList.append(pointC);
-                }
-            }
-        }
-
-        if (conList.size() == 0)
-        {
-            //determine if points are in frustum box
-            for (int s = 0; s < stripCount; s++)
-            {
-                ptCount = stripList[s]->size();
-                for (int p = 0; p < ptCount; p++)
-                {
-                    //EADGE
-                    if ((((boxG.easting - boxE.easting) * ((*stripList[s])[p].northing - boxE.northing))
-                            - ((boxG.northing - boxE.northing) * ((*stripList[s])[p].easting - boxE.easting))) < 0) { continue; }
+        //determine if points are in right side frustum box, FHCBF
+        addPointsInBox(boxH, boxC, boxB, boxF, vehicle.fixHeading);
 
-                    if ((((boxE.easting - boxA.easting) * ((*stripList[s])[p].northing - boxA.northing))
-                            - ((boxE.northing - boxA.northing) * ((*stripList[s])[p].easting - boxA.easting))) < 0) { continue; }
-
-                    if ((((boxA.easting - boxD.easting) * ((*stripList[s])[p].northing - boxD.northing))
-                            - ((boxA.northing - boxD.northing) * ((*stripList[s])[p].easting - boxD.easting))) < 0) { continue; }
-
-                    if ((((boxD.easting - boxG.easting) * ((*stripList[s])[p].northing - boxG.northing))
-                            - ((boxD.northing - boxG.northing) * ((*stripList[s])[p].easting - boxG.easting))) < 0) { continue; }
-
-                    //in the box so is it parallelish or perpedicularish to current heading
-                    ref2 = M_PI - fabs(fabs(vehicle.fixHeading - (*stripList[s])[p].heading) - M_PI);
-                    if (ref2 < 1.2 || ref2 > 1.9)
-                    {
-                        //it's in the box and parallelish so add to list
-                        pointC.x = (*stripList[s])[p].easting;
-                        pointC.z = (*stripList[s])[p].northing;
-                        pointC.h = (*stripList[s])[p].heading;
-                        pointC.strip = s;
-                        pointC.pt = p;
-                        conList.append(pointC);
-                    }
-                }
-            }
-        }
+        //then the left, EADGE
+        if (conList.size() == 0) addPointsInBox(boxG, boxE, boxA, boxD, vehicle.fixHeading);
     }
     else
     {
-        for (int s = 0; s < stripCount; s++)
-        {
-            ptCount = stripList[s]->size();
-            for (int p = 0; p < ptCount; p++)
-            {
-                //EADGE
-                if ((((boxG.easting - boxE.easting) * ((*stripList[s])[p].northing - boxE.northing))
-                        - ((boxG.northing - boxE.northing) * ((*stripList[s])[p].easting - boxE.easting))) < 0) { continue; }
-
-                if ((((boxE.easting - boxA.easting) * ((*stripList[s])[p].northing - boxA.northing))
-                        - ((boxE.northing - boxA.northing) * ((*stripList[s])[p].easting - boxA.easting))) < 0) { continue; }
-
-                if ((((boxA.easting - boxD.easting) * ((*stripList[s])[p].northing - boxD.northing))
-                        - ((boxA.northing - boxD.northing) * ((*stripList[s])[p].easting - boxD.easting))) < 0) { continue; }
-
-                if ((((boxD.easting - boxG.easting) * ((*stripList[s])[p].northing - boxG.northing))
-                        - ((boxD.northing - boxG.northing) * ((*stripList[s])[p].easting - boxG.easting))) < 0) { continue; }
-
-                //in the box so is it parallelish or perpedicularish to current heading
-                ref2 = M_PI - fabs(fabs(vehicle.fixHeading - (*stripList[s])[p].heading) - M_PI);
-                if (ref2 < 1.2 || ref2 > 1.9)
-                {
-                    //it's in the box and parallelish so add to list
-                    pointC.x = (*stripList[s])[p].easting;
-                    pointC.z = (*stripList[s])[p].northing;
-                    pointC.h = (*stripList[s])[p].heading;
-                    pointC.strip = s;
-                    pointC.pt = p;
-                    conList.append(pointC);
-                }
-            }
-        }
-
-        if (conList.size() == 0)
-        {
-            //determine if points are in frustum box
-            for (int s = 0; s < stripCount; s++)
-            {
-                ptCount = stripList[s]->size();
-                for (int p = 0; p < ptCount; p++)
-                {
-                    if ((((boxH.easting - boxC.easting) * ((*stripList[s])[p].northing - boxC.northing))
-                            - ((boxH.northing - boxC.northing) * ((*stripList[s])[p].easting - boxC.easting))) < 0) { continue; }
-
-                    if ((((boxC.easting - boxB.easting) * ((*stripList[s])[p].northing - boxB.northing))
-                            - ((boxC.northing - boxB.northing) * ((*stripList[s])[p].easting - boxB.easting))) < 0) { continue; }
-
-                    if ((((boxB.easting - boxF.easting) * ((*stripList[s])[p].northing - boxF.northing))
-                            - ((boxB.northing - boxF.northing) * ((*stripList[s])[p].easting - boxF.easting))) < 0) { continue; }
-
-                    if ((((boxF.easting - boxH.easting) * ((*stripList[s])[p].northing - boxH.northing))
-                            - ((boxF.northing - boxH.northing) * ((*stripList[s])[p].easting - boxH.easting))) < 0) { continue; }
-
-                    //in the box so is it parallelish or perpedicularish to current heading
-                    ref2 = M_PI - fabs(fabs(vehicle.fixHeading - (*stripList[s])[p].heading) - M_PI);
-                    if (ref2 < 1.2 || ref2 > 1.9)
-                    {
-                        //it's in the box and parallelish so add to list
-                        pointC.x = (*stripList[s])[p].easting;
-                        pointC.z = (*stripList[s])[p].northing;
-                        pointC.h = (*stripList[s])[p].heading;
-                        pointC.strip = s;
-                        pointC.pt = p;
-                        conList.append(pointC);
-                    }
-                }
-            }
-        }
+        addPointsInBox(boxG, boxE, boxA, boxD, vehicle.fixHeading);
+        if (conList.size() == 0) addPointsInBox(boxH, boxC, boxB, boxF, vehicle.fixHeading);
     }
 
     //no points in the box, exit
@@ -525,14 +402,64 @@ void CContour::buildContourGuidanceLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot
     }
 }
 
+//Add the parallelish strip points inside the box b1 b2 b3 b4 to conList.
+//Only the index cells under the box are looked at.
+void CContour::addPointsInBox(const Vec2 &b1, const Vec2 &b2, const Vec2 &b3,
+                              const Vec2 &b4, double fixHeading)
+{
+    double minE = qMin(qMin(b1.easting, b2.easting), qMin(b3.easting, b4.easting));
+    double maxE = qMax(qMax(b1.easting, b2.easting), qMax(b3.easting, b4.easting));
+    double minN = qMin(qMin(b1.northing, b2.northing), qMin(b3.northing, b4.northing));
+    double maxN = qMax(qMax(b1.northing, b2.northing), qMax(b3.northing, b4.northing));
+
+    nearRefs.clear();
+    stripIndex.pointsInRect(minE, minN, maxE, maxN, nearRefs);
+
+    //same order as walking every strip, so ties pick the same point
+    std::sort(nearRefs.begin(), nearRefs.end(),
+              [](const CContourIndex::Ref &a, const CContourIndex::Ref &b)
+              { return a.strip < b.strip || (a.strip == b.strip && a.pt < b.pt); });
+
+    CVec pointC;
+    for (int i = 0; i < nearRefs.size(); i++)
+    {
+        const Vec3 &point = (*stripList[nearRefs[i].strip])[nearRefs[i].pt];
+
+        if ((((b1.easting - b2.easting) * (point.northing - b2.northing))
+                - ((b1.northing - b2.northing) * (point.easting - b2.easting))) < 0) { continue; }
+
+        if ((((b2.easting - b3.easting) * (point.northing - b3.northing))
+                - ((b2.northing - b3.northing) * (point.easting - b3.easting))) < 0) { continue; }
+
+        if ((((b3.easting - b4.easting) * (point.northing - b4.northing))
+                - ((b3.northing - b4.northing) * (point.easting - b4.easting))) < 0) { continue; }
+
+        if ((((b4.easting - b1.easting) * (point.northing - b1.northing))
+                - ((b4.northing - b1.northing) * (point.easting - b1.easting))) < 0) { continue; }
+
+        //in the box so is it parallelish or perpedicularish to current heading
+        ref2 = M_PI - fabs(fabs(fixHeading - point.heading) - M_PI);
+        if (ref2 < 1.2 || ref2 > 1.9)
+        {
+            //it's in the box and parallelish so add to list
+            pointC.x = point.easting;
+            pointC.z = point.northing;
+            pointC.h = point.heading;
+            pointC.strip = nearRefs[i].strip;
+            pointC.pt = nearRefs[i].pt;
+            conList.append(pointC);
+        }
+    }
+}
+
 //determine distance from contour guidance line
 void CContour::distanceFromContourLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot, Vec3 steer)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double wheelbase = SETTINGS_VEHICLE_WHEELBASE;
-    double maxSteerAngle = SETTINGS_VEHICLE_MAXSTEERANGLE;
-    double maxAngularVelocity = SETTINGS_VEHICLE_MAXANGULARVELOCITY;
+    double wheelbase = snapshot->vehicleWheelbase;
+    double maxSteerAngle = snapshot->vehicleMaxSteerAngle;
+    double maxAngularVelocity = snapshot->vehicleMaxAngularVelocity;
 
     isValid = false;
     double minDistA = 1000000, minDistB = 1000000;
@@ -540,7 +467,7 @@ void CContour::distanceFromContourLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot,
     //distanceFromCurrentLine = 9999;
     if (ptCount > 8)
     {
-        if (SETTINGS_VEHICLE_ISSTANLEYUSED)
+        if (snapshot->vehicleIsStanleyUsed)
         {
             //find the closest 2 points to current fix
             for (int t = 0; t < ptCount; t++)
@@ -643,11 +570,11 @@ void CContour::distanceFromContourLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot,
             if (abFixHeadingDelta > glm::PIBy2) abFixHeadingDelta -= M_PI;
             else if (abFixHeadingDelta < -glm::PIBy2) abFixHeadingDelta += M_PI;
 
-            abFixHeadingDelta *= SETTINGS_VEHICLE_STANLEYHEADINGERRORGAIN;
+            abFixHeadingDelta *= snapshot->vehicleStanleyHeadingErrorGain;
             if (abFixHeadingDelta > 0.74) abFixHeadingDelta = 0.74;
             if (abFixHeadingDelta < -0.74) abFixHeadingDelta = -0.74;
 
-            steerAngleCT = atan((distanceFromCurrentLine * SETTINGS_VEHICLE_STANLEYGAIN) / ((fabs(pn.speed) * 0.277777) + 1));
+            steerAngleCT = atan((distanceFromCurrentLine * snapshot->vehicleStanleyGain) / ((fabs(pn.speed) * 0.277777) + 1));
 
             if (steerAngleCT > 0.74) steerAngleCT = 0.74;
             if (steerAngleCT < -0.74) steerAngleCT = -0.74;
@@ -913,11 +840,11 @@ void CContour::calculateContourHeadings()
 }
 
 //draw the red follow me line
-void CContour::drawContourLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
+void CContour::drawContourLine(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp) const
 {
     USE_SETTINGS;
     ////draw the guidance line
-    int ptCount = ctList.size();
+    int ptCount = g.ctList.size();
     if (ptCount < 2) return;
 
 
@@ -926,7 +853,7 @@ void CContour::drawContourLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
     GLHelperOneColor gldraw;
 
     for (int h = 0; h < ptCount; h++)
-        gldraw.append(QVector3D(ctList[h].easting, ctList[h].northing, 0));
+        gldraw.append(QVector3D(g.ctList[h].easting, g.ctList[h].northing, 0));
 
     gldraw.draw(gl,mvp, QColor::fromRgbF(0.98f, 0.2f, 0.980f),
                 GL_LINE_STRIP, SETTINGS_DISPLAY_LINEWIDTH);
@@ -934,15 +861,15 @@ void CContour::drawContourLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
     gldraw.clear();
 
     for (int h = 0; h < ptCount; h++)
-        gldraw.append(QVector3D(ctList[h].easting, ctList[h].northing, 0));
+        gldraw.append(QVector3D(g.ctList[h].easting, g.ctList[h].northing, 0));
 
     gldraw.draw(gl,mvp,QColor::fromRgbF(0.87f, 08.7f, 0.25f),
                 GL_POINTS, SETTINGS_DISPLAY_LINEWIDTH);
 
-    if (SETTINGS_DISPLAY_ISPUREON && distanceFromCurrentLine != 32000 && !SETTINGS_VEHICLE_ISSTANLEYUSED)
+    if (SETTINGS_DISPLAY_ISPUREON && g.ctDistanceFromCurrentLine != 32000 && !SETTINGS_VEHICLE_ISSTANLEYUSED)
     {
         gldraw.clear();
-        gldraw.append(QVector3D(goalPointCT.easting, goalPointCT.northing, 0.0));
+        gldraw.append(QVector3D(g.goalPointCT.easting, g.goalPointCT.northing, 0.0));
         gldraw.draw(gl, mvp, QColor::fromRgbF(1.0f, 0.95f, 0.095f),
                     GL_POINTS, 6.0f);
     }
@@ -952,8 +879,16 @@ void CContour::drawContourLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
 void CContour::resetContour()
 {
     stripList.clear();
+    stripIndex.clear();
 
     if (!ptList.isNull()) ptList->clear();
     ctList.clear();
     ctListBufferCurrent = false;
 }
+
+void CContour::rebuildIndex()
+{
+    stripIndex.clear();
+    for (int s = 0; s < stripList.size(); s++)
+        stripIndex.addStrip(s, *stripList[s]);
+}
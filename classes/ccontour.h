@@ -6,9 +6,11 @@
 #include "vec2.h"
 #include "vec4.h"
 #include "cvec.h"
+#include "ccontourindex.h"
 
 class QOpenGLFunctions;
 class QMatrix4x4;
+struct CGuidanceState;
 class CVehicle;
 class CBoundary;
 class CTool;
@@ -21,6 +23,13 @@ private:
     bool ctListBufferCurrent = false;
     int A = 0, B = 0, C = 0;
 
+    //every point of stripList, by location
+    CContourIndex stripIndex;
+    QVector<CContourIndex::Ref> nearRefs;
+
+    void addPointsInBox(const Vec2 &b1, const Vec2 &b2, const Vec2 &b3,
+                        const Vec2 &b4, double fixHeading);
+
 public:
     bool isContourOn=false, isContourBtnOn=false, isRightPriority = true;
 
@@ -86,8 +95,12 @@ public:
     void buildContourGuidanceLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot);
     void calculateContourHeadings();
     void distanceFromContourLine(CVehicle &vehicle, CNMEA &pn, Vec3 pivot, Vec3 steer);
-    void drawContourLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp);
+    //draws the line as it was at the last fix
+    void drawContourLine(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp) const;
     void resetContour();
+
+    //after stripList is filled in some other way, like loading a field
+    void rebuildIndex();
 signals:
     //void guidanceLineDistanceOff(int);
     //void distanceDisplay(int);
@@ -0,0 +1,53 @@
+#include "ccontourindex.h"
+#include <math.h>
+
+void CContourIndex::clear()
+{
+    cells.clear();
+}
+
+void CContourIndex::addPoint(int strip, int pt, const Vec3 &point)
+{
+    Ref ref = { strip, pt };
+    cells[key(cellOf(point.easting), cellOf(point.northing))].append(ref);
+}
+
+void CContourIndex::addStrip(int strip, const QVector<Vec3> &points)
+{
+    for (int p = 0; p < points.size(); p++)
+        addPoint(strip, p, points[p]);
+}
+
+void CContourIndex::removeStrip(int strip, const QVector<Vec3> &points)
+{
+    for (int p = 0; p < points.size(); p++)
+    {
+        QHash<quint64, QVector<Ref>>::iterator cell =
+                cells.find(key(cellOf(points[p].easting), cellOf(points[p].northing)));
+        if (cell == cells.end()) continue;
+
+        QVector<Ref> &refs = cell.value();
+        for (int i = refs.size() - 1; i >= 0; i--)
+        {
+            if (refs[i].strip == strip) refs.remove(i);
+        }
+        if (refs.isEmpty()) cells.erase(cell);
+    }
+}
+
+void CContourIndex::pointsInRect(double minEasting, double minNorthing,
+                                 double maxEasting, double maxNorthing,
+                                 QVector<Ref> &refs) const
+{
+    int minE = cellOf(minEasting), maxE = cellOf(maxEasting);
+    int minN = cellOf(minNorthing), maxN = cellOf(maxNorthing);
+
+    for (int e = minE; e <= maxE; e++)
+    {
+        for (int n = minN; n <= maxN; n++)
+        {
+            QHash<quint64, QVector<Ref>>::const_iterator cell = cells.constFind(key(e, n));
+            if (cell != cells.constEnd()) refs += cell.value();
+        }
+    }
+}
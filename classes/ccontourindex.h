@@ -0,0 +1,47 @@
+#ifndef CCONTOURINDEX_H
+#define CCONTOURINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include <math.h>
+#include "vec3.h"
+
+//Uniform grid over the points of every contour strip, so finding the
+//points near the vehicle only looks at the few cells under the search
+//box instead of every pass driven in the field. Points are referred
+//to by strip and point index into CContour::stripList.
+class CContourIndex
+{
+public:
+    struct Ref
+    {
+        int strip;
+        int pt;
+    };
+
+    //meters, about a tool width so a search box covers a handful
+    static constexpr double CELLSIZE = 10.0;
+
+    void clear();
+    void addPoint(int strip, int pt, const Vec3 &point);
+    void addStrip(int strip, const QVector<Vec3> &points);
+
+    //only ever the last strip, so nothing else needs renumbering
+    void removeStrip(int strip, const QVector<Vec3> &points);
+
+    //every point in the cells touching the box, unordered
+    void pointsInRect(double minEasting, double minNorthing,
+                      double maxEasting, double maxNorthing,
+                      QVector<Ref> &refs) const;
+
+private:
+    QHash<quint64, QVector<Ref>> cells;
+
+    static inline int cellOf(double coord) { return (int)floor(coord / CELLSIZE); }
+    static inline quint64 key(int cellE, int cellN)
+    {
+        return ((quint64)(quint32)cellE << 32) | (quint32)cellN;
+    }
+};
+
+#endif // CCONTOURINDEX_H
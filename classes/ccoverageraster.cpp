@@ -0,0 +1,90 @@
+#include "ccoverageraster.h"
+#include <math.h>
+
+CCoverageRaster::CCoverageRaster()
+{
+    clear(0.25);
+}
+
+void CCoverageRaster::clear(double resolution)
+{
+    cellSize = resolution;
+    cellArea = resolution * resolution;
+    tiles.clear();
+    coveredCells = 0;
+    appliedCells = 0;
+}
+
+void CCoverageRaster::addTriangle(const QVector3D &a, const QVector3D &b, const QVector3D &c)
+{
+    //in cells, shifted half a cell so the centre of cell (i,j) is at (i,j)
+    double u[3], v[3];
+    u[0] = a.x() / cellSize - 0.5; v[0] = a.y() / cellSize - 0.5;
+    u[1] = b.x() / cellSize - 0.5; v[1] = b.y() / cellSize - 0.5;
+    u[2] = c.x() / cellSize - 0.5; v[2] = c.y() / cellSize - 0.5;
+
+    double minV = qMin(v[0], qMin(v[1], v[2]));
+    double maxV = qMax(v[0], qMax(v[1], v[2]));
+
+    //rows whose centre line is in [minV, maxV)
+    int firstRow = (int)ceil(minV);
+    int endRow = (int)ceil(maxV);
+
+    for (int row = firstRow; row < endRow; row++)
+    {
+        double xs[2];
+        int n = 0;
+
+        for (int e = 0; e < 3 && n < 2; e++)
+        {
+            //lower end first, so a shared edge works out the same x
+            //from both of its triangles
+            int p = e, q = (e + 1) % 3;
+            if (v[q] < v[p] || (v[q] == v[p] && u[q] < u[p])) { p = q; q = e; }
+
+            if (row < v[p] || row >= v[q]) continue;
+            xs[n++] = u[p] + (row - v[p]) * (u[q] - u[p]) / (v[q] - v[p]);
+        }
+        if (n < 2) continue;
+
+        if (xs[0] > xs[1]) qSwap(xs[0], xs[1]);
+
+        //columns whose centre is in [xs[0], xs[1])
+        int firstCol = (int)ceil(xs[0]);
+        int endCol = (int)ceil(xs[1]);
+        if (endCol > firstCol) addSpan(row, firstCol, endCol - 1);
+    }
+}
+
+void CCoverageRaster::addSpan(int row, int firstCol, int lastCol)
+{
+    //floor division, coordinates go negative
+    int tileRow = row >= 0 ? row / TILESIZE : (row + 1) / TILESIZE - 1;
+    int cellRow = row - tileRow * TILESIZE;
+
+    int col = firstCol;
+    while (col <= lastCol)
+    {
+        int tileCol = col >= 0 ? col / TILESIZE : (col + 1) / TILESIZE - 1;
+        int tileEnd = qMin(lastCol, tileCol * TILESIZE + TILESIZE - 1);
+
+        QVector<quint8> &tile = tiles[((qint64)tileRow << 32) | (quint32)tileCol];
+        if (tile.isEmpty()) tile.fill(0, TILESIZE * TILESIZE);
+
+        quint8 *cell = tile.data() + cellRow * TILESIZE + (col - tileCol * TILESIZE);
+        for (; col <= tileEnd; col++, cell++)
+        {
+            //stops counting at 255 passes
+            if (*cell == 255) continue;
+            if (*cell == 0) coveredCells++;
+            (*cell)++;
+            appliedCells++;
+        }
+    }
+}
+
+void CCoverageRaster::addPatch(const TriangleList &patch)
+{
+    for (int j = 1; j < patch.size() - 2; j++)
+        addTriangle(patch[j], patch[j + 1], patch[j + 2]);
+}
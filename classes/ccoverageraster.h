@@ -0,0 +1,60 @@
+#ifndef CCOVERAGERASTER_H
+#define CCOVERAGERASTER_H
+
+#include <QHash>
+#include <QVector>
+#include <QVector3D>
+#include "csection.h"
+
+//How many times each bit of ground has had the tool over it, kept as a
+//count per square cell. Cells live in tiles that are only made once a
+//triangle lands in them, so a field costs memory for the ground worked
+//and nothing for the ground around it.
+//
+//A cell is counted when its centre is inside a triangle. The edges are
+//half open, so two triangles sharing an edge never both count a cell on
+//it: the section strips tile the ground without overlapping themselves
+//and only real overlap shows up.
+class CCoverageRaster
+{
+public:
+    //cells along each side of a tile
+    static const int TILESIZE = 64;
+
+    CCoverageRaster();
+
+    //empty it, with cells resolution meters across
+    void clear(double resolution);
+    inline double resolution() const { return cellSize; }
+
+    //count the cells under one triangle, easting = x, northing = y
+    void addTriangle(const QVector3D &a, const QVector3D &b, const QVector3D &c);
+
+    //every triangle of a section strip, first vertex is the colour
+    void addPatch(const TriangleList &patch);
+
+    //ground under the tool at least once, in m2
+    inline double coveredArea() const { return coveredCells * cellArea; }
+
+    //every pass added up, so ground covered twice counts twice
+    inline double appliedArea() const { return appliedCells * cellArea; }
+
+    //applied more than once
+    inline double overlapArea() const { return (appliedCells - coveredCells) * cellArea; }
+    inline double overlapPercent() const {
+        return appliedCells > 0 ? (appliedCells - coveredCells) * 100.0 / appliedCells : 0;
+    }
+
+private:
+    double cellSize;
+    double cellArea;
+
+    //key is tile row and column, each tile TILESIZE * TILESIZE counts
+    QHash<qint64, QVector<quint8>> tiles;
+    qint64 coveredCells;
+    qint64 appliedCells;
+
+    void addSpan(int row, int firstCol, int lastCol);
+};
+
+#endif // CCOVERAGERASTER_H
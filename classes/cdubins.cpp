@@ -1,6 +1,8 @@
 #include "cdubins.h"
 #include "cgeofence.h"
+#include "cboundary.h"
 #include "glm.h"
+#include <math.h>
 
 static const double driveDistance = 0.1;
 double CDubinsTurningRadius = 1;
@@ -184,7 +186,6 @@ CDubins::CDubins()
 
 QVector<Vec3> CDubins::GenerateDubins(Vec3 _start, Vec3 _goal)
 {
-    QVector<Vec3> dubinsShortestPathList;
     startPos.easting = _start.easting;
     startPos.northing = _start.northing;
     startHeading = _start.heading;
@@ -193,33 +194,20 @@ QVector<Vec3> CDubins::GenerateDubins(Vec3 _start, Vec3 _goal)
     goalPos.northing = _goal.northing;
     goalHeading = _goal.heading;
 
-    //Get all valid Dubins paths
+    //Get all valid Dubins paths, shortest first
     pathDataList = GetAllDubinsPaths();
 
-    //clear out existing path of vec3 points
-    //dubinsShortestPathList.clear();
-
     if (pathDataList.count() > 0)
     {
-        int cnt = pathDataList[0].pathCoordinates.count();
-        if (cnt > 1)
-        {
-            //calculate the heading for each point
-            for (int i = 0; i < cnt - 1; i += 5)
-            {
-                Vec3 pt(pathDataList[0].pathCoordinates[i].easting, pathDataList[0].pathCoordinates[i].northing, 0);
-                pt.heading = qAtan2(pathDataList[0].pathCoordinates[i + 1].easting - pathDataList[0].pathCoordinates[i].easting,
-                                    pathDataList[0].pathCoordinates[i + 1].northing - pathDataList[0].pathCoordinates[i].northing);
-                dubinsShortestPathList.append(pt);
-            }
-        }
+        GetTotalPath(pathDataList[0]);
+        return GetPathHeadings(pathDataList[0]);
     }
-    return dubinsShortestPathList;
+
+    return QVector<Vec3>();
 }
 
 QVector<Vec3> CDubins::GenerateDubins(Vec3 _start, Vec3 _goal, const CBoundary &bnd, CGeoFence &fence)
 {
-    QVector<Vec3> dubinsShortestPathList;
     //positions and heading
     startPos.easting = _start.easting;
     startPos.northing = _start.northing;
@@ -229,52 +217,220 @@ QVector<Vec3> CDubins::GenerateDubins(Vec3 _start, Vec3 _goal, const CBoundary &
     goalPos.northing = _goal.northing;
     goalHeading = _goal.heading;
 
-    //Get all valid Dubins paths
+    //Get all valid Dubins paths, shortest first
     pathDataList = GetAllDubinsPaths();
 
-    //clear out existing path of vec3 points
-    dubinsShortestPathList.clear();
+    //every path starts here, so if this is out none of them can work
+    if (pathDataList.count() == 0 || !fence.isPointInsideGeoFences(bnd, startPos))
+        return QVector<Vec3>();
 
-    int pathsCnt = pathDataList.count();
-    if (pathsCnt > 0)
+    //a path that starts inside and never crosses a fence line stays
+    //inside, so the first clean one is the shortest one that fits
+    for (int i = 0; i < pathDataList.count(); i++)
     {
-        for (int i = 0; i < pathsCnt; i++)
+        if (IsPathInsideGeoFences(pathDataList[i], bnd, fence))
         {
-            int cnt = pathDataList[i].pathCoordinates.count();
-            if (cnt > 1)
-            {
-                for (int j = 0; j < cnt; j++)
-                {
-                    if (!fence.isPointInsideGeoFences(bnd,pathDataList[i].pathCoordinates[j]))
-                    {
-                        pathDataList.removeAt(i);
-                        pathsCnt = pathDataList.count();
-                        i = -1;
-                        break;
-                    }
-                }
-            }
+            GetTotalPath(pathDataList[i]);
+            return GetPathHeadings(pathDataList[i]);
         }
     }
 
-    if (pathDataList.count()> 0)
+    return QVector<Vec3>();
+}
+
+QVector<Vec3> CDubins::GetPathHeadings(const OneDubinsPath &pathData)
+{
+    QVector<Vec3> dubinsShortestPathList;
+
+    int cnt = pathData.pathCoordinates.count();
+    if (cnt > 1)
     {
-        int cnt = pathDataList[0].pathCoordinates.count();
-        if (cnt > 1)
+        //calculate the heading for each point
+        for (int i = 0; i < cnt - 1; i += 5)
         {
-            //calculate the heading for each point
-            for (int i = 0; i < cnt - 1; i += 5)
-            {
-                Vec3 pt(pathDataList[0].pathCoordinates[i].easting, pathDataList[0].pathCoordinates[i].northing, 0);
-                pt.heading = qAtan2(pathDataList[0].pathCoordinates[i + 1].easting - pathDataList[0].pathCoordinates[i].easting,
-                pathDataList[0].pathCoordinates[i + 1].northing - pathDataList[0].pathCoordinates[i].northing);
-                dubinsShortestPathList.append(pt);
-            }
+            Vec3 pt(pathData.pathCoordinates[i].easting, pathData.pathCoordinates[i].northing, 0);
+            pt.heading = qAtan2(pathData.pathCoordinates[i + 1].easting - pathData.pathCoordinates[i].easting,
+                                pathData.pathCoordinates[i + 1].northing - pathData.pathCoordinates[i].northing);
+            dubinsShortestPathList.append(pt);
         }
     }
     return dubinsShortestPathList;
 }
 
+//One piece of a path, either the straight line a to b or an arc on the
+//circle around center. Arc angles are from east counter clockwise like
+//GetArcLength, so a left turn sweeps positive and a right turn negative.
+struct DubinsPiece
+{
+    bool isArc;
+    Vec2 a, b;
+    Vec2 center;
+    double startAngle, sweep;
+    double minE, maxE, minN, maxN;
+};
+
+static DubinsPiece MakeLinePiece(Vec2 a, Vec2 b)
+{
+    DubinsPiece piece;
+    piece.isArc = false;
+    piece.a = a;
+    piece.b = b;
+    piece.minE = qMin(a.easting, b.easting);
+    piece.maxE = qMax(a.easting, b.easting);
+    piece.minN = qMin(a.northing, b.northing);
+    piece.maxN = qMax(a.northing, b.northing);
+    return piece;
+}
+
+static DubinsPiece MakeArcPiece(Vec2 center, Vec2 from, double length, bool isTurningRight)
+{
+    DubinsPiece piece;
+    piece.isArc = true;
+    piece.center = center;
+    piece.startAngle = qAtan2(from.northing - center.northing, from.easting - center.easting);
+    piece.sweep = length / CDubinsTurningRadius;
+    if (isTurningRight) piece.sweep = -piece.sweep;
+
+    //the whole circle is close enough for throwing out far away edges
+    piece.minE = center.easting - CDubinsTurningRadius;
+    piece.maxE = center.easting + CDubinsTurningRadius;
+    piece.minN = center.northing - CDubinsTurningRadius;
+    piece.maxN = center.northing + CDubinsTurningRadius;
+    return piece;
+}
+
+static inline double Cross(Vec2 o, Vec2 a, Vec2 b)
+{
+    return (a.easting - o.easting) * (b.northing - o.northing) - (a.northing - o.northing) * (b.easting - o.easting);
+}
+
+//proper or touching crossing of segments a-b and p-q
+static bool IsLineCrossingEdge(Vec2 a, Vec2 b, Vec2 p, Vec2 q)
+{
+    double d1 = Cross(p, q, a);
+    double d2 = Cross(p, q, b);
+    double d3 = Cross(a, b, p);
+    double d4 = Cross(a, b, q);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+        ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return true;
+
+    //collinear pieces only count if they overlap
+    if (d1 == 0 && d2 == 0)
+    {
+        return qMax(a.easting, b.easting) >= qMin(p.easting, q.easting) &&
+               qMax(p.easting, q.easting) >= qMin(a.easting, b.easting) &&
+               qMax(a.northing, b.northing) >= qMin(p.northing, q.northing) &&
+               qMax(p.northing, q.northing) >= qMin(a.northing, b.northing);
+    }
+
+    return false;
+}
+
+//is the angle of the point on the circle within the swept part of the arc
+static bool IsAngleOnArc(const DubinsPiece &arc, double angle)
+{
+    double offset = angle - arc.startAngle;
+    if (arc.sweep < 0) offset = -offset;
+
+    offset = fmod(offset, glm::twoPI);
+    if (offset < 0) offset += glm::twoPI;
+
+    return offset <= qAbs(arc.sweep) + 1e-9;
+}
+
+//solve |p + t(q-p) - center| = r for t in 0..1 and test those points
+//against the arc
+static bool IsArcCrossingEdge(const DubinsPiece &arc, Vec2 p, Vec2 q)
+{
+    double dE = q.easting - p.easting;
+    double dN = q.northing - p.northing;
+    double fE = p.easting - arc.center.easting;
+    double fN = p.northing - arc.center.northing;
+
+    double a = dE * dE + dN * dN;
+    if (a < 1e-12) return false;
+
+    double b = 2.0 * (fE * dE + fN * dN);
+    double c = fE * fE + fN * fN - CDubinsTurningRadius * CDubinsTurningRadius;
+
+    double disc = b * b - 4.0 * a * c;
+    if (disc < 0) return false;
+
+    disc = sqrt(disc);
+    double t[2] = { (-b - disc) / (2.0 * a), (-b + disc) / (2.0 * a) };
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (t[i] < 0.0 || t[i] > 1.0) continue;
+        double angle = qAtan2(fN + t[i] * dN, fE + t[i] * dE);
+        if (IsAngleOnArc(arc, angle)) return true;
+    }
+
+    return false;
+}
+
+static bool IsPieceCrossingFence(const DubinsPiece &piece, const QVector<Vec2> &fenceLine)
+{
+    int ptCount = fenceLine.size();
+    if (ptCount < 2) return false;
+
+    int j = ptCount - 1;
+    for (int i = 0; i < ptCount; j = i++)
+    {
+        const Vec2 &p = fenceLine[j];
+        const Vec2 &q = fenceLine[i];
+
+        //throw out edges that are nowhere near this piece
+        if (qMax(p.easting, q.easting) < piece.minE || qMin(p.easting, q.easting) > piece.maxE ||
+            qMax(p.northing, q.northing) < piece.minN || qMin(p.northing, q.northing) > piece.maxN)
+            continue;
+
+        if (piece.isArc)
+        {
+            if (IsArcCrossingEdge(piece, p, q)) return true;
+        }
+        else
+        {
+            if (IsLineCrossingEdge(piece.a, piece.b, p, q)) return true;
+        }
+    }
+
+    return false;
+}
+
+//Check the arcs and line of a path against the fence lines exactly
+//instead of sampling it. The start point has to be checked for being
+//inside already.
+bool CDubins::IsPathInsideGeoFences(const OneDubinsPath &pathData, const CBoundary &bnd, const CGeoFence &fence)
+{
+    DubinsPiece pieces[3];
+
+    pieces[0] = MakeArcPiece(pathData.startCircle, startPos, pathData.length1, pathData.segment1TurningRight);
+
+    if (pathData.segment2Turning)
+        pieces[1] = MakeArcPiece(pathData.middleCircle, pathData.tangent1, pathData.length2, pathData.segment2TurningRight);
+    else
+        pieces[1] = MakeLinePiece(pathData.tangent1, pathData.tangent2);
+
+    pieces[2] = MakeArcPiece(pathData.goalCircle, pathData.tangent2, pathData.length3, pathData.segment3TurningRight);
+
+    for (int k = 0; k < 3; k++)
+    {
+        if (fence.geoFenceArr.size() > 0 && IsPieceCrossingFence(pieces[k], fence.geoFenceArr[0].geoFenceLine))
+            return false;
+
+        for (int b = 1; b < bnd.bndArr.size() && b < fence.geoFenceArr.size(); b++)
+        {
+            if (bnd.bndArr[b].isSet && IsPieceCrossingFence(pieces[k], fence.geoFenceArr[b].geoFenceLine))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 QVector<OneDubinsPath> CDubins::GetAllDubinsPaths()
 {
     //Reset the list with all Dubins paths
@@ -292,8 +448,8 @@ QVector<OneDubinsPath> CDubins::GetAllDubinsPaths()
         //Sort the list with paths so the shortest path is first
 //        pathDataList.Sort((x, y) => x.totalLength.CompareTo(y.totalLength));
         std::sort(pathDataList.begin(), pathDataList.end());
-        //Generate the final coordinates of the path from tangent points and segment lengths
-        GeneratePathCoordinates();
+
+        //coordinates are only generated for the path that gets used
     }
 
     //No paths could be found
@@ -389,6 +545,10 @@ void CDubins::Get_RSR_Length()
    //RSR
    pathData.SetIfTurningRight(true, false, true);
 
+   //Centers of the turns for checking against the fences
+   pathData.startCircle = startRightCircle;
+   pathData.goalCircle = goalRightCircle;
+
    //Add the path to the collection of all paths
    pathDataList.append(pathData);
 }
@@ -415,6 +575,10 @@ void CDubins::Get_LSL_Length()
       //LSL
       pathData.SetIfTurningRight(false, false, false);
 
+      //Centers of the turns for checking against the fences
+      pathData.startCircle = startLeftCircle;
+      pathData.goalCircle = goalLeftCircle;
+
       //Add the path to the collection of all paths
       pathDataList.append(pathData);
 }
@@ -441,6 +605,10 @@ void CDubins::Get_RSL_Length()
     //RSL
     pathData.SetIfTurningRight(true, false, false);
 
+    //Centers of the turns for checking against the fences
+    pathData.startCircle = startRightCircle;
+    pathData.goalCircle = goalLeftCircle;
+
     //Add the path to the collection of all paths
     pathDataList.append(pathData);
 }
@@ -467,6 +635,10 @@ void CDubins::Get_LSR_Length()
     //LSR
     pathData.SetIfTurningRight(false, false, true);
 
+    //Centers of the turns for checking against the fences
+    pathData.startCircle = startLeftCircle;
+    pathData.goalCircle = goalRightCircle;
+
     //Add the path to the collection of all paths
     pathDataList.append(pathData);
 }
@@ -499,6 +671,11 @@ void CDubins::Get_RLR_Length()
     //RLR
     pathData.SetIfTurningRight(true, false, true);
 
+    //Centers of the turns for checking against the fences
+    pathData.startCircle = startRightCircle;
+    pathData.middleCircle = middleCircle;
+    pathData.goalCircle = goalRightCircle;
+
     //Add the path to the collection of all paths
     pathDataList.append(pathData);
 }
@@ -531,20 +708,16 @@ void CDubins::Get_LRL_Length()
     //LRL
     pathData.SetIfTurningRight(false, true, false);
 
+    //Centers of the turns for checking against the fences
+    pathData.startCircle = startLeftCircle;
+    pathData.middleCircle = middleCircle;
+    pathData.goalCircle = goalLeftCircle;
+
     //Add the path to the collection of all paths
     pathDataList.append(pathData);
 }
-// Generate the final path from the tangent points
-//When we have found the tangent points and lengths of each path we need to get the individual coordinates
+//When we have picked a path we need the individual coordinates
 //of the entire path so we can travel along the path
-void CDubins::GeneratePathCoordinates()
-{
-    for (int i = 0; i < pathDataList.count(); i++)
-    {
-        GetTotalPath(pathDataList[i]);
-    }
-}
-
 void CDubins::GetTotalPath(OneDubinsPath &pathData)
 {
 //Store the waypoints of the final path here
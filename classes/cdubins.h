@@ -42,6 +42,9 @@ public:
     //The 2 tangent points we need to connect the lines and curves
     Vec2 tangent1, tangent2;
 
+    //Centers of the turns, middleCircle is only used by RLR and LRL
+    Vec2 startCircle, middleCircle, goalCircle;
+
     //The type, such as RSL
     PathType pathType;
 
@@ -79,6 +82,7 @@ private:
     Vec2 startLeftCircle, startRightCircle, goalLeftCircle, goalRightCircle;
     QVector<OneDubinsPath> pathDataList;
     QVector<OneDubinsPath> GetAllDubinsPaths();
+    bool IsPathInsideGeoFences(const OneDubinsPath &pathData, const CBoundary &bnd, const CGeoFence &fence);
     void PositionLeftRightCircles();
     void CalculateDubinsPathsLengths();
     void Get_RSR_Length();
@@ -87,8 +91,8 @@ private:
     void Get_LSR_Length();
     void Get_RLR_Length();
     void Get_LRL_Length();
-    void GeneratePathCoordinates();
     void GetTotalPath(OneDubinsPath &pathData);
+    QVector<Vec3> GetPathHeadings(const OneDubinsPath &pathData);
 
 };
 
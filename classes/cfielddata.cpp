@@ -3,12 +3,39 @@
 #include "cboundary.h"
 #include "cnmea.h"
 #include <QString>
+#include <QTextStream>
 
 CFieldData::CFieldData(QObject *parent) : QObject(parent)
 {
     workedAreaTotal = 0;
     workedAreaTotalUser = 0;
     userSquareMetersAlarm = 0;
+    actualAreaCovered = 0;
+}
+
+void CFieldData::updateOverlap()
+{
+    actualAreaCovered = coverage.coveredArea();
+    overlapPercent = coverage.overlapPercent();
+}
+
+QByteArray CFieldData::coverageReport() const
+{
+    QString report;
+    QTextStream writer(&report);
+
+    writer.setRealNumberNotation(QTextStream::FixedNotation);
+    writer.setRealNumberPrecision(3);
+
+    writer << "$Coverage" << Qt::endl;
+    writer << "Resolution," << coverage.resolution() << Qt::endl;
+    writer << "Applied," << coverage.appliedArea() << Qt::endl;
+    writer << "Covered," << coverage.coveredArea() << Qt::endl;
+    writer << "Overlap," << coverage.overlapArea() << Qt::endl;
+    writer << "OverlapPercent," << coverage.overlapPercent() << Qt::endl;
+    writer.flush();
+
+    return report.toUtf8();
 }
 
 void CFieldData::updateFieldBoundaryGUIAreas(const CBoundary &bnd)
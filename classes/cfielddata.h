@@ -5,6 +5,7 @@
 #include <QString>
 #include <QLocale>
 #include "glm.h"
+#include "ccoverageraster.h"
 
 class CTool;
 class CBoundary;
@@ -39,12 +40,21 @@ public:
     //not really used - but if needed
     double userSquareMetersAlarm;
 
+    //counts every pass over the ground, for the real overlap
+    CCoverageRaster coverage;
+
 
 
     explicit CFieldData(QObject *parent = 0);
 
     void updateFieldBoundaryGUIAreas(const CBoundary &bnd);
 
+    //actualAreaCovered and overlapPercent from the coverage raster
+    void updateOverlap();
+
+    //Coverage.txt, the areas worked out from the coverage raster
+    QByteArray coverageReport() const;
+
     //Area inside Boundary less inside boundary areas
     inline QString getAreaBoundaryLessInnersHectares() {
         QLocale locale;
@@ -152,6 +162,14 @@ public slots:
     void addToUserArea(double addedArea) {
         workedAreaTotalUser += addedArea;
     }
+
+    //the two triangles between the last pair of section points and
+    //the new pair
+    void addToCoverage(QVector3D left0, QVector3D right0, QVector3D left1, QVector3D right1) {
+        coverage.addTriangle(right1, left1, right0);
+        coverage.addTriangle(left1, right0, left0);
+        updateOverlap();
+    }
 };
 
 #endif // CFIELDDATA_H
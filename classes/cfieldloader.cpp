@@ -0,0 +1,502 @@
+#include "cfieldloader.h"
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <QDebug>
+#include <math.h>
+#include "cpatchfile.h"
+#include "glm.h"
+
+static const char *fieldFileNames[CFieldLoader::NUMFILES] = {
+    "Field.txt", "ABLines.txt", "CurveLines.txt", "Sections.txt", "Contour.txt",
+    "Flags.txt", "Boundary.txt", "Headland.txt", "RecPath.txt"
+};
+
+CFieldLoader::CFieldLoader(QObject *parent) : QObject(parent)
+{
+    for (int i = 0; i < NUMFILES; i++)
+    {
+        isRead[i] = false;
+        readTime[i] = 0;
+    }
+}
+
+const char *CFieldLoader::fileName(int file)
+{
+    return fieldFileNames[file];
+}
+
+void CFieldLoader::load(const QString &_directoryName)
+{
+    QElapsedTimer total;
+    total.start();
+
+    directoryName = _directoryName;
+
+    //one listing for every file, rather than a name filter scan each
+    listing.clear();
+    foreach (const QString &name, QDir(directoryName).entryList(QDir::Files))
+        listing.insert(name.toLower(), name);
+
+    filesDone = 0;
+
+    //Sections and Contour are by far the biggest, so they go in first
+    QVector<int> files;
+    files << SectionsTxt << ContourTxt << BoundaryTxt << RecPathTxt << FlagsTxt
+          << HeadlandTxt << CurveLinesTxt << ABLinesTxt << FieldTxt;
+
+    QtConcurrent::blockingMap(files, [&](int file) {
+        QElapsedTimer clock;
+        clock.start();
+
+        isRead[file] = readFile(file);
+        readTime[file] = clock.nsecsElapsed() / 1000000.0;
+
+        emit progress(fileName(file), filesDone.fetchAndAddOrdered(1) + 1, NUMFILES);
+    });
+
+    totalTime = total.nsecsElapsed() / 1000000.0;
+}
+
+QString CFieldLoader::findFile(const QString &name) const
+{
+    return directoryName + "/" + listing.value(name.toLower(), name);
+}
+
+bool CFieldLoader::readFile(int file)
+{
+    if (file == SectionsTxt)
+    {
+        if (!readSections(findFile("Sections.txt"), findFile("Sections.bin"), patches))
+            return false;
+
+        //areas, index boxes and coverage, so the GUI thread only has to
+        //link them in
+        foreach (const QSharedPointer<TriangleList> &triList, patches)
+        {
+            //calculate area of this patch - AbsoluteValue of (Ax(By-Cy) + Bx(Cy-Ay) + Cx(Ay-By)/2)
+            int verts = triList->size() - 2;
+            if (verts >= 2)
+            {
+                for (int j = 1; j < verts; j++)
+                {
+                    double temp = 0;
+                    temp = (*triList)[j].x() * ((*triList)[j + 1].y() - (*triList)[j + 2].y()) +
+                             (*triList)[j + 1].x() * ((*triList)[j + 2].y() - (*triList)[j].y()) +
+                                 (*triList)[j + 2].x() * ((*triList)[j].y() - (*triList)[j + 1].y());
+
+                    workedAreaTotal += fabs((temp * 0.5));
+                }
+            }
+
+            CPatchIndex::Patch item;
+            if (CPatchIndex::makePatch(triList, item)) patchItems.append(item);
+
+            coverage.addPatch(*triList);
+        }
+        return true;
+    }
+
+    if (file == ContourTxt)
+        return readContour(findFile("Contour.txt"), findFile("Contour.bin"), strips);
+
+    QString filename = findFile(fileName(file));
+    QFile textFile(filename);
+    if (!textFile.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Couldn't open " << filename << "for reading!";
+        return false;
+    }
+
+    QTextStream reader(&textFile);
+
+    switch (file)
+    {
+    case FieldTxt: readField(reader); break;
+    case ABLinesTxt: readABLines(reader, lineArr); break;
+    case CurveLinesTxt: readCurveLines(reader, curveArr); break;
+    case FlagsTxt: readFlags(reader); break;
+    case BoundaryTxt: readBoundary(reader); break;
+    case HeadlandTxt: readHeadland(reader); break;
+    case RecPathTxt: readRecPath(reader); break;
+    }
+
+    return true;
+}
+
+void CFieldLoader::readField(QTextStream &reader)
+{
+    //Saturday, February 11, 2017  -->  7:26:52 AM
+    //$FieldDir
+    //Bob_Feb11
+    //$Offsets
+    //533172,5927719,12 - offset easting, northing, zone
+
+    QString line;
+
+    //Date time line
+    line = reader.readLine();
+
+    //dir header $FieldDir
+    line = reader.readLine();
+
+    //read field directory
+    line = reader.readLine();
+
+    fieldDirectory = line.trimmed();
+
+    //Offset header
+    line = reader.readLine();
+
+    //read the Offsets
+    line = reader.readLine();
+    QStringList offs = line.split(',');
+    utmEast = offs[0].toInt();
+    utmNorth = offs[1].toInt();
+    actualEasting = offs[0].toDouble();
+    actualNorthing = offs[1].toDouble();
+    zone = offs[2].toInt();
+
+    //convergence angle update
+    if (!reader.atEnd())
+    {
+        line = reader.readLine(); //Convergence
+        line = reader.readLine();
+        convergenceAngle = line.toDouble();
+        hasConvergence = true;
+    }
+
+    //start positions
+    if (!reader.atEnd())
+    {
+        line = reader.readLine();
+        line = reader.readLine();
+        offs = line.split(',');
+
+        latStart = offs[0].toDouble();
+        lonStart = offs[1].toDouble();
+        hasStart = true;
+    }
+}
+
+void CFieldLoader::readABLines(QTextStream &reader, QVector<CABLines> &lineArr)
+{
+    QString line;
+    lineArr.clear();
+
+    //read all the lines
+    while (!reader.atEnd())
+    {
+        line = reader.readLine();
+        QStringList words = line.split(',');
+
+        if (words.length() != 4) break;
+
+        CABLines item;
+        item.Name = words[0];
+
+        item.heading = glm::toRadians(words[1].toDouble());
+        item.origin.easting = words[2].toDouble();
+        item.origin.northing = words[3].toDouble();
+
+        item.ref1.easting = item.origin.easting - (sin(item.heading) * 1000.0);
+        item.ref1.northing = item.origin.northing - (cos(item.heading) *1000.0);
+
+        item.ref2.easting = item.origin.easting + (sin(item.heading) * 1000.0);
+        item.ref2.northing = item.origin.northing + (cos(item.heading) * 1000.0);
+        lineArr.append(item);
+    }
+}
+
+void CFieldLoader::readCurveLines(QTextStream &reader, QVector<CCurveLines> &curveArr)
+{
+    QString line;
+    curveArr.clear();
+
+    //read header $CurveLine
+    line = reader.readLine();
+
+    while (!reader.atEnd())
+    {
+        line = reader.readLine();
+        if(line.isNull()) break; //no more to read
+
+        CCurveLines item;
+
+        //read header $CurveLine
+        item.Name = line;
+        // get the average heading
+        line = reader.readLine();
+        item.aveHeading = line.toDouble();
+
+        line = reader.readLine();
+        int numPoints = line.toInt();
+
+        //a line needs at least 2 points
+        if (numPoints > 1)
+        {
+            for (int i = 0; i < numPoints; i++)
+            {
+                line = reader.readLine();
+                QStringList words = line.split(',');
+                Vec3 vecPt(words[0].toDouble(),
+                           words[1].toDouble(),
+                           words[2].toDouble());
+                item.curvePts.append(vecPt);
+            }
+            curveArr.append(item);
+        }
+    }
+}
+
+void CFieldLoader::readFlags(QTextStream &reader)
+{
+    QString line;
+
+    //read header
+    line = reader.readLine();
+
+    //number of flags
+    line = reader.readLine();
+    int points = line.toInt();
+
+    if (points > 0)
+    {
+        double lat;
+        double longi;
+        double east;
+        double nort;
+        double head;
+        int color, ID;
+        QString notes;
+
+        for (int v = 0; v < points; v++)
+        {
+            line = reader.readLine();
+            QStringList words = line.split(',');
+
+            if (words.count() == 8)
+            {
+                lat = words[0].toDouble();
+                longi = words[1].toDouble();
+                east = words[2].toDouble();
+                nort = words[3].toDouble();
+                head = words[4].toDouble();
+                color = words[5].toInt();
+                ID = words[6].toInt();
+                notes = words[7].trimmed();
+            }
+            else
+            {
+                lat = words[0].toDouble();
+                longi = words[1].toDouble();
+                east = words[2].toDouble();
+                nort = words[3].toDouble();
+                head = 0;
+                color = words[4].toInt();
+                ID = words[5].toInt();
+                notes = "";
+            }
+
+            CFlag flagPt(lat, longi, east, nort, head, color, ID, notes);
+            flagPts.append(flagPt);
+        }
+    }
+}
+
+void CFieldLoader::readBoundary(QTextStream &reader)
+{
+    QString line;
+
+    //read header
+    line = reader.readLine();//Boundary
+
+    while (!reader.atEnd())
+    {
+        CBoundaryLines bndLines;
+
+        //True or False OR points from older boundary files
+        line = reader.readLine();
+
+        //Check for older boundary files, then above line string is num of points
+        if (line == "True")
+        {
+            bndLines.isDriveThru = true;
+            line = reader.readLine();
+        } else if (line == "False")
+        {
+            bndLines.isDriveThru = false;
+            line = reader.readLine(); //number of points
+        }
+
+        //Check for latest boundary files, then above line string is num of points
+        if (line == "True")
+        {
+            bndLines.isDriveAround = true;
+            line = reader.readLine(); //number of points
+        } else if( line == "False")
+        {
+            bndLines.isDriveAround = false;
+            line = reader.readLine(); //number of points
+        }
+
+        int numPoints = line.toInt();
+
+        //empty boundaries are skipped
+        if (numPoints > 0)
+        {
+            //load the line
+            for (int i = 0; i < numPoints; i++)
+            {
+                line = reader.readLine();
+                QStringList words = line.split(',');
+                Vec3 vecPt( words[0].toDouble(),
+                            words[1].toDouble(),
+                            words[2].toDouble() );
+
+                bndLines.bndLine.append(vecPt);
+            }
+
+            bndLines.calculateBoundaryArea();
+            bndLines.preCalcBoundaryLines();
+            if (bndLines.area > 0) bndLines.isSet = true;
+            else bndLines.isSet = false;
+
+            bndArr.append(bndLines);
+        }
+    }
+}
+
+void CFieldLoader::readHeadland(QTextStream &reader)
+{
+    QString line;
+
+    //read header
+    line = reader.readLine();
+
+    while (!reader.atEnd())
+    {
+        QVector<Vec3> hdLine;
+
+        //read the number of points
+        line = reader.readLine();
+        int numPoints = line.toInt();
+
+        //load the line
+        for (int i = 0; i < numPoints; i++)
+        {
+            line = reader.readLine();
+            QStringList words = line.split(',');
+            Vec3 vecPt(words[0].toDouble(),
+                       words[1].toDouble(),
+                       words[2].toDouble());
+            hdLine.append(vecPt);
+        }
+        headLines.append(hdLine);
+    }
+}
+
+void CFieldLoader::readRecPath(QTextStream &reader)
+{
+    QString line;
+
+    //read header
+    line = reader.readLine();
+    line = reader.readLine();
+    int numPoints = line.toInt();
+
+    for (int v = 0; v < numPoints && !reader.atEnd(); v++)
+    {
+        line = reader.readLine();
+        QStringList words = line.split(',');
+        CRecPathPt point(
+            words[0].toDouble(),
+            words[1].toDouble(),
+            words[2].toDouble(),
+            words[3].toDouble(),
+            (words[4] == "True" ? true : false) );
+
+        //add the point
+        recList.append(point);
+    }
+}
+
+bool CFieldLoader::readSections(const QString &textFilename, const QString &binFilename,
+                                QVector<QSharedPointer<TriangleList>> &patches)
+{
+    //the binary copy is only good if nothing wrote the text after it,
+    //the last chunk holds the text file's size and time when it did
+    if (QFile::exists(binFilename) && CPatchFile::isBinaryInSync(textFilename, binFilename) &&
+        CPatchFile::readSections(binFilename, patches))
+    {
+        //put back the text AgOpenGPS reads if it went missing
+        if (!QFile::exists(textFilename))
+        {
+            QFile sectionFile(textFilename);
+            if (sectionFile.open(QIODevice::WriteOnly))
+            {
+                QTextStream writer(&sectionFile);
+                CPatchFile::writeSectionsText(writer, patches);
+            }
+        }
+        return true;
+    }
+
+    patches.clear();
+
+    QFile sectionsFile(textFilename);
+    if (!sectionsFile.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Couldn't open sections " << textFilename << "for reading!";
+        //TODO timed messagebox
+        return false;
+    }
+
+    QTextStream reader(&sectionsFile);
+    CPatchFile::readSectionsText(reader, patches);
+    sectionsFile.close();
+
+    //next open reads the binary copy instead
+    CPatchFile::writeSections(binFilename, textFilename, patches);
+    return true;
+}
+
+bool CFieldLoader::readContour(const QString &textFilename, const QString &binFilename,
+                               QVector<QSharedPointer<QVector<Vec3>>> &strips)
+{
+    if (QFile::exists(binFilename) && CPatchFile::isBinaryInSync(textFilename, binFilename) &&
+        CPatchFile::readContour(binFilename, strips))
+    {
+        if (!QFile::exists(textFilename))
+        {
+            QFile contourFile(textFilename);
+            if (contourFile.open(QIODevice::WriteOnly))
+            {
+                QTextStream writer(&contourFile);
+                writer << "$Contour" << Qt::endl;
+                CPatchFile::writeContourText(writer, strips);
+            }
+        }
+        return true;
+    }
+
+    strips.clear();
+
+    QFile contourFile(textFilename);
+    if (!contourFile.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Couldn't open contour " << textFilename << "for reading!";
+        //TODO timed messagebox
+        return false;
+    }
+
+    QTextStream reader(&contourFile);
+    CPatchFile::readContourText(reader, strips);
+    contourFile.close();
+
+    CPatchFile::writeContour(binFilename, textFilename, strips);
+    return true;
+}
@@ -0,0 +1,109 @@
+#ifndef CFIELDLOADER_H
+#define CFIELDLOADER_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include "vec3.h"
+#include "csection.h"
+#include "cabline.h"
+#include "cabcurve.h"
+#include "cflag.h"
+#include "cboundarylines.h"
+#include "crecordedpath.h"
+#include "cpatchindex.h"
+#include "ccoverageraster.h"
+
+class QTextStream;
+
+//Reads all the files of a field at once on the global thread pool. The
+//directory is listed once up front, then every file is parsed into this
+//object on its own, without touching FormGPS. fileOpenField() runs
+//load() off the GUI thread and swaps it all in under one lock once
+//everything is read.
+class CFieldLoader : public QObject
+{
+    Q_OBJECT
+public:
+    enum FieldFile { FieldTxt, ABLinesTxt, CurveLinesTxt, SectionsTxt, ContourTxt,
+                     FlagsTxt, BoundaryTxt, HeadlandTxt, RecPathTxt, NUMFILES };
+
+    //Field.txt
+    QString fieldDirectory;
+    int utmEast = 0, utmNorth = 0, zone = 0;
+    double actualEasting = 0, actualNorthing = 0;
+    bool hasConvergence = false, hasStart = false;
+    double convergenceAngle = 0, latStart = 0, lonStart = 0;
+
+    QVector<CABLines> lineArr;
+    QVector<CCurveLines> curveArr;
+
+    //every patch as read, and the ones with points ready for the index
+    QVector<QSharedPointer<TriangleList>> patches;
+    QVector<CPatchIndex::Patch> patchItems;
+    double workedAreaTotal = 0;
+
+    //every patch counted in, set the resolution before load()
+    CCoverageRaster coverage;
+
+    QVector<QSharedPointer<QVector<Vec3>>> strips;
+    QVector<CFlag> flagPts;
+
+    //boundaries with their area and inside test already worked out
+    QVector<CBoundaryLines> bndArr;
+
+    //one entry for each headland in the file, empty ones too
+    QVector<QVector<Vec3>> headLines;
+
+    QVector<CRecPathPt> recList;
+
+    //whether each file was there and read, and how long it took in ms
+    bool isRead[NUMFILES];
+    double readTime[NUMFILES];
+    double totalTime = 0;
+
+    explicit CFieldLoader(QObject *parent = 0);
+
+    //read every file in directoryName, returns once they are all done.
+    //Blocks, so call it from a worker thread.
+    void load(const QString &directoryName);
+
+    static const char *fileName(int file);
+
+    //as given to load()
+    inline const QString &directory() const { return directoryName; }
+
+    //the binary copy if it is in step with the text, otherwise the text,
+    //which is then written out as the binary for next time
+    static bool readSections(const QString &textFilename, const QString &binFilename,
+                             QVector<QSharedPointer<TriangleList>> &patches);
+    static bool readContour(const QString &textFilename, const QString &binFilename,
+                            QVector<QSharedPointer<QVector<Vec3>>> &strips);
+
+    static void readABLines(QTextStream &reader, QVector<CABLines> &lineArr);
+    static void readCurveLines(QTextStream &reader, QVector<CCurveLines> &curveArr);
+
+signals:
+    //from the pool threads as each file is done, connect it queued
+    void progress(const QString &filename, int filesDone, int filesTotal);
+
+private:
+    QString directoryName;
+    QHash<QString, QString> listing; //lower case name -> name on disk
+    QAtomicInt filesDone;
+
+    //filename as it is on disk, whatever its case
+    QString findFile(const QString &name) const;
+
+    bool readFile(int file);
+    void readField(QTextStream &reader);
+    void readFlags(QTextStream &reader);
+    void readBoundary(QTextStream &reader);
+    void readHeadland(QTextStream &reader);
+    void readRecPath(QTextStream &reader);
+};
+
+#endif // CFIELDLOADER_H
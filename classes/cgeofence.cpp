@@ -8,6 +8,8 @@
 #include "glm.h"
 #include "glutils.h"
 #include "aogsettings.h"
+#include "cpolygonoffset.h"
+#include <algorithm>
 
 CGeoFence::CGeoFence()
 {
@@ -112,7 +114,7 @@ void CGeoFence::findPointsDriveAround(CTurn &turn, const CBoundary &bnd,
             return;
         }
 
-        if (mazeGrid.mazeArr[iStart] == 0) break;
+        if (!mazeGrid.isBlocked(iStart)) break;
     }
 
     for (int i = 0; i < 30; i++)
@@ -132,7 +134,7 @@ void CGeoFence::findPointsDriveAround(CTurn &turn, const CBoundary &bnd,
             return;
         }
 
-        if (mazeGrid.mazeArr[iStop] == 0) break;
+        if (!mazeGrid.isBlocked(iStop)) break;
     }
 
 }
@@ -199,57 +201,35 @@ void CGeoFence::buildGeoFenceLines(CBoundary &bnd)
         return;
     }
 
-    //to fill the list of line points
-    Vec3 point;
-
     //determine how wide a headland space
     double totalHeadWidth = ytGeoFenceDistance;
 
-    //outside boundary - count the points from the boundary
+    //fence lines are wound the opposite way of their boundary
+    QVector<Vec3> ring;
+    QVector<Vec3> fence;
+
+    //outside boundary shrunk by the fence distance
+    ring = bnd.bndArr[0].bndLine;
+    std::reverse(ring.begin(), ring.end());
+    fence = CPolygonOffset::offset(ring, -totalHeadWidth, toolWidth, toolWidth * 1.25);
+
     geoFenceArr[0].geoFenceLine.clear();
-    int ptCount = bnd.bndArr[0].bndLine.size();
-    for (int i = ptCount - 1; i >= 0; i--)
-    {
-        //calculate the point inside the boundary
-        point.easting = bnd.bndArr[0].bndLine[i].easting + (-sin(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * totalHeadWidth);
-        point.northing = bnd.bndArr[0].bndLine[i].northing + (-cos(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * totalHeadWidth);
-        point.heading = bnd.bndArr[0].bndLine[i].heading;
-        if (point.heading < -glm::twoPI) point.heading += glm::twoPI;
-
-        //only add if inside actual field boundary
-        if (bnd.bndArr[0].isPointInsideBoundary(point))
-        {
-            Vec2 tPnt(point.easting, point.northing);
-            geoFenceArr[0].geoFenceLine.append(tPnt);
-        }
-    }
-    geoFenceArr[0].fixGeoFenceLine(totalHeadWidth, bnd.bndArr[0].bndLine, toolWidth);
+    for (int i = 0; i < fence.size(); i++)
+        geoFenceArr[0].geoFenceLine.append(Vec2(fence[i].easting, fence[i].northing));
     geoFenceArr[0].preCalcTurnLines();
 
-    //inside boundaries
+    //inside boundaries grown by the fence distance
     for (int j = 1; j < bnd.bndArr.size(); j++)
     {
         geoFenceArr[j].geoFenceLine.clear();
         if (!bnd.bndArr[j].isSet || bnd.bndArr[j].isDriveThru) continue;
 
-        ptCount = bnd.bndArr[j].bndLine.size();
+        ring = bnd.bndArr[j].bndLine;
+        std::reverse(ring.begin(), ring.end());
+        fence = CPolygonOffset::offset(ring, totalHeadWidth, toolWidth * 0.5, toolWidth * 0.5 * 1.25);
 
-        for (int i = ptCount - 1; i >= 0; i--)
-        {
-            //calculate the point outside the boundary
-            point.easting = bnd.bndArr[j].bndLine[i].easting + (-sin(glm::PIBy2 + bnd.bndArr[j].bndLine[i].heading) * totalHeadWidth);
-            point.northing = bnd.bndArr[j].bndLine[i].northing + (-cos(glm::PIBy2 + bnd.bndArr[j].bndLine[i].heading) * totalHeadWidth);
-            point.heading = bnd.bndArr[j].bndLine[i].heading;
-            if (point.heading < -glm::twoPI) point.heading += glm::twoPI;
-
-            //only add if outside actual field boundary
-            if (!bnd.bndArr[j].isPointInsideBoundary(point))
-            {
-                Vec2 tPnt(point.easting, point.northing);
-                geoFenceArr[j].geoFenceLine.append(tPnt);
-            }
-        }
-        geoFenceArr[j].fixGeoFenceLine(totalHeadWidth, bnd.bndArr[j].bndLine, toolWidth * 0.5);
+        for (int i = 0; i < fence.size(); i++)
+            geoFenceArr[j].geoFenceLine.append(Vec2(fence[i].easting, fence[i].northing));
         geoFenceArr[j].preCalcTurnLines();
     }
 }
@@ -3,6 +3,7 @@
 
 #include <QVector>
 #include "vec2.h"
+#include "cpolygonindex.h"
 #include "vec3.h"
 
 class QOpenGLFunctions;
@@ -14,6 +15,11 @@ class CGeoFenceLines
 public:
     QVector<Vec2> geoFenceLine;
     QVector<Vec2> calcList;
+    //slabs over the same edges for the inside tests
+    CPolygonIndex calcIndex;
+    //new every time the points are rebuilt, so the GPU copy of the
+    //line is only uploaded again after an edit or load
+    int generation;
 
 
     CGeoFenceLines();
@@ -21,7 +27,6 @@ public:
     bool isPointInGeoFenceArea(Vec3 testPointv2);
     bool isPointInGeoFenceArea(Vec2 testPointv2);
     void drawGeoFenceLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp);
-    void fixGeoFenceLine(double totalHeadWidth, QVector<Vec3> curBnd, double spacing);
     void preCalcTurnLines();
 
 
@@ -0,0 +1,20 @@
+#include "cguidancesnapshot.h"
+
+CGuidanceSnapshot::CGuidanceSnapshot()
+    : state(new CGuidanceState)
+{
+}
+
+void CGuidanceSnapshot::publish(const QSharedPointer<const CGuidanceState> &newState)
+{
+    QMutexLocker lock(&mutex);
+
+    //the renderer may still be drawing the old one, it goes when it is done
+    state = newState;
+}
+
+QSharedPointer<const CGuidanceState> CGuidanceSnapshot::read() const
+{
+    QMutexLocker lock(&mutex);
+    return state;
+}
@@ -0,0 +1,95 @@
+#ifndef CGUIDANCESNAPSHOT_H
+#define CGUIDANCESNAPSHOT_H
+
+#include <QVector>
+#include <QVector3D>
+#include <QSharedPointer>
+#include <QMutex>
+#include "vec2.h"
+#include "vec3.h"
+#include "btnenum.h"
+#include "common.h"
+
+//What the renderer draws of the guidance lines, the U-turn, the tool
+//and its sections, as they were at the end of the last fix. The lists
+//are Qt implicitly shared, so filling one in only bumps a reference
+//count, and the positioning thread gets its own copy of a list the
+//next time it changes it.
+struct CGuidanceState
+{
+    //contour
+    bool isContourBtnOn = false;
+    QVector<Vec3> ctList;
+    Vec2 goalPointCT;
+    double ctDistanceFromCurrentLine = 32000;
+
+    //AB line
+    bool isABLineSet = false, isABLineBeingSet = false;
+    bool isBtnABLineOn = false, isABEditing = false;
+    bool isABSameAsVehicleHeading = true;
+    Vec2 refPoint1, refPoint2;
+    Vec2 refABLineP1, refABLineP2;
+    Vec2 currentABLineP1, currentABLineP2;
+    Vec2 goalPointAB;
+    double abHeading = 0;
+    double passNumber = 0;
+
+    //AB curve
+    bool isBtnCurveOn = false, isCurveSet = false;
+    bool isCurveEditing = false, isSmoothWindowOpen = false;
+    QVector<Vec3> refList, curList, smooList;
+    Vec2 goalPointCu, radiusPointCu;
+    double ppRadiusCu = 0;
+    double aveLineHeading = 0;
+    double curveNumber = 0;
+
+    //U-turn
+    bool isYouTurnBtnOn = false, isYouTurnTriggered = false;
+    bool isYouTurnRight = false, isOutOfBounds = false;
+    bool isRecordingCustomYouTurn = false;
+    QVector<Vec3> ytList;
+    QVector<Vec2> youFileList;
+    int onA = 0;
+    double distancePivotToTurnLine = -2222;
+
+    //vehicle and tool
+    double fixHeading = 0;
+    double cosSectionHeading = 1, sinSectionHeading = 0;
+    Vec3 pivotAxlePos, toolPos, tankPos;
+    double hydLiftLookAheadDistanceLeft = 0, hydLiftLookAheadDistanceRight = 0;
+    bool isToolUp = true;
+    double toolFarLeftPosition = 0, toolFarRightPosition = 0;
+    double lookAheadDistanceOnPixelsLeft = 0, lookAheadDistanceOnPixelsRight = 0;
+    double lookAheadDistanceOffPixelsLeft = 0, lookAheadDistanceOffPixelsRight = 0;
+
+    struct Section
+    {
+        bool isSectionOn = false;
+        btnStates manBtnState = btnStates::Off;
+        double positionLeft = 0, positionRight = 0;
+
+        //last two points of the patch being laid down, the triangle
+        //from there to the tool is drawn every frame
+        bool hasPatch = false;
+        QVector3D patchLeft, patchRight;
+    };
+    Section section[MAXSECTIONS+1];
+};
+
+//Hands a CGuidanceState from the positioning thread to the renderer.
+//publish() replaces the whole state, read() hands out the current one,
+//so the lock is only ever held to swap a pointer.
+class CGuidanceSnapshot
+{
+public:
+    CGuidanceSnapshot();
+
+    void publish(const QSharedPointer<const CGuidanceState> &newState);
+    QSharedPointer<const CGuidanceState> read() const;
+
+private:
+    mutable QMutex mutex;
+    QSharedPointer<const CGuidanceState> state;
+};
+
+#endif // CGUIDANCESNAPSHOT_H
@@ -22,9 +22,9 @@ CHead::CHead(QObject *parent) : QObject(parent)
 
 void CHead::setHydPosition(double currentSpeed)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    if (SETTINGS_VEHICLE_ISHYDLIFTON && currentSpeed > 0.2 ) //TODO: && mf.autoBtnState == FormGPS.btnStates.Auto
+    if (snapshot->vehicleIsHydLiftOn && currentSpeed > 0.2 ) //TODO: && mf.autoBtnState == FormGPS.btnStates.Auto
     {
         if (isToolInHeadland)
         {
@@ -41,9 +41,9 @@ void CHead::setHydPosition(double currentSpeed)
 
 void CHead::whereAreToolCorners(CTool &tool)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
+    int tool_numOfSections = snapshot->toolNumSections;
 
     if (headArr[0].hdLine.count() == 0)
     {
@@ -96,9 +96,9 @@ void CHead::whereAreToolCorners(CTool &tool)
 
 void CHead::whereAreToolLookOnPoints(const CVehicle &vehicle, CTool &tool)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
+    int tool_numOfSections = snapshot->toolNumSections;
 
     if (headArr[0].hdLine.count() == 0)
     {
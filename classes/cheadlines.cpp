@@ -8,49 +8,26 @@
 
 CHeadLines::CHeadLines()
 {
-
+    generation = nextGeometryGeneration();
 }
 
 void CHeadLines::resetHead()
 {
     calcList.clear();
+    calcIndex.clear();
     hdLine.clear();
+
+    generation = nextGeometryGeneration();
 }
 
 bool CHeadLines::isPointInHeadArea(Vec3 testPointv2)
 {
-    if (calcList.size() < 3) return false;
-    int j = hdLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < hdLine.size(); j = i++)
-    {
-        if ((hdLine[i].northing < testPointv2.northing && hdLine[j].northing >= testPointv2.northing)
-        || (hdLine[j].northing < testPointv2.northing && hdLine[i].northing >= testPointv2.northing))
-        {
-            oddNodes ^= ((testPointv2.northing * calcList[i].northing) + calcList[i].easting < testPointv2.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv2); //true means inside.
 }
 
 bool CHeadLines::isPointInHeadArea(Vec2 testPointv2)
 {
-    if (calcList.size() < 3) return false;
-    int j = hdLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < hdLine.size(); j = i++)
-    {
-        if ((hdLine[i].northing < testPointv2.northing && hdLine[j].northing >= testPointv2.northing)
-        || (hdLine[j].northing < testPointv2.northing && hdLine[i].northing >= testPointv2.northing))
-        {
-            oddNodes ^= ((testPointv2.northing * calcList[i].northing) + calcList[i].easting < testPointv2.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv2); //true means inside.
 }
 
 void CHeadLines::drawHeadLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, int linewidth)
@@ -60,40 +37,54 @@ void CHeadLines::drawHeadLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, int l
     int cntr = 0;
     if (ptCount > 1)
     {
-        GLHelperOneColor gldraw;
-
         gl->glLineWidth(linewidth);
 
         QColor color = QColor::fromRgbF(0.960f, 0.96232f, 0.30f);
         //GL.PointSize(2);
 
-        while (cntr < ptCount)
+        if (!isGeometryCurrent(this, generation))
         {
-            if (isDrawList[cntr])
+            //every drawn run of the headland, as line segments so the
+            //gaps between runs need no extra draw calls
+            QVector<QVector3D> vertices;
+            QVector<QVector3D> strip;
+
+            while (cntr < ptCount)
             {
-                gldraw.clear();
-                if (cntr > 0)
-                    gldraw.append(QVector3D(hdLine[cntr - 1].easting, hdLine[cntr - 1].northing, 0));
+                if (isDrawList[cntr])
+                {
+                    strip.clear();
+                    if (cntr > 0)
+                        strip.append(QVector3D(hdLine[cntr - 1].easting, hdLine[cntr - 1].northing, 0));
+                    else
+                        strip.append(QVector3D(hdLine[hdLine.size() - 1].easting, hdLine[hdLine.size() - 1].northing, 0));
+
+
+                    for (int i = cntr; i < ptCount; i++)
+                    {
+                        cntr++;
+                        if (!isDrawList[i]) break;
+                        strip.append(QVector3D(hdLine[i].easting, hdLine[i].northing, 0));
+                    }
+                    if (cntr < ptCount - 1)
+                    strip.append(QVector3D(hdLine[cntr+1].easting, hdLine[cntr+1].northing, 0));
+
+                    for (int i = 1; i < strip.size(); i++)
+                    {
+                        vertices.append(strip[i - 1]);
+                        vertices.append(strip[i]);
+                    }
+                }
                 else
-                    gldraw.append(QVector3D(hdLine[hdLine.size() - 1].easting, hdLine[hdLine.size() - 1].northing, 0));
-
-
-                for (int i = cntr; i < ptCount; i++)
                 {
                     cntr++;
-                    if (!isDrawList[i]) break;
-                    gldraw.append(QVector3D(hdLine[i].easting, hdLine[i].northing, 0));
                 }
-                if (cntr < ptCount - 1)
-                gldraw.append(QVector3D(hdLine[cntr+1].easting, hdLine[cntr+1].northing, 0));
-
-                gldraw.draw(gl, mvp, color, GL_LINE_STRIP, linewidth);
-            }
-            else
-            {
-                cntr++;
             }
+
+            uploadGeometry(this, generation, vertices);
         }
+
+        drawGeometry(gl, mvp, this, color, GL_LINES, linewidth);
     }
 }
 
@@ -164,5 +155,9 @@ void CHeadLines::preCalcHeadLines()
             calcList.append(constantMultiple);
         }
     }
+
+    calcIndex.build(hdLine, calcList);
+
+    generation = nextGeometryGeneration();
 }
 
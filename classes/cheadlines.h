@@ -4,6 +4,7 @@
 #include <QVector>
 #include "vec3.h"
 #include "vec2.h"
+#include "cpolygonindex.h"
 
 class QOpenGLFunctions;
 class QMatrix4x4;
@@ -13,7 +14,12 @@ class CHeadLines
 public:
     QVector<Vec3> hdLine;
     QVector<Vec2> calcList;
+    //slabs over the same edges for the inside tests
+    CPolygonIndex calcIndex;
     QVector<bool> isDrawList;
+    //new every time the points are rebuilt, so the GPU copy of the
+    //line is only uploaded again after an edit or load
+    int generation;
 
     CHeadLines();
     void resetHead();
@@ -0,0 +1,95 @@
+#include "clatencyhistogram.h"
+#include <QMutexLocker>
+
+const int CLatencyHistogram::bucketEdges[CLatencyHistogram::NUMBUCKETS - 1] = {
+    100, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000
+};
+
+CLatencyHistogram::CLatencyHistogram()
+{
+    clear();
+}
+
+void CLatencyHistogram::add(qint64 usec)
+{
+    int bucket = 0;
+    while (bucket < NUMBUCKETS - 1 && usec > bucketEdges[bucket]) bucket++;
+
+    QMutexLocker locker(&lock);
+    buckets[bucket]++;
+    total++;
+    sumUsec += usec;
+    if (usec > maxUsec) maxUsec = usec;
+}
+
+void CLatencyHistogram::clear()
+{
+    QMutexLocker locker(&lock);
+    for (int i = 0; i < NUMBUCKETS; i++) buckets[i] = 0;
+    total = 0;
+    sumUsec = 0;
+    maxUsec = 0;
+}
+
+int CLatencyHistogram::bucketCount(int bucket) const
+{
+    QMutexLocker locker(&lock);
+    if (bucket < 0 || bucket >= NUMBUCKETS) return 0;
+    return buckets[bucket];
+}
+
+int CLatencyHistogram::count() const
+{
+    QMutexLocker locker(&lock);
+    return total;
+}
+
+double CLatencyHistogram::meanMs() const
+{
+    QMutexLocker locker(&lock);
+    if (total == 0) return 0;
+    return sumUsec * 0.001 / total;
+}
+
+double CLatencyHistogram::maxMs() const
+{
+    QMutexLocker locker(&lock);
+    return maxUsec * 0.001;
+}
+
+double CLatencyHistogram::percentileMs(double fraction) const
+{
+    QMutexLocker locker(&lock);
+    if (total == 0) return 0;
+
+    int needed = (int)(fraction * total + 0.5);
+    int running = 0;
+    for (int i = 0; i < NUMBUCKETS - 1; i++)
+    {
+        running += buckets[i];
+        if (running >= needed) return bucketEdges[i] * 0.001;
+    }
+
+    //slower than the last edge, the max is the best we know
+    return maxUsec * 0.001;
+}
+
+QString CLatencyHistogram::toString() const
+{
+    QString result = QString("fix latency n=%1 mean=%2ms p95<=%3ms max=%4ms |")
+            .arg(count())
+            .arg(meanMs(), 0, 'f', 2)
+            .arg(percentileMs(0.95), 0, 'f', 2)
+            .arg(maxMs(), 0, 'f', 2);
+
+    QMutexLocker locker(&lock);
+    for (int i = 0; i < NUMBUCKETS; i++)
+    {
+        if (i < NUMBUCKETS - 1)
+            result += QString(" <=%1ms:%2").arg(bucketEdges[i] * 0.001).arg(buckets[i]);
+        else
+            result += QString(" more:%1").arg(buckets[i]);
+    }
+
+    return result;
+}
@@ -0,0 +1,42 @@
+#ifndef CLATENCYHISTOGRAM_H
+#define CLATENCYHISTOGRAM_H
+
+#include <QMutex>
+#include <QString>
+
+//Histogram of how long a fix takes from the moment its bytes arrive
+//to the moment the steer values for it are worked out. Filled in by
+//the positioning thread, read by anyone for tuning.
+class CLatencyHistogram
+{
+public:
+    static const int NUMBUCKETS = 11;
+
+    //upper edge of each bucket in microseconds, the last bucket
+    //holds everything slower
+    static const int bucketEdges[NUMBUCKETS - 1];
+
+    CLatencyHistogram();
+
+    void add(qint64 usec);
+    void clear();
+
+    int bucketCount(int bucket) const;
+    int count() const;
+    double meanMs() const;
+    double maxMs() const;
+
+    //upper edge of the bucket the given fraction of fixes falls in, ms
+    double percentileMs(double fraction) const;
+
+    QString toString() const;
+
+private:
+    mutable QMutex lock;
+    int buckets[NUMBUCKETS];
+    int total;
+    qint64 sumUsec;
+    qint64 maxUsec;
+};
+
+#endif // CLATENCYHISTOGRAM_H
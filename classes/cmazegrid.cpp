@@ -1,18 +1,14 @@
 #include "cmazegrid.h"
 #include "cgeofence.h"
 #include "cboundary.h"
-#include "cmazepath.h"
 #include "glm.h"
 #include "glutils.h"
+#include <QtConcurrent>
+#include <algorithm>
 
-CMazeGrid::CMazeGrid()
+CMazeGrid::CMazeGrid() :
+    mazePath(*this)
 {
-    mazeArr = NULL;
-}
-
-CMazeGrid::~CMazeGrid()
-{
-    if(mazeArr) delete mazeArr;
 }
 
 void CMazeGrid::buildMazeGridArray(const CBoundary &bnd, CGeoFence &gf,
@@ -30,73 +26,116 @@ void CMazeGrid::buildMazeGridArray(const CBoundary &bnd, CGeoFence &gf,
 
     mazeRowYDim = (int)mazeY / mazeScale;
     mazeColXDim = (int)mazeX / mazeScale;
+    if (mazeRowYDim < 0) mazeRowYDim = 0;
+    if (mazeColXDim < 0) mazeColXDim = 0;
 
-    if(mazeArr) delete mazeArr;
-    mazeArr = new int[mazeRowYDim * mazeColXDim];
-    memset(mazeArr,0,sizeof(int) * mazeRowYDim * mazeColXDim);
-
-    //row is Y, col is X   int[Y,X] [i,j] [row,col]
-    Vec3 pot;
+    //row is Y, col is X   [i,j] [row,col]
+    rowWords = (mazeColXDim + 31) >> 5;
+    mazeBits.fill(0, mazeRowYDim * rowWords);
+    if (mazeRowYDim == 0 || mazeColXDim == 0) return;
 
     //mf.yt.triggerDistanceOffset += mazeScale;
     //mf.turn.BuildTurnLines();
 
-    int arr[mazeRowYDim][mazeColXDim];
-    memset(arr,0,sizeof(int) * mazeRowYDim * mazeColXDim);
+    QVector<int> rows(mazeRowYDim);
+    for (int i = 0; i < mazeRowYDim; i++) rows[i] = i;
+
+    //rows don't share any words, so each one can be filled on its own
+    quint32 *bits = mazeBits.data();
+    QtConcurrent::blockingMap(rows, [&](int row) {
+        fillRow(row, bits + row * rowWords, bnd, gf, minFieldX, minFieldY);
+    });
+
+    //only cells off the edge of the grid spread to their neighbours
+    QVector<quint32> interior(rowWords, 0);
+    for (int j = 1; j < mazeColXDim - 1; j++) interior[j >> 5] |= 1u << (j & 31);
+
+    //grow the blocked cells by one up, down, left and right
+    QVector<quint32> blocked(mazeBits);
+    const quint32 *src = blocked.constData();
+    const quint32 *mask = interior.constData();
+    bits = mazeBits.data();
+    QtConcurrent::blockingMap(rows, [&](int row) {
+        dilateRow(row, src, mask, bits + row * rowWords);
+    });
+}
+
+void CMazeGrid::fillRow(int row, quint32 *bits, const CBoundary &bnd, const CGeoFence &gf,
+                        double minFieldX, double minFieldY) const
+{
+    double northing = (row * mazeScale) + (int)minFieldY;
+    int originX = (int)minFieldX;
+
+    //every cell starts blocked, the outer fence opens them up
+    for (int w = 0; w < rowWords; w++) bits[w] = 0;
+
+    QVector<double> crossings;
+    if (gf.geoFenceArr.size() > 0)
+        gf.geoFenceArr[0].calcIndex.crossings(northing, crossings);
+    std::sort(crossings.begin(), crossings.end());
 
-    for (int i = 0; i < mazeRowYDim; i++)
+    //a cell is inside if an odd number of crossings are west of it
+    int k = 0;
+    for (int j = 0; j < mazeColXDim; j++)
     {
-        for (int j = 0; j < mazeColXDim; j++)
-        {
-            pot.easting = (j * mazeScale) + (int)minFieldX;
-            pot.northing = (i * mazeScale) + (int)minFieldY;
-            if (!gf.isPointInsideGeoFences(bnd, pot))
-            {
-                mazeArr[(i * mazeColXDim) + j] = 1;
-                arr[i][j] = 1;
-            }
-            else
-            {
-                mazeArr[(i * mazeColXDim) + j] = 0;
-                arr[i][j] = 0;
-            }
-        }
+        double easting = (j * mazeScale) + originX;
+        while (k < crossings.size() && crossings[k] < easting) k++;
+        if (!(k & 1)) bits[j >> 5] |= 1u << (j & 31);
     }
 
-    for (int i = 0; i < mazeRowYDim; i++)
+    //inner fences close them again
+    for (int b = 1; b < bnd.bndArr.size(); b++)
     {
+        if (!bnd.bndArr[b].isSet) continue;
+
+        crossings.clear();
+        gf.geoFenceArr[b].calcIndex.crossings(northing, crossings);
+        if (crossings.size() == 0) continue;
+        std::sort(crossings.begin(), crossings.end());
+
+        k = 0;
         for (int j = 0; j < mazeColXDim; j++)
         {
-            if (i > 0 && i < mazeRowYDim - 1 && j > 0 && j < mazeColXDim - 1)
-            {
-                if (arr[i][j] == 1 && arr[i + 1][j] == 0) arr[i + 1][j] = 2;
-                if (arr[i][j] == 1 && arr[i - 1][j] == 0) arr[i - 1][j] = 2;
-                if (arr[i][j] == 1 && arr[i][j + 1] == 0) arr[i][j + 1] = 2;
-                if (arr[i][j] == 1 && arr[i][j - 1] == 0) arr[i][j - 1] = 2;
-            }
+            double easting = (j * mazeScale) + originX;
+            while (k < crossings.size() && crossings[k] < easting) k++;
+            if (k & 1) bits[j >> 5] |= 1u << (j & 31);
         }
     }
+}
 
-    for (int i = 0; i < mazeRowYDim; i++)
+void CMazeGrid::dilateRow(int row, const quint32 *blocked, const quint32 *interior,
+                          quint32 *bits) const
+{
+    const quint32 *here = blocked + row * rowWords;
+    const quint32 *above = (row < mazeRowYDim - 2) ? here + rowWords : NULL;
+    const quint32 *below = (row > 1) ? here - rowWords : NULL;
+    bool isInteriorRow = (row > 0 && row < mazeRowYDim - 1);
+
+    for (int w = 0; w < rowWords; w++)
     {
-        for (int j = 0; j < mazeColXDim; j++)
+        quint32 spread = here[w];
+
+        //from the rows either side
+        if (above) spread |= above[w] & interior[w];
+        if (below) spread |= below[w] & interior[w];
+
+        //from the cells either side in this row, carrying across words
+        if (isInteriorRow)
         {
-            if (arr[i][j] == 2)
-            {
-                mazeArr[(i * mazeColXDim) + j] = 1;
-                arr[i][j] = 1;
-            }
+            quint32 src = here[w] & interior[w];
+            spread |= (src << 1) | (src >> 1);
+            if (w > 0) spread |= (here[w - 1] & interior[w - 1]) >> 31;
+            if (w < rowWords - 1) spread |= (here[w + 1] & interior[w + 1]) << 31;
         }
-    }
 
+        bits[w] = spread;
+    }
 }
 
 QVector<Vec3> CMazeGrid::searchForPath (double minFieldX, double minFieldY,
                                         const Vec3 start, const Vec3 stop)
 {
-    CMazePath maze(mazeRowYDim, mazeColXDim, mazeArr);
-
-    QVector<Vec3> mazeList = maze.search((int)((start.northing - minFieldY) / mazeScale),
+    QVector<Vec3> mazeList = mazePath.search((int)((start.northing - minFieldY) / mazeScale),
                                               (int)((start.easting - minFieldX) / mazeScale),
                                               (int)((stop.northing - minFieldY) / mazeScale),
                                               (int)((stop.easting - minFieldX) / mazeScale));
@@ -204,7 +243,7 @@ void CMazeGrid::drawArr(QOpenGLFunctions *gl, const QMatrix4x4 &mvp,
     int ptCount = mazeRowYDim * mazeColXDim;
     for (int h = 0; h < ptCount; h++)
     {
-        if (mazeArr[h] == 1)
+        if (isBlocked(h))
         {
             cv.color = QVector4D(0.0095f, 0.007520f, 0.97530f,1.0f);
             int Y = h / mazeColXDim; //Y
@@ -3,22 +3,50 @@
 
 #include <QVector>
 #include "vec3.h"
+#include "cmazepath.h"
 
 class QOpenGLFunctions;
 class QMatrix4x4;
 class CGeoFence;
 class CBoundary;
 
+//Blocked/open cells over the field, one bit per cell. Rows are padded
+//to whole words so each row can be filled on its own thread.
 class CMazeGrid
 {
+private:
+    QVector<quint32> mazeBits;
+    int rowWords = 0;
+
+    //keeps its work buffers between searches
+    CMazePath mazePath;
+
+    void fillRow(int row, quint32 *bits, const CBoundary &bnd, const CGeoFence &gf,
+                 double minFieldX, double minFieldY) const;
+    void dilateRow(int row, const quint32 *blocked, const quint32 *interior,
+                   quint32 *bits) const;
+
 public:
-    int *mazeArr;
     int mazeScale = 1;
-    int mazeRowYDim;
-    int mazeColXDim;
+    int mazeRowYDim = 0;
+    int mazeColXDim = 0;
 
     CMazeGrid();
-    ~CMazeGrid();
+
+    //index is row * mazeColXDim + col, anything off the grid is blocked
+    inline bool isBlocked(int index) const
+    {
+        if (index < 0 || index >= mazeRowYDim * mazeColXDim) return true;
+        int row = index / mazeColXDim;
+        int col = index - row * mazeColXDim;
+        return (mazeBits[row * rowWords + (col >> 5)] >> (col & 31)) & 1;
+    }
+
+    inline bool isBlocked(int row, int col) const
+    {
+        if (row < 0 || row >= mazeRowYDim || col < 0 || col >= mazeColXDim) return true;
+        return (mazeBits[row * rowWords + (col >> 5)] >> (col & 31)) & 1;
+    }
 
     void buildMazeGridArray(const CBoundary &bnd, CGeoFence &gf,
                             double minFieldX, double maxFieldX,
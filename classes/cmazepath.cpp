@@ -1,203 +1,138 @@
 #include "cmazepath.h"
+#include "cmazegrid.h"
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
 
-CMazePath::CMazePath(int iRows, int iCols, int *_iMaze) :
-    mazeGrid(_iMaze), numCols(iCols), numMax(iRows*iCols)
+static const float SQRT2 = 1.41421356f;
+
+//cost of the cheapest 8 way path on an empty grid
+static inline float octile(int dx, int dy)
+{
+    dx = abs(dx);
+    dy = abs(dy);
+    return (float)(dx + dy) + (SQRT2 - 2.0f) * (float)std::min(dx, dy);
+}
+
+CMazePath::CMazePath(const CMazeGrid &_mazeGrid) :
+    mazeGrid(_mazeGrid)
 {
 
 }
 
+void CMazePath::reset()
+{
+    foreach (int i, touched)
+    {
+        status[i] = (quint8)mazePathStatus::Ready;
+        gCost[i] = HUGE_VALF;
+    }
+    touched.clear();
+    heap.clear();
+}
+
 QVector<Vec3> CMazePath::search(int iFromY, int iFromX, int iToY, int iToX)
 {
     QVector<Vec3> mazeList;
 
-    int iStart = (int)((iFromY * numCols) + iFromX);
-    int iStop = (int)((iToY * numCols) + iToX);
-
-    const int empty = 0;
+    int numCols = mazeGrid.mazeColXDim;
+    int numRows = mazeGrid.mazeRowYDim;
+    int numMax = numRows * numCols;
 
-    int Queue[numMax];
-    int Origin[numMax];
-    int iFront = 0, iRear = 0;
+    expanded = 0;
 
     //check if starting and ending points are valid (open)
-    if (mazeGrid[iStart] != empty || mazeGrid[iStop] != empty)
-    {
-        mazeList.clear();
+    if (mazeGrid.isBlocked(iFromY, iFromX) || mazeGrid.isBlocked(iToY, iToX))
         return mazeList;
+
+    reset();
+
+    if (status.size() < numMax)
+    {
+        //grid got bigger, everything starts out ready
+        status.fill((quint8)mazePathStatus::Ready, numMax);
+        gCost.fill(HUGE_VALF, numMax);
+        origin.resize(numMax);
     }
 
-    //create dummy array for storing status
-    int iMazeStatus[numMax];
-    //initially all nodes are ready
-    for (int i = 0; i < numMax; i++)
-        iMazeStatus[i] = (int)mazePathStatus::Ready;
-
-    //add starting node to Q
-    Queue[iRear] = iStart;
-    Origin[iRear] = -1;
-    iRear++;
-    int iCurrent, iLeft, iRight, iUp, iDown, iRightUp, iRightDown, iLeftUp, iLeftDown;
-    while (iFront != iRear) // while Q not empty
+    int iStart = (iFromY * numCols) + iFromX;
+    int iStop = (iToY * numCols) + iToX;
+
+    //neighbour offsets and step costs, the 4 sides then the 4 corners
+    static const int dRow[8] = { 0, 0, 1, -1, -1, 1, -1, 1 };
+    static const int dCol[8] = { -1, 1, 0, 0, 1, 1, -1, -1 };
+    static const float step[8] = { 1, 1, 1, 1, SQRT2, SQRT2, SQRT2, SQRT2 };
+
+    gCost[iStart] = 0;
+    origin[iStart] = -1;
+    status[iStart] = (quint8)mazePathStatus::Open;
+    touched.append(iStart);
+    heap.append({ octile(iToX - iFromX, iToY - iFromY), iStart });
+
+    bool isSolved = false;
+
+    while (!heap.isEmpty())
     {
-        if (Queue[iFront] == iStop)     // maze is solved
-            break;
+        std::pop_heap(heap.begin(), heap.end());
+        HeapNode node = heap.last();
+        heap.removeLast();
 
-        iCurrent = Queue[iFront];
+        int iCurrent = node.index;
 
-        iLeft = iCurrent - 1;
-        if (iLeft >= 0 && iLeft / numCols == iCurrent / numCols)    //if left node exists
-        {
-            if (mazeGrid[iLeft] == empty)   //if left node is open(a path exists)
-            {
-                if (iMazeStatus[iLeft] == (int)mazePathStatus::Ready)   //if left node is ready
-                {
-                    Queue[iRear] = iLeft; //add to Q
-                    Origin[iRear] = iCurrent;
-                    iMazeStatus[iLeft] = (int)mazePathStatus::Waiting; //change status to waiting
-                    iRear++;
-                }
-            }
-        }
+        //an older, longer entry for a cell we already finished
+        if (status[iCurrent] == (quint8)mazePathStatus::Processed) continue;
+        status[iCurrent] = (quint8)mazePathStatus::Processed;
+        expanded++;
 
-        iRight = iCurrent + 1;
-        if (iRight < numMax && iRight / numCols == iCurrent / numCols)    //if right node exists
+        if (iCurrent == iStop)     // maze is solved
         {
-            if (mazeGrid[iRight] == empty)  //if right node is open(a path exists)
-            {
-                if (iMazeStatus[iRight] == (int)mazePathStatus::Ready)  //if right node is ready
-                {
-                    Queue[iRear] = iRight; //add to Q
-                    Origin[iRear] = iCurrent;
-                    iMazeStatus[iRight] = (int)mazePathStatus::Waiting; //change status to waiting
-                    iRear++;
-                }
-            }
+            isSolved = true;
+            break;
         }
 
-        iUp = iCurrent + numCols;
-        if (iUp < numMax)  //if top node exists
-        {
-            if (mazeGrid[iUp] == empty)    //if top node is open(a path exists)
-            {
-                if (iMazeStatus[iUp] == (int)mazePathStatus::Ready)    //if top node is ready
-                {
-                    Queue[iRear] = iUp; //add to Q
-                    Origin[iRear] = iCurrent;
-                    iMazeStatus[iUp] = (int)mazePathStatus::Waiting; //change status to waiting
-                    iRear++;
-                }
-            }
-        }
+        int row = iCurrent / numCols;
+        int col = iCurrent - row * numCols;
 
-        iDown = iCurrent - numCols;
-        if (iDown >= 0)   //if bottom node exists
+        for (int n = 0; n < 8; n++)
         {
-            if (mazeGrid[iDown] == empty)   //if bottom node is open(a path exists)
-            {
-                if (iMazeStatus[iDown] == (int)mazePathStatus::Ready)   //if bottom node is ready
-                {
-                    Queue[iRear] = iDown; //add to Q
-                    Origin[iRear] = iCurrent;
-                    iMazeStatus[iDown] = (int)mazePathStatus::Waiting; //change status to waiting
-                    iRear++;
-                }
-            }
-        }
-        //if (diagonal == true)
-        {
-            iRightDown = iCurrent - numCols + 1;
-            if (iRightDown < numMax && iRightDown >= 0 && iRightDown / numCols == (iCurrent / numCols) - 1)     //if bottom-right node exists
-            {
-                if (mazeGrid[iRightDown] == empty)  //if this node is open(a path exists)
-                {
-                    if (iMazeStatus[iRightDown] == (int)mazePathStatus::Ready)  //if this node is ready
-                    {
-                        Queue[iRear] = iRightDown; //add to Q
-                        Origin[iRear] = iCurrent;
-                        iMazeStatus[iRightDown] = (int)mazePathStatus::Waiting; //change status to waiting
-                        iRear++;
-                    }
-                }
-            }
+            int nRow = row + dRow[n];
+            int nCol = col + dCol[n];
+            if (nRow < 0 || nRow >= numRows || nCol < 0 || nCol >= numCols) continue;
+            if (mazeGrid.isBlocked(nRow, nCol)) continue;
 
-            iRightUp = iCurrent + numCols + 1;
-            if (iRightUp >= 0 && iRightUp < numMax && iRightUp / numCols == (iCurrent / numCols) + 1)   //if upper-right node exists
-            {
-                if (mazeGrid[iRightUp] == empty)    //if this node is open(a path exists)
-                {
-                    if (iMazeStatus[iRightUp] == (int)mazePathStatus::Ready)    //if this node is ready
-                    {
-                        Queue[iRear] = iRightUp; //add to Q
-                        Origin[iRear] = iCurrent;
-                        iMazeStatus[iRightUp] = (int)mazePathStatus::Waiting; //change status to waiting
-                        iRear++;
-                    }
-                }
-            }
+            int iNext = iCurrent + dRow[n] * numCols + dCol[n];
+            if (status[iNext] == (quint8)mazePathStatus::Processed) continue;
 
-            iLeftDown = iCurrent - numCols - 1;
-            if (iLeftDown < numMax && iLeftDown >= 0 && iLeftDown / numCols == (iCurrent / numCols) - 1)    //if bottom-left node exists
-            {
-                if (mazeGrid[iLeftDown] == empty)   //if this node is open(a path exists)
-                {
-                    if (iMazeStatus[iLeftDown] == (int)mazePathStatus::Ready)   //if this node is ready
-                    {
-                        Queue[iRear] = iLeftDown; //add to Q
-                        Origin[iRear] = iCurrent;
-                        iMazeStatus[iLeftDown] = (int)mazePathStatus::Waiting; //change status to waiting
-                        iRear++;
-                    }
-                }
-            }
+            float g = gCost[iCurrent] + step[n];
+            if (g >= gCost[iNext]) continue;
 
-            iLeftUp = iCurrent + numCols - 1;
-            if (iLeftUp >= 0 && iLeftUp < numMax && iLeftUp / numCols == (iCurrent / numCols) + 1)  //if upper-left node exists
+            if (status[iNext] == (quint8)mazePathStatus::Ready)
             {
-                if (mazeGrid[iLeftUp] == empty)     //if this node is open(a path exists)
-                {
-                    if (iMazeStatus[iLeftUp] == (int)mazePathStatus::Ready) //if this node is ready
-                    {
-                        Queue[iRear] = iLeftUp; //add to Q
-                        Origin[iRear] = iCurrent;
-                        iMazeStatus[iLeftUp] = (int)mazePathStatus::Waiting; //change status to waiting
-                        iRear++;
-                    }
-                }
+                status[iNext] = (quint8)mazePathStatus::Open;
+                touched.append(iNext);
             }
-        }
 
-        //change status of current node to processed
-        iMazeStatus[iCurrent] = (int)mazePathStatus::Processed;
-        iFront++;
-    }
+            gCost[iNext] = g;
+            origin[iNext] = iCurrent;
 
-    Vec3 ptt;
+            //the old heap entry, if any, is skipped when it comes up
+            heap.append({ g + octile(iToX - nCol, iToY - nRow), iNext });
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
 
-    iCurrent = iStop;
-    //Y
-    ptt.northing = iCurrent / numCols;
-    //X
-    ptt.easting = iCurrent - (iCurrent / numCols * numCols);
+    //no path exists
+    if (!isSolved) return mazeList; //empty list
 
-    mazeList.clear();
-    mazeList.append(ptt);
+    Vec3 ptt;
 
-    for (int i = iFront; i >= 0; i--)
+    for (int iCurrent = iStop; iCurrent != -1; iCurrent = origin[iCurrent])
     {
-        if (Queue[i] == iCurrent)
-        {
-            iCurrent = Origin[i];
-            if (iCurrent == -1)     // maze is solved
-                return mazeList;
-            //add point
-            ptt.northing = iCurrent / numCols; //Y
-            ptt.easting = iCurrent - (iCurrent / numCols * numCols); //X
-            mazeList.append(ptt);
-        }
+        //add point
+        ptt.northing = iCurrent / numCols; //Y
+        ptt.easting = iCurrent - (iCurrent / numCols * numCols); //X
+        mazeList.append(ptt);
     }
 
-    //no path exists
-    mazeList.clear();
-    return mazeList; //empty list
-
+    return mazeList;
 }
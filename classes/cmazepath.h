@@ -4,21 +4,47 @@
 #include <QVector>
 #include "vec3.h"
 
+class CMazeGrid;
+
+//A* over the maze grid, 8 way moves with an octile heuristic and a
+//binary heap for the open list. The work buffers belong to the grid
+//and are only grown when the grid gets bigger. After a search only
+//the cells it touched are reset, so a short drive around does not pay
+//for the whole field.
 class CMazePath
 {
 private:
-    int *mazeGrid;
-    int numCols;
-    int numMax;
+    const CMazeGrid &mazeGrid;
 
     enum mazePathStatus {
-        Ready, Waiting, Processed
+        Ready, Open, Processed
+    };
+
+    struct HeapNode {
+        float f;
+        int index;
+
+        //std heap functions build a max heap, so reverse it
+        bool operator<(const HeapNode &other) const { return f > other.f; }
     };
 
+    QVector<float> gCost;
+    QVector<int> origin;
+    QVector<quint8> status;
+    QVector<int> touched;
+    QVector<HeapNode> heap;
+    int expanded = 0;
+
+    void reset();
+
 public:
-    CMazePath(int iRows, int iCols, int *_iMaze);
+    CMazePath(const CMazeGrid &_mazeGrid);
+
+    //path from stop back to start in grid cells, empty if there is none
     QVector<Vec3> search (int iFromY, int iFromX, int iToY, int iToX);
 
+    //cells taken off the open list by the last search
+    int expandedNodes() const { return expanded; }
 };
 
 #endif // CMAZEPATH_H
@@ -76,13 +76,14 @@ CNMEA::CNMEA(QObject *parent) : QObject(parent)
     USE_SETTINGS;
 
     fixFrom = SETTINGS_GPS_FIXFROMWHICH;
+    words = framer.fields();
     latStart = 0;
     lonStart = 0;
 }
 
 void CNMEA::updateNorthingEasting()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
     //#region convergence
     Vec2 xy = CNMEA::decDeg2UTM(latitude, longitude);
@@ -103,22 +104,22 @@ void CNMEA::updateNorthingEasting()
     fix.northing = (sin(-convergenceAngle) * east) + (cos(-convergenceAngle) * nort);
 
     //#region Antenna Offset
-    if (SETTINGS_VEHICLE_ANTENNAOFFSET != 0)
+    if (snapshot->vehicleAntennaOffset != 0)
     {
-        fix.easting = (cos(-this->lastHeading) * SETTINGS_VEHICLE_ANTENNAOFFSET) + fix.easting;
-        fix.northing = (sin(-this->lastHeading) * SETTINGS_VEHICLE_ANTENNAOFFSET) + fix.northing;
+        fix.easting = (cos(-this->lastHeading) * snapshot->vehicleAntennaOffset) + fix.easting;
+        fix.northing = (sin(-this->lastHeading) * snapshot->vehicleAntennaOffset) + fix.northing;
     }
     //#endregion
 
     //#region Roll
 
-    if ((SETTINGS_GPS_ISROLLFROMAUTOSTEER || SETTINGS_GPS_ISROLLFROMGPS) && !SETTINGS_GPS_ISROLLFROMOGI && this->roll != 9999)
+    if ((snapshot->gpsIsRollFromAutosteer || snapshot->gpsIsRollFromGPS) && !snapshot->gpsIsRollFromOGI && this->roll != 9999)
     {
-        double rollUsed = ((double)(this->roll - SETTINGS_GPS_IMUROLLZEROX16)) * 0.0625;
+        double rollUsed = ((double)(this->roll - snapshot->gpsIMURollZeroX16)) * 0.0625;
         emit setRollUsed(rollUsed);
 
         //change for roll to the right is positive times -1
-        double rollCorrectionDistance = sin(glm::toRadians((rollUsed))) * - SETTINGS_VEHICLE_ANTENNAHEIGHT;
+        double rollCorrectionDistance = sin(glm::toRadians((rollUsed))) * - snapshot->vehicleAntennaHeight;
         emit setRollCorrectionDistance(rollCorrectionDistance);
 
         // roll to left is positive  **** important!!
@@ -127,9 +128,9 @@ void CNMEA::updateNorthingEasting()
         fix.northing = (sin(-this->lastHeading) * rollCorrectionDistance) + fix.northing;
     }
     //used only for draft compensation
-    else if (SETTINGS_GPS_ISROLLFROMOGI)
+    else if (snapshot->gpsIsRollFromOGI)
     {
-        emit setRollUsed(((double)(this->roll - SETTINGS_GPS_IMUROLLZEROX16)) * 0.0625);
+        emit setRollUsed(((double)(this->roll - snapshot->gpsIMURollZeroX16)) * 0.0625);
     }
 
     //#endregion
@@ -137,69 +138,45 @@ void CNMEA::updateNorthingEasting()
 
 void CNMEA::parseNMEA(double lastHeading, double roll)
 {
-    USE_SETTINGS;
-    if (!rawBuffer.size()) return;
-
-    if(SETTINGS_GPS_LOGNMEA)
-            this->logNMEASentence.append(this->rawBuffer);
-
-    //find end of a sentence
-    int cr = rawBuffer.indexOf("\r\n");
-    if (cr == -1) return; // No end found, wait for more data
-
-    // Find start of next sentence
-    int dollar = rawBuffer.indexOf("$");
-    if (dollar == -1) return;
-
-    //if the $ isn't first, get rid of the tail of corrupt sentence
-    if (dollar >= cr) rawBuffer = rawBuffer.mid(dollar);
-
-    cr = rawBuffer.indexOf("\r\n");
-    if (cr == -1) return; // No end found, wait for more data
-
-    dollar = rawBuffer.indexOf("$");
-    if (dollar == -1) return;
-
-    //if the $ isn't first, get rid of the tail of corrupt sentence
-    if (dollar >= cr)
-        rawBuffer = rawBuffer.mid(dollar);
-
-    cr = rawBuffer.indexOf("\r\n");
-    dollar = rawBuffer.indexOf("$");
-    if (cr == -1 || dollar == -1)
-        return;
+    USE_SETTINGS_SNAPSHOT;
 
     this->lastHeading = lastHeading;
     this->roll = roll;
 
-    //now we have a complete sentence or more somewhere in the portData
-    while (true)
+    //frame every complete sentence waiting in the ring buffer. Bad
+    //checksums and partial sentences are skipped by the framer.
+    while (framer.next())
     {
-        //extract the next NMEA single sentence
-        nextNMEASentence = parse();
-        if (nextNMEASentence == "") return;
-
-        //parse them accordingly
-        words = nextNMEASentence.split(',');
-        if (words.size() < 9)
-            return;
-
-        if ((words[0] == "$GPGGA") || (words[0] == "$GNGGA")) parseGGA();
-        if ((words[0] == "$GPVTG") || (words[0] == "$GNVTG")) parseVTG();
-        if ((words[0] == "$GPRMC") || (words[0] == "$GNRMC")) parseRMC();
-        if ((words[0] == "$GPHDT") || (words[0] == "$GNHDT")) parseHDT();
-        if (words[0] == "$PAOGI") parseOGI();
-        if (words[0] == "$PTNL") parseAVR();
-        if (words[0] == "$GNTRA") parseTRA();
-
-        //pump the main loop in case UDP, Serial, or TCP data comes in.
-        QCoreApplication::processEvents();
+        words = framer.fields();
+
+        if(snapshot->gpsLogNMEA)
+        {
+            NMEAField raw = framer.rawSentence();
+            logNMEASentence.append(raw.data, raw.len);
+            logNMEASentence.append("\r\n");
+        }
+
+        switch (framer.sentenceId())
+        {
+        case NMEA_GGA: parseGGA(); break;
+        case NMEA_VTG: parseVTG(); break;
+        case NMEA_RMC: parseRMC(); break;
+        case NMEA_HDT: parseHDT(); break;
+        case NMEA_OGI: parseOGI(); break;
+        case NMEA_AVR: parseAVR(); break;
+        case NMEA_TRA: parseTRA(); break;
+        default: break;
+        }
+
+        //a new fix goes out right away, anything after it in the
+        //buffer waits for the next call
+        if (updatedGGA || updatedRMC || updatedOGI) break;
     }// while still data
 }
 
 void CNMEA::parseAVR()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
     if (! (words[1] == "") && words[1].size())
     {
@@ -232,7 +209,7 @@ void CNMEA::parseAVR()
         else
             nRoll = words[5].toDouble(); //always parsed using C locale regardless of language set
 
-        if (SETTINGS_GPS_ISROLLFROMGPS)
+        if (snapshot->gpsIsRollFromGPS)
         //input to the kalman filter
         {
             //added by Andreas Ortner
@@ -253,71 +230,6 @@ void CNMEA::parseAVR()
 
 }
 
-QByteArray CNMEA::parse() {
-    QByteArray sentence;
-    do
-    {
-        //double check for valid sentence
-        // Find start of next sentence
-        int start = rawBuffer.indexOf("$");
-        if (start == -1)
-            return "";
-
-        rawBuffer = rawBuffer.mid(start);
-
-        // Find end of sentence
-        int end = rawBuffer.indexOf("\r\n");
-        if (end == -1)
-            return "";
-
-        //the NMEA sentence to be parsed
-        sentence = rawBuffer.mid(0, end + 2);
-        //remove the processed sentence from the rawBuffer
-        rawBuffer = rawBuffer.mid(end + 2);
-    }
-
-    //if sentence has valid checksum, its all good
-    //TODO: what's with this while loop?
-    //ask Brian.
-    while (!validateChecksum(sentence));
-
-    // Remove trailing checksum and \r\n and return
-    sentence = sentence.mid(0, sentence.indexOf("*"));
-    return sentence;
-}
-
-bool CNMEA::validateChecksum(QByteArray sentence) {
-    int sum = 0;
-    const char *sentenceChars = sentence.data();
-    // All character xor:ed results in the trailing hex checksum
-    // The checksum calc starts after '$' and ends before '*'
-    int inx;
-    char tmp;
-    for (inx = 1; ; inx++)
-    {
-        if (inx >= sentence.size()) // No checksum found
-            return false;
-        tmp = sentenceChars[inx];
-        // Indicates end of data and start of checksum
-        if (tmp == '*') break;
-        sum ^= tmp;    // Build checksum
-    }
-
-    // Calculated checksum converted to a 2 digit hex string
-    QByteArray sumStr = QByteArray::number(sum, 16).toUpper();
-    if (sumStr.length() < 2)
-        sumStr.prepend('0');
-
-    //not needed because checksum is only 8 bit and will always
-    //be only 2 characters
-    //sumStr = QByteArray::number(sum, 16).mid(0,2);
-
-    // Compare to checksum in sentence
-    return (sumStr == sentence.mid(inx + 1, 2).toUpper());
-
-    //TODO: catch exceptions here like the C# code did?
-}
-
 void CNMEA::parseGGA() {
     //$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M ,  ,*47
     //   0     1      2      3    4      5 6  7  8   9    10 11  12 13  14
@@ -375,7 +287,7 @@ void CNMEA::parseGGA() {
 
 void CNMEA::parseOGI()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
     //PAOGI parsing of the sentence
     //make sure there aren't missing coords in sentence
     if (words[2].size() && words[3].size() &&
@@ -429,7 +341,7 @@ void CNMEA::parseOGI()
         //roll
         nRoll = words[13].toDouble();
 
-        if(SETTINGS_GPS_ISROLLFROMGPS)
+        if(snapshot->gpsIsRollFromGPS)
         {
             rollK = nRoll; //input to the kalman filter
             Pc = P + varProcess;
@@ -535,7 +447,7 @@ void CNMEA::parseRMC() {
 
         //Status
         if (words[2].size()) {
-            status = words[2];
+            status = words[2].toByteArray();
         } else {
             status = "z";
         }
@@ -581,7 +493,7 @@ void CNMEA::parseHDT()
 
 void CNMEA::parseTRA()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
     if (words[1].size())
     {
         headingHDT = words[2].toDouble();
@@ -592,7 +504,7 @@ void CNMEA::parseTRA()
         trasolution = words[5].toInt();
         if (trasolution != 4) nRoll = 0;
         // Console.WriteLine(trasolution);
-        if (SETTINGS_GPS_ISROLLFROMGPS)
+        if (snapshot->gpsIsRollFromGPS)
         //input to the kalman filter
         {
             ////added by Andreas Ortner
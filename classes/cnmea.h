@@ -8,6 +8,7 @@
 #include <QByteArray>
 #include <QBuffer>
 #include "vec2.h"
+#include "cnmeaframer.h"
 
 class Vec2;
 
@@ -24,8 +25,9 @@ class CNMEA : public QObject
 {
     Q_OBJECT
 private:
-    QList<QByteArray> words;
-    QByteArray nextNMEASentence = "";
+    //fields of the sentence being parsed, views into the framer
+    const NMEAField *words;
+    CNMEAFramer framer;
     int nmeaCntr = 0;
 
     double rollK, Pc, G, Xp, Zp, XeRoll;
@@ -50,7 +52,6 @@ public:
 
     bool isFirstFixPositionSet = false;
 
-    QByteArray rawBuffer = "";
     QString fixFrom;
 
     //UTM coordinates
@@ -80,8 +81,12 @@ public:
     explicit CNMEA(QObject *parent = 0);
     void updateNorthingEasting();
     void parseNMEA(double lastHeading, double roll);
+
+    //raw bytes from UDP, serial or the simulator
+    inline void appendRaw(const QByteArray &data) { framer.append(data); }
+    inline bool hasPendingSentence() const { return framer.hasPendingLine(); }
+
     void parseAVR();
-    QByteArray parse();
 
     void parseGGA();
     void parseOGI();
@@ -89,7 +94,6 @@ public:
     void parseHDT();
     void parseTRA();
     void parseRMC();
-    bool validateChecksum(QByteArray sentence);
 
     Vec2 decDeg2UTM(double latitude, double longitude);
     static double arcLengthOfMeridian(double phi);
@@ -0,0 +1,304 @@
+#include "cnmeaframer.h"
+#include <string.h>
+
+static const double pow10Table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+NMEAField NMEAField::mid(int pos, int n) const
+{
+    if (pos >= len || pos < 0) return NMEAField();
+    if (n < 0 || pos + n > len) n = len - pos;
+    return NMEAField(data + pos, n);
+}
+
+double NMEAField::toDouble() const
+{
+    //NMEA numbers are only ever [+-]ddd.ddd, so build the digits up as
+    //an integer and scale once at the end.
+    int i = 0;
+    bool negative = false;
+
+    if (i < len && (data[i] == '-' || data[i] == '+'))
+    {
+        negative = (data[i] == '-');
+        i++;
+    }
+
+    qint64 mantissa = 0;
+    int digits = 0, fraction = 0, ignored = 0;
+    bool isDot = false, isAny = false;
+
+    for (; i < len; i++)
+    {
+        char c = data[i];
+        if (c == '.')
+        {
+            if (isDot) return 0;
+            isDot = true;
+        }
+        else if (c >= '0' && c <= '9')
+        {
+            isAny = true;
+            if (digits < 18)
+            {
+                mantissa = mantissa * 10 + (c - '0');
+                if (mantissa) digits++;
+                if (isDot) fraction++;
+            }
+            else if (!isDot)
+            {
+                //past what int64 holds, only the magnitude matters
+                ignored++;
+            }
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    if (!isAny) return 0;
+
+    double value = (double)mantissa;
+    if (ignored) value *= pow10Table[ignored < 22 ? ignored : 22];
+    while (fraction > 22)
+    {
+        value /= pow10Table[22];
+        fraction -= 22;
+    }
+    if (fraction) value /= pow10Table[fraction];
+
+    return negative ? -value : value;
+}
+
+int NMEAField::toInt() const
+{
+    int i = 0;
+    bool negative = false;
+
+    if (i < len && (data[i] == '-' || data[i] == '+'))
+    {
+        negative = (data[i] == '-');
+        i++;
+    }
+    if (i == len) return 0;
+
+    int value = 0;
+    for (; i < len; i++)
+    {
+        if (data[i] < '0' || data[i] > '9') return 0;
+        value = value * 10 + (data[i] - '0');
+    }
+
+    return negative ? -value : value;
+}
+
+bool NMEAField::operator==(const char *str) const
+{
+    //lengths first, so a field longer than str never reads past its end
+    return (int)strlen(str) == len && memcmp(data, str, len) == 0;
+}
+
+CNMEAFramer::CNMEAFramer()
+{
+    clear();
+}
+
+void CNMEAFramer::clear()
+{
+    head = 0;
+    tail = 0;
+    pendingLines = 0;
+    dropped = 0;
+    state = WaitStart;
+    sum = 0;
+    received = 0;
+    len = 0;
+    rawLen = 0;
+    numFields = 0;
+    id = NMEA_UNKNOWN;
+    sentence[0] = '\0';
+    raw[0] = '\0';
+}
+
+void CNMEAFramer::append(const char *bytes, int count)
+{
+    //a burst bigger than the whole ring, only the newest part matters
+    if (count >= RINGSIZE)
+    {
+        dropped += count - (RINGSIZE - 1);
+        bytes += count - (RINGSIZE - 1);
+        count = RINGSIZE - 1;
+    }
+
+    int used = (head - tail) & (RINGSIZE - 1);
+    int room = RINGSIZE - 1 - used;
+
+    if (count > room)
+    {
+        //drop the oldest bytes and resync on the next '$'
+        int drop = count - room;
+        for (int i = 0; i < drop; i++)
+        {
+            //lines that are thrown out are not pending any more
+            if (ring[tail] == '\n' && pendingLines > 0) pendingLines--;
+            tail = (tail + 1) & (RINGSIZE - 1);
+        }
+        dropped += drop;
+        state = WaitStart;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        ring[head] = bytes[i];
+        head = (head + 1) & (RINGSIZE - 1);
+        if (bytes[i] == '\n') pendingLines++;
+    }
+}
+
+void CNMEAFramer::startSentence()
+{
+    len = 0;
+    rawLen = 0;
+    sum = 0;
+    numFields = 1;
+    fieldStart[0] = 0;
+
+    sentence[len++] = '$';
+    raw[rawLen++] = '$';
+    state = InBody;
+}
+
+void CNMEAFramer::finishSentence()
+{
+    sentence[len] = '\0';
+    raw[rawLen] = '\0';
+
+    for (int i = 0; i < numFields; i++)
+    {
+        int end = (i + 1 < numFields) ? fieldStart[i + 1] - 1 : len;
+        fieldList[i] = NMEAField(sentence + fieldStart[i], end - fieldStart[i]);
+    }
+
+    //missing fields read as empty, like an empty trailing field
+    for (int i = numFields; i < MAXFIELDS; i++)
+        fieldList[i] = NMEAField();
+
+    //work out the sentence type once, talker is GP or GN
+    const NMEAField &f0 = fieldList[0];
+    id = NMEA_UNKNOWN;
+
+    if (f0.len == 6 && f0.data[1] == 'G' && (f0.data[2] == 'P' || f0.data[2] == 'N'))
+    {
+        int key = (f0.data[3] << 16) | (f0.data[4] << 8) | f0.data[5];
+        switch (key)
+        {
+        case ('G' << 16) | ('G' << 8) | 'A': id = NMEA_GGA; break;
+        case ('V' << 16) | ('T' << 8) | 'G': id = NMEA_VTG; break;
+        case ('R' << 16) | ('M' << 8) | 'C': id = NMEA_RMC; break;
+        case ('H' << 16) | ('D' << 8) | 'T': id = NMEA_HDT; break;
+        case ('T' << 16) | ('R' << 8) | 'A':
+            if (f0.data[2] == 'N') id = NMEA_TRA;
+            break;
+        }
+    }
+    else if (f0 == "$PAOGI")
+    {
+        id = NMEA_OGI;
+    }
+    else if (f0 == "$PTNL" && fieldList[1] == "AVR")
+    {
+        id = NMEA_AVR;
+    }
+}
+
+bool CNMEAFramer::next()
+{
+    while (tail != head)
+    {
+        char c = ring[tail];
+        tail = (tail + 1) & (RINGSIZE - 1);
+
+        if (c == '\n' && pendingLines > 0) pendingLines--;
+
+        //a '$' always starts over, the last sentence was cut off
+        if (c == '$')
+        {
+            startSentence();
+            continue;
+        }
+
+        switch (state)
+        {
+        case WaitStart:
+            break;
+
+        case InBody:
+            if (c == '*')
+            {
+                raw[rawLen++] = c;
+                state = Checksum1;
+            }
+            else if (c == '\r' || c == '\n' || len >= MAXSENTENCE - 4)
+            {
+                //no checksum or too long, throw it away
+                state = WaitStart;
+            }
+            else
+            {
+                sum ^= (unsigned char)c;
+                raw[rawLen++] = c;
+
+                if (c == ',')
+                {
+                    sentence[len++] = '\0';
+                    if (numFields < MAXFIELDS) fieldStart[numFields++] = len;
+                    else state = WaitStart;
+                }
+                else
+                {
+                    sentence[len++] = c;
+                }
+            }
+            break;
+
+        case Checksum1:
+            if (hexValue(c) < 0)
+            {
+                state = WaitStart;
+                break;
+            }
+            received = (unsigned char)(hexValue(c) << 4);
+            raw[rawLen++] = c;
+            state = Checksum2;
+            break;
+
+        case Checksum2:
+            state = WaitStart;
+            if (hexValue(c) < 0) break;
+
+            received |= (unsigned char)hexValue(c);
+            raw[rawLen++] = c;
+
+            //good sentence, don't need to wait for the \r\n
+            if (received == sum)
+            {
+                finishSentence();
+                return true;
+            }
+            break;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,108 @@
+#ifndef CNMEAFRAMER_H
+#define CNMEAFRAMER_H
+
+#include <QByteArray>
+
+//which parser a framed sentence goes to, worked out once per sentence
+enum NMEASentenceId {
+    NMEA_UNKNOWN = 0,
+    NMEA_GGA,
+    NMEA_VTG,
+    NMEA_RMC,
+    NMEA_HDT,
+    NMEA_OGI,
+    NMEA_AVR,
+    NMEA_TRA
+};
+
+//A view of one comma separated field inside the framer's sentence
+//buffer. Nothing is copied or allocated; the view is valid until the
+//next sentence is framed. Has the bits of the QByteArray interface the
+//sentence parsers use.
+class NMEAField
+{
+public:
+    const char *data;
+    int len;
+
+    NMEAField() : data(""), len(0) {}
+    NMEAField(const char *_data, int _len) : data(_data), len(_len) {}
+
+    inline int size() const { return len; }
+    inline bool isEmpty() const { return len == 0; }
+
+    NMEAField mid(int pos, int n = -1) const;
+
+    //locale independent, like QByteArray, 0 if not a number
+    double toDouble() const;
+    int toInt() const;
+
+    bool operator==(const char *str) const;
+    inline bool operator!=(const char *str) const { return !(*this == str); }
+
+    inline QByteArray toByteArray() const { return QByteArray(data, len); }
+};
+
+//Fixed size ring buffer for incoming GPS bytes plus an incremental
+//framer. Bytes are scanned once: the checksum is xor'ed and the fields
+//are split as they go by, so framing a sentence never rescans or
+//reallocates the backlog. If a burst overruns the ring the oldest
+//bytes are dropped and the framer resyncs on the next '$'.
+class CNMEAFramer
+{
+public:
+    static const int RINGSIZE = 16384; //power of two
+    static const int MAXSENTENCE = 256;
+    static const int MAXFIELDS = 32;
+
+    CNMEAFramer();
+
+    void append(const char *bytes, int count);
+    inline void append(const QByteArray &bytes) { append(bytes.constData(), bytes.size()); }
+
+    //true if at least one line ending is waiting to be framed
+    inline bool hasPendingLine() const { return pendingLines > 0; }
+
+    //frame the next sentence with a good checksum, false if none left
+    bool next();
+
+    //results of the last next()
+    inline NMEASentenceId sentenceId() const { return id; }
+    inline int fieldCount() const { return numFields; }
+    inline const NMEAField *fields() const { return fieldList; }
+
+    //the sentence as received, from '$' through the checksum
+    inline NMEAField rawSentence() const { return NMEAField(raw, rawLen); }
+
+    //bytes thrown away because the ring was full
+    inline qint64 droppedBytes() const { return dropped; }
+
+    void clear();
+
+private:
+    enum FrameState { WaitStart, InBody, Checksum1, Checksum2 };
+
+    char ring[RINGSIZE];
+    int head, tail;
+    int pendingLines;
+    qint64 dropped;
+
+    FrameState state;
+    unsigned char sum, received;
+
+    //fields with the commas swapped for '\0'
+    char sentence[MAXSENTENCE];
+    int len;
+    char raw[MAXSENTENCE];
+    int rawLen;
+
+    int fieldStart[MAXFIELDS];
+    int numFields;
+    NMEAField fieldList[MAXFIELDS];
+    NMEASentenceId id;
+
+    void startSentence();
+    void finishSentence();
+};
+
+#endif // CNMEAFRAMER_H
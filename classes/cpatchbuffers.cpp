@@ -0,0 +1,255 @@
+#include "cpatchbuffers.h"
+#include <QOpenGLFunctions>
+#include <QtMath>
+#include "glutils.h"
+
+//a live patch is 1 color + 2 points per step, sealed at 36 steps, so
+//this covers nearly all of them in a single allocation.
+static const int PATCHRESERVE = 80;
+
+//how often to look for buffers of deleted patches
+static const int SWEEPFRAMES = 60;
+
+//sealed patches are batched into squares of this many meters
+static const double TILESIZE = 256.0;
+
+//write whatever is past uploaded, growing the buffer if it is too small
+static void uploadTail(QOpenGLBuffer &buffer, int &uploaded, int &capacity,
+                       const QVector3D *data, int count, int reserve)
+{
+    if (count <= uploaded) return;
+
+    buffer.bind();
+
+    if (count > capacity)
+    {
+        //grow and upload the whole thing
+        capacity = qMax(count, reserve);
+        if (count >= reserve) capacity = count * 2;
+
+        buffer.allocate(capacity * (int)sizeof(QVector3D));
+        buffer.write(0, data, count * (int)sizeof(QVector3D));
+    }
+    else
+    {
+        //just the points added since the last frame
+        buffer.write(uploaded * (int)sizeof(QVector3D),
+                     data + uploaded,
+                     (count - uploaded) * (int)sizeof(QVector3D));
+    }
+
+    buffer.release();
+    uploaded = count;
+}
+
+CPatchBuffers::CPatchBuffers()
+{
+
+}
+
+CPatchBuffers::~CPatchBuffers()
+{
+    //GL buffers must be destroyed with a valid context in
+    //destroyGLBuffers(), just free the bookkeeping here.
+    qDeleteAll(buffers);
+    buffers.clear();
+    qDeleteAll(tiles);
+    tiles.clear();
+    tileLookup.clear();
+}
+
+void CPatchBuffers::destroyBuffer(PatchBuffer *pb)
+{
+    if (pb->buffer.isCreated())
+        pb->buffer.destroy();
+    delete pb;
+}
+
+void CPatchBuffers::drawPatch(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, QColor color,
+                              const QSharedPointer<TriangleList> &triList,
+                              const TriangleList &points)
+{
+    //first vertice is color, so we skip it
+    int count = points.size() - 1;
+    if (count < 1) return;
+
+    PatchBuffer *pb = buffers.value(triList.data(), 0);
+
+    //address was reused by a new patch
+    if (pb && pb->list.toStrongRef() != triList)
+    {
+        destroyBuffer(pb);
+        pb = 0;
+    }
+
+    if (!pb)
+    {
+        pb = new PatchBuffer;
+        pb->list = triList;
+        pb->uploaded = 0;
+        pb->capacity = 0;
+        pb->buffer.create();
+        glFrameStats.buffersCreated++;
+        buffers[triList.data()] = pb;
+    }
+
+    uploadTail(pb->buffer, pb->uploaded, pb->capacity,
+               points.constData() + 1, count, PATCHRESERVE);
+
+    glDrawArraysColor(gl, mvp, GL_TRIANGLE_STRIP, color,
+                      pb->buffer, GL_FLOAT, count);
+}
+
+void CPatchBuffers::destroyTiles()
+{
+    foreach (Tile *tile, tiles)
+    {
+        for (int l = 0; l < CPatchIndex::LODLEVELS; l++)
+            if (tile->buffer[l].isCreated()) tile->buffer[l].destroy();
+        delete tile;
+    }
+    tiles.clear();
+    tileLookup.clear();
+}
+
+void CPatchBuffers::takeSealed(const CPatchIndex &index)
+{
+    if (index.generation() != sealedGeneration)
+    {
+        //field was closed or reloaded
+        destroyTiles();
+        pending.clear();
+        sealedGeneration = index.generation();
+        sealedTaken = 0;
+    }
+
+    const QVector<CPatchIndex::Patch> &sealed = index.sealedPatches();
+    for (; sealedTaken < sealed.size(); sealedTaken++)
+    {
+        pending.append(sealed[sealedTaken]);
+
+        //it is drawn from its tile from now on, so the buffer it had
+        //while it was live goes, even though the section still has it
+        PatchBuffer *pb = buffers.take(sealed[sealedTaken].lod[0].data());
+        if (pb) destroyBuffer(pb);
+    }
+}
+
+void CPatchBuffers::addToTile(const CPatchIndex::Patch &patch)
+{
+    //tile is picked by the center of the patch, the tile box grows to
+    //take in all of every patch so culling stays right
+    qint32 col = (qint32)floor((patch.box.minX + patch.box.maxX) * 0.5 / TILESIZE);
+    qint32 row = (qint32)floor((patch.box.minY + patch.box.maxY) * 0.5 / TILESIZE);
+    quint64 key = ((quint64)(quint32)row << 32) | (quint32)col;
+
+    Tile *tile = tileLookup.value(key, 0);
+    if (!tile)
+    {
+        tile = new Tile;
+        tile->box = patch.box;
+        for (int l = 0; l < CPatchIndex::LODLEVELS; l++)
+        {
+            tile->uploaded[l] = 0;
+            tile->capacity[l] = 0;
+        }
+        tiles.append(tile);
+        tileLookup[key] = tile;
+    }
+    else
+    {
+        tile->box.minX = qMin(tile->box.minX, patch.box.minX);
+        tile->box.minY = qMin(tile->box.minY, patch.box.minY);
+        tile->box.maxX = qMax(tile->box.maxX, patch.box.maxX);
+        tile->box.maxY = qMax(tile->box.maxY, patch.box.maxY);
+    }
+
+    for (int l = 0; l < CPatchIndex::LODLEVELS; l++)
+    {
+        const TriangleList &src = *patch.lod[l];
+        TriangleList &strip = tile->strip[l];
+        if (src.size() < 2) continue;
+
+        //repeat the last point and the next first point, so the
+        //triangles in between have no area. A third copy keeps the
+        //next strip starting on an even vertex.
+        if (strip.size() > 0)
+        {
+            strip.append(strip.last());
+            strip.append(src[1]);
+            if (strip.size() & 1) strip.append(src[1]);
+        }
+
+        //first vertex is color, skip it
+        strip.append(src.mid(1));
+    }
+}
+
+void CPatchBuffers::drawSealed(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, QColor color,
+                               const double *frustum, int lod)
+{
+    //sealed strips are never changed, so this is safe outside the lock
+    foreach (const CPatchIndex::Patch &patch, pending) addToTile(patch);
+    pending.clear();
+
+    if (lod < 0) lod = 0;
+    if (lod >= CPatchIndex::LODLEVELS) lod = CPatchIndex::LODLEVELS - 1;
+
+    foreach (Tile *tile, tiles)
+    {
+        if (CPatchIndex::classify(frustum, tile->box) < 0) continue;
+
+        int count = tile->strip[lod].size();
+        if (count < 3) continue;
+
+        if (!tile->buffer[lod].isCreated())
+        {
+            tile->buffer[lod].create();
+            glFrameStats.buffersCreated++;
+        }
+        uploadTail(tile->buffer[lod], tile->uploaded[lod], tile->capacity[lod],
+                   tile->strip[lod].constData(), count, PATCHRESERVE);
+
+        glDrawArraysColor(gl, mvp, GL_TRIANGLE_STRIP, color,
+                          tile->buffer[lod], GL_FLOAT, count);
+    }
+}
+
+void CPatchBuffers::endFrame()
+{
+    if (++frameCounter < SWEEPFRAMES) return;
+    frameCounter = 0;
+
+    //patches removed by turnMappingOff or closing the job
+    QHash<const TriangleList *, PatchBuffer *>::iterator i = buffers.begin();
+    while (i != buffers.end())
+    {
+        if (i.value()->list.isNull())
+        {
+            destroyBuffer(i.value());
+            i = buffers.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void CPatchBuffers::destroyGLBuffers()
+{
+    foreach (PatchBuffer *pb, buffers)
+        destroyBuffer(pb);
+    buffers.clear();
+
+    //the strips stay, so the tiles are uploaded again on the next frame
+    foreach (Tile *tile, tiles)
+    {
+        for (int l = 0; l < CPatchIndex::LODLEVELS; l++)
+        {
+            if (tile->buffer[l].isCreated()) tile->buffer[l].destroy();
+            tile->uploaded[l] = 0;
+            tile->capacity[l] = 0;
+        }
+    }
+}
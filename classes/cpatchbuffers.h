@@ -0,0 +1,84 @@
+#ifndef CPATCHBUFFERS_H
+#define CPATCHBUFFERS_H
+
+#include <QHash>
+#include <QWeakPointer>
+#include <QSharedPointer>
+#include <QOpenGLBuffer>
+#include <QMatrix4x4>
+#include <QColor>
+#include "csection.h"
+#include "cpatchindex.h"
+
+class QOpenGLFunctions;
+
+//Keeps one GL vertex buffer per section patch so patches are uploaded
+//once instead of every frame. Patches only ever grow at the end (the
+//live one, until it is sealed by turnMappingOff or the 36 triangle
+//rollover), so only the new tail of a patch is written.
+//
+//Sealed patches are not drawn one by one. They are stitched together
+//with degenerate triangles into one strip per field tile and level of
+//detail, so a frame is one draw call per tile on screen no matter how
+//many times the sections were switched on and off. This takes the place
+//of culling patch by patch through the CPatchIndex quadtree, a tile is
+//either drawn or culled as a whole.
+class CPatchBuffers
+{
+private:
+    struct PatchBuffer {
+        QWeakPointer<TriangleList> list;
+        QOpenGLBuffer buffer;
+        int uploaded;
+        int capacity;
+    };
+
+    struct Tile {
+        CPatchIndex::Box box;
+        TriangleList strip[CPatchIndex::LODLEVELS];
+        QOpenGLBuffer buffer[CPatchIndex::LODLEVELS];
+        int uploaded[CPatchIndex::LODLEVELS];
+        int capacity[CPatchIndex::LODLEVELS];
+    };
+
+    QHash<const TriangleList *, PatchBuffer *> buffers;
+    int frameCounter = 0;
+
+    QVector<Tile *> tiles;
+    QHash<quint64, Tile *> tileLookup;
+    QVector<CPatchIndex::Patch> pending;
+    int sealedGeneration = -1;
+    int sealedTaken = 0;
+
+    void destroyBuffer(PatchBuffer *pb);
+    void destroyTiles();
+    void addToTile(const CPatchIndex::Patch &patch);
+
+public:
+    CPatchBuffers();
+    ~CPatchBuffers();
+
+    //draw the patch as a triangle strip, uploading whatever is new.
+    //triList only identifies the patch, the points come from a copy
+    //taken under the fix lock so the list can keep growing meanwhile
+    void drawPatch(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, QColor color,
+                   const QSharedPointer<TriangleList> &triList,
+                   const TriangleList &points);
+
+    //copy out the patches sealed since the last call, with the fix
+    //lock held, and drop the buffers they had while live. Starts over
+    //if the index was cleared.
+    void takeSealed(const CPatchIndex &index);
+
+    //draw every tile in the frustum at level of detail lod
+    void drawSealed(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, QColor color,
+                    const double *frustum, int lod);
+
+    //call once per frame, drops buffers of patches that no longer exist
+    void endFrame();
+
+    //assume valid OpenGL context
+    void destroyGLBuffers();
+};
+
+#endif // CPATCHBUFFERS_H
@@ -0,0 +1,548 @@
+#include "cpatchfile.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTextStream>
+#include <QStringList>
+#include <QtEndian>
+#include <QDebug>
+#include <string.h>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//formgps_saveopen.cpp
+QString caseInsensitiveFilename(QString directory, QString filename);
+
+static const quint32 FILEMAGIC = 0x50474F41;  //"AOGP"
+static const quint32 CHUNKMAGIC = 0x4B4E4843; //"CHNK"
+static const int FILEHEADERSIZE = 16;
+static const int CHUNKHEADERSIZE = 32;
+
+static inline void putU32(QByteArray &out, quint32 value)
+{
+    uchar buf[4];
+    qToLittleEndian(value, buf);
+    out.append((const char *)buf, 4);
+}
+
+static inline void putU64(QByteArray &out, quint64 value)
+{
+    uchar buf[8];
+    qToLittleEndian(value, buf);
+    out.append((const char *)buf, 8);
+}
+
+static inline void putNumber(QByteArray &out, float value)
+{
+    quint32 bits;
+    memcpy(&bits, &value, 4);
+    putU32(out, bits);
+}
+
+static inline void putNumber(QByteArray &out, double value)
+{
+    quint64 bits;
+    uchar buf[8];
+    memcpy(&bits, &value, 8);
+    qToLittleEndian(bits, buf);
+    out.append((const char *)buf, 8);
+}
+
+static inline quint32 getU32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+static inline quint64 getU64(const uchar *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+static inline float getFloat(const uchar *p)
+{
+    quint32 bits = qFromLittleEndian<quint32>(p);
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+static inline double getDouble(const uchar *p)
+{
+    quint64 bits = qFromLittleEndian<quint64>(p);
+    double value;
+    memcpy(&value, &bits, 8);
+    return value;
+}
+
+static QByteArray fileHeader(quint32 kind, quint32 numberSize)
+{
+    QByteArray header;
+    putU32(header, FILEMAGIC);
+    putU32(header, CPatchFile::VERSION);
+    putU32(header, kind);
+    putU32(header, numberSize);
+    return header;
+}
+
+//size and modified time of the text copy, as kept in each chunk
+struct TextStamp
+{
+    quint64 size = 0;
+    qint64 modified = 0;
+};
+
+static TextStamp textStamp(const QString &textFilename)
+{
+    TextStamp stamp;
+    QFileInfo text(textFilename);
+    if (text.exists())
+    {
+        stamp.size = text.size();
+        stamp.modified = text.lastModified().toMSecsSinceEpoch();
+    }
+    return stamp;
+}
+
+//List is a patch or contour strip, N is the type the numbers are
+//stored as and get pulls x, y and z out of one point
+template <class List, class N, class Get>
+static QByteArray buildChunk(const QVector<QSharedPointer<List>> &lists,
+                             const TextStamp &stamp, Get get)
+{
+    quint32 patchCount = 0, numberCount = 0;
+
+    QByteArray payload;
+    foreach (const QSharedPointer<List> &list, lists)
+    {
+        if (list.isNull()) continue;
+
+        int count = list->size();
+        putU32(payload, count);
+        for (int i = 0; i < count; i++)
+        {
+            N x, y, z;
+            get((*list)[i], x, y, z);
+            putNumber(payload, x);
+            putNumber(payload, y);
+            putNumber(payload, z);
+        }
+        patchCount++;
+        numberCount += count * 3;
+    }
+
+    QByteArray chunk;
+    chunk.reserve(CHUNKHEADERSIZE + payload.size());
+    putU32(chunk, CHUNKMAGIC);
+    putU32(chunk, patchCount);
+    putU32(chunk, numberCount);
+    putU32(chunk, payload.size());
+    putU64(chunk, stamp.size);
+    putU64(chunk, (quint64)stamp.modified);
+    chunk.append(payload);
+    return chunk;
+}
+
+static bool writeChunk(const QString &filename, quint32 kind, quint32 numberSize,
+                       const QByteArray &chunk, bool isTruncate, bool isSync)
+{
+    QFile file(filename);
+    if (!file.open(isTruncate ? (QIODevice::WriteOnly | QIODevice::Truncate)
+                              : QIODevice::Append))
+    {
+        qWarning() << "Couldn't open " << filename << "for writing!";
+        return false;
+    }
+
+    //header goes in with the first chunk, in one write so a half
+    //written file is never mistaken for a good one
+    QByteArray out;
+    if (file.size() == 0) out = fileHeader(kind, numberSize);
+    out.append(chunk);
+
+    bool isOk = (file.write(out) == out.size());
+    if (isSync) CPatchFile::syncFile(file);
+    file.close();
+    return isOk;
+}
+
+//map the file and check the header, data/size cover the whole file
+static const uchar *mapFile(QFile &file, quint32 kind, quint32 numberSize, qint64 &size)
+{
+    if (!file.open(QIODevice::ReadOnly)) return 0;
+
+    size = file.size();
+    if (size < FILEHEADERSIZE) return 0;
+
+    const uchar *data = file.map(0, size);
+    if (!data) return 0;
+
+    if (getU32(data) != FILEMAGIC || getU32(data + 4) != CPatchFile::VERSION ||
+        getU32(data + 8) != kind || getU32(data + 12) != numberSize)
+    {
+        qWarning() << "Not a binary patch file this version can read: " << file.fileName();
+        return 0;
+    }
+
+    return data;
+}
+
+//walk the chunks, calling add for every patch with its vertex count and
+//numbers. Stops at the first chunk that is cut short. Returns the text
+//stamp of the last whole chunk.
+template <class Add>
+static TextStamp readChunks(const uchar *data, qint64 size, int numberSize, Add add)
+{
+    TextStamp stamp;
+    qint64 pos = FILEHEADERSIZE;
+
+    while (pos + CHUNKHEADERSIZE <= size)
+    {
+        const uchar *chunk = data + pos;
+        if (getU32(chunk) != CHUNKMAGIC) break;
+
+        quint32 patchCount = getU32(chunk + 4);
+        quint32 payloadSize = getU32(chunk + 12);
+        if (pos + CHUNKHEADERSIZE + (qint64)payloadSize > size) break;
+
+        const uchar *p = chunk + CHUNKHEADERSIZE;
+        const uchar *end = p + payloadSize;
+
+        for (quint32 n = 0; n < patchCount; n++)
+        {
+            if (p + 4 > end) break;
+            quint32 count = getU32(p);
+            p += 4;
+
+            qint64 bytes = (qint64)count * 3 * numberSize;
+            if (bytes > end - p) break;
+
+            add(count, p);
+            p += bytes;
+        }
+
+        stamp.size = getU64(chunk + 16);
+        stamp.modified = (qint64)getU64(chunk + 24);
+        pos += CHUNKHEADERSIZE + payloadSize;
+    }
+
+    return stamp;
+}
+
+static inline void sectionPoint(const QVector3D &v, float &x, float &y, float &z)
+{
+    x = v.x();
+    y = v.y();
+    z = v.z();
+}
+
+static inline void contourPoint(const Vec3 &v, double &x, double &y, double &z)
+{
+    x = v.easting;
+    y = v.northing;
+    z = v.heading;
+}
+
+bool CPatchFile::appendSections(const QString &filename, const QString &textFilename,
+                                const QVector<QSharedPointer<TriangleList>> &patches,
+                                bool isSync)
+{
+    QByteArray chunk = buildChunk<TriangleList, float>(patches, textStamp(textFilename), sectionPoint);
+    return writeChunk(filename, Sections, 4, chunk, false, isSync);
+}
+
+bool CPatchFile::writeSections(const QString &filename, const QString &textFilename,
+                               const QVector<QSharedPointer<TriangleList>> &patches)
+{
+    QByteArray chunk = buildChunk<TriangleList, float>(patches, textStamp(textFilename), sectionPoint);
+    return writeChunk(filename, Sections, 4, chunk, true, false);
+}
+
+bool CPatchFile::appendContour(const QString &filename, const QString &textFilename,
+                               const QVector<QSharedPointer<QVector<Vec3>>> &strips,
+                               bool isSync)
+{
+    QByteArray chunk = buildChunk<QVector<Vec3>, double>(strips, textStamp(textFilename), contourPoint);
+    return writeChunk(filename, Contour, 8, chunk, false, isSync);
+}
+
+bool CPatchFile::writeContour(const QString &filename, const QString &textFilename,
+                              const QVector<QSharedPointer<QVector<Vec3>>> &strips)
+{
+    QByteArray chunk = buildChunk<QVector<Vec3>, double>(strips, textStamp(textFilename), contourPoint);
+    return writeChunk(filename, Contour, 8, chunk, true, false);
+}
+
+bool CPatchFile::readSections(const QString &filename,
+                              QVector<QSharedPointer<TriangleList>> &patches)
+{
+    QFile file(filename);
+    qint64 size;
+    const uchar *data = mapFile(file, Sections, 4, size);
+    if (!data) return false;
+
+    readChunks(data, size, 4, [&](quint32 count, const uchar *p) {
+        QSharedPointer<TriangleList> patch(new TriangleList(count));
+        QVector3D *v = patch->data();
+        for (quint32 i = 0; i < count; i++, p += 12)
+            v[i] = QVector3D(getFloat(p), getFloat(p + 4), getFloat(p + 8));
+        patches.append(patch);
+    });
+
+    return true;
+}
+
+bool CPatchFile::readContour(const QString &filename,
+                             QVector<QSharedPointer<QVector<Vec3>>> &strips)
+{
+    QFile file(filename);
+    qint64 size;
+    const uchar *data = mapFile(file, Contour, 8, size);
+    if (!data) return false;
+
+    readChunks(data, size, 8, [&](quint32 count, const uchar *p) {
+        QSharedPointer<QVector<Vec3>> strip(new QVector<Vec3>(count));
+        Vec3 *v = strip->data();
+        for (quint32 i = 0; i < count; i++, p += 24)
+            v[i] = Vec3(getDouble(p), getDouble(p + 8), getDouble(p + 16));
+        strips.append(strip);
+    });
+
+    return true;
+}
+
+bool CPatchFile::isBinaryInSync(const QString &textFilename, const QString &binFilename)
+{
+    QFileInfo text(textFilename);
+    QFileInfo bin(binFilename);
+
+    if (!bin.exists()) return !text.exists() || text.size() == 0;
+    if (!text.exists()) return true;
+
+    //only the headers are read, not the points
+    QFile file(binFilename);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    qint64 size = file.size();
+    if (size < FILEHEADERSIZE) return false;
+
+    const uchar *data = file.map(0, size);
+    if (!data) return false;
+
+    if (getU32(data) != FILEMAGIC || getU32(data + 4) != VERSION) return false;
+
+    int numberSize = getU32(data + 12);
+    if (numberSize != 4 && numberSize != 8) return false;
+
+    TextStamp stamp = readChunks(data, size, numberSize, [](quint32, const uchar *) {});
+
+    return stamp.size == (quint64)text.size() &&
+           stamp.modified == text.lastModified().toMSecsSinceEpoch();
+}
+
+void CPatchFile::writeSectionsText(QTextStream &writer, const QVector<QSharedPointer<TriangleList>> &patches)
+{
+    writer.setRealNumberNotation(QTextStream::FixedNotation);
+    writer.setRealNumberPrecision(3);
+
+    foreach (const QSharedPointer<TriangleList> &triList, patches)
+    {
+        int count2 = triList->count();
+        writer << count2 << Qt::endl;
+
+        for (int i=0; i < count2; i++)
+        {
+            writer << (*triList)[i].x() << "," << (*triList)[i].y()
+                   << "," << (*triList)[i].z() << Qt::endl;
+        }
+    }
+}
+
+void CPatchFile::readSectionsText(QTextStream &reader, QVector<QSharedPointer<TriangleList>> &patches)
+{
+    QString line;
+    QVector3D vecFix;
+
+    while (!reader.atEnd())
+    {
+        line = reader.readLine();
+
+        //was old version prior to v4, has a $Sections header
+        if (line.contains("ect")) break;
+
+        int verts = line.toInt();
+
+        QSharedPointer<TriangleList> triList(new TriangleList);
+        triList->reserve(verts);
+
+        for (int v = 0; v < verts; v++)
+        {
+            line = reader.readLine();
+            QStringList words = line.split(',');
+            if (words.count() < 3) break;
+            vecFix.setX(words[0].toDouble());
+            vecFix.setY(words[1].toDouble());
+            vecFix.setZ(words[2].toDouble());
+            triList->append(vecFix);
+        }
+        patches.append(triList);
+    }
+}
+
+void CPatchFile::writeContourText(QTextStream &writer, const QVector<QSharedPointer<QVector<Vec3>>> &strips)
+{
+    writer.setRealNumberNotation(QTextStream::FixedNotation);
+    writer.setRealNumberPrecision(3);
+
+    foreach (const QSharedPointer<QVector<Vec3>> &strip, strips)
+    {
+        int count2 = strip->count();
+        writer << count2 << Qt::endl;
+
+        for (int i = 0; i < count2; i++)
+        {
+            writer << (*strip)[i].easting << ","
+                   << (*strip)[i].northing << ","
+                   << (*strip)[i].heading << Qt::endl;
+        }
+    }
+}
+
+void CPatchFile::readContourText(QTextStream &reader, QVector<QSharedPointer<QVector<Vec3>>> &strips)
+{
+    QString line;
+
+    //read header
+    line = reader.readLine();
+
+    while (!reader.atEnd())
+    {
+        //read how many vertices in the following patch
+        line = reader.readLine();
+        int verts = line.toInt();
+
+        Vec3 vecFix(0, 0, 0);
+
+        QSharedPointer<QVector<Vec3>> strip(new QVector<Vec3>);
+        strip->reserve(verts);
+
+        for (int v = 0; v < verts; v++)
+        {
+            line = reader.readLine();
+            QStringList words = line.split(',');
+            if (words.count() < 3) break;
+            vecFix.easting = words[0].toDouble();
+            vecFix.northing = words[1].toDouble();
+            vecFix.heading = words[2].toDouble();
+            strip->append(vecFix);
+        }
+        strips.append(strip);
+    }
+}
+
+void CPatchFile::syncFile(QFile &file)
+{
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+}
+
+bool CPatchFile::saveSections(const QString &directoryName,
+                              const QVector<QSharedPointer<TriangleList>> &patches,
+                              bool isSync)
+{
+    if (patches.count() == 0) return true;
+
+    QString textFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Sections.txt");
+    QString binFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Sections.bin");
+    bool isBinInSync = isBinaryInSync(textFilename, binFilename);
+
+    QFile sectionFile(textFilename);
+    if (!sectionFile.open(QIODevice::Append))
+    {
+        qWarning() << "Couldn't open " << textFilename << "for appending!";
+        return false;
+    }
+
+    //for each patch, write out the list of triangles to the file
+    QTextStream writer(&sectionFile);
+    writeSectionsText(writer, patches);
+    writer.flush();
+    if (isSync) syncFile(sectionFile);
+    sectionFile.close();
+
+    //the binary copy only gets the new chunk if it already had the rest,
+    //otherwise it is thrown away and remade from the text next open
+    if (isBinInSync) return appendSections(binFilename, textFilename, patches, isSync);
+
+    QFile::remove(binFilename);
+    return true;
+}
+
+bool CPatchFile::saveContour(const QString &directoryName,
+                             const QVector<QSharedPointer<QVector<Vec3>>> &strips,
+                             bool isSync)
+{
+    if (strips.count() == 0) return true;
+
+    QString textFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Contour.txt");
+    QString binFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Contour.bin");
+    bool isBinInSync = isBinaryInSync(textFilename, binFilename);
+
+    QFile contourFile(textFilename);
+    if (!contourFile.open(QIODevice::Append))
+    {
+        qWarning() << "Couldn't open " << textFilename << "for appending!";
+        return false;
+    }
+
+    QTextStream writer(&contourFile);
+    if (contourFile.size() == 0) writer << "$Contour" << Qt::endl;
+    writeContourText(writer, strips);
+    writer.flush();
+    if (isSync) syncFile(contourFile);
+    contourFile.close();
+
+    if (isBinInSync) return appendContour(binFilename, textFilename, strips, isSync);
+
+    QFile::remove(binFilename);
+    return true;
+}
+
+static bool writeBytes(const QString &directoryName, const QString &name,
+                       const QByteArray &bytes, QIODevice::OpenMode mode, bool isSync)
+{
+    QString filename = directoryName + "/" + caseInsensitiveFilename(directoryName, name);
+
+    QFile logFile(filename);
+    if (!logFile.open(mode))
+    {
+        qWarning() << "Couldn't open " << filename << "for writing!";
+        return false;
+    }
+
+    bool isOk = (logFile.write(bytes) == bytes.size());
+    if (isSync) CPatchFile::syncFile(logFile);
+    logFile.close();
+    return isOk;
+}
+
+bool CPatchFile::appendLog(const QString &directoryName, const QString &name,
+                           const QByteArray &bytes, bool isSync)
+{
+    if (bytes.size() == 0) return true;
+    return writeBytes(directoryName, name, bytes, QIODevice::Append, isSync);
+}
+
+bool CPatchFile::writeLog(const QString &directoryName, const QString &name,
+                          const QByteArray &bytes, bool isSync)
+{
+    if (bytes.size() == 0) return true;
+    return writeBytes(directoryName, name, bytes, QIODevice::WriteOnly | QIODevice::Truncate, isSync);
+}
@@ -0,0 +1,95 @@
+#ifndef CPATCHFILE_H
+#define CPATCHFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QVector>
+#include <QSharedPointer>
+#include "csection.h"
+#include "vec3.h"
+
+class QTextStream;
+
+//Binary Sections.bin and Contour.bin, kept next to the Sections.txt and
+//Contour.txt AgOpenGPS reads. Every save appends one chunk:
+//
+//  file header:  "AOGP" magic, version, kind, bytes per number
+//  chunk header: "CHNK" magic, patch count, number count, payload bytes,
+//                size and modified time (ms) of the text file once this
+//                chunk's patches were in it, 64 bit each
+//  per patch:    vertex count, then x,y,z (easting,northing,heading)
+//
+//Everything is little endian. Sections are floats, which is exactly what
+//a QVector3D holds, contour points are doubles like Vec3. A chunk cut
+//short by a crash is dropped and everything before it is kept.
+//
+//The text file stamp in the last chunk is what tells whether anything
+//else wrote the text since. File times alone can't, FAT only keeps them
+//to 2 seconds.
+class CPatchFile
+{
+public:
+    enum Kind { Sections = 1, Contour = 2 };
+
+    static const quint32 VERSION = 2;
+
+    //append one chunk, writing the file header first if the file is new.
+    //textFilename is the text copy, already holding the same patches.
+    static bool appendSections(const QString &filename, const QString &textFilename,
+                               const QVector<QSharedPointer<TriangleList>> &patches,
+                               bool isSync = false);
+    static bool appendContour(const QString &filename, const QString &textFilename,
+                              const QVector<QSharedPointer<QVector<Vec3>>> &strips,
+                              bool isSync = false);
+
+    //false if the file is missing or is not a file this version reads
+    static bool readSections(const QString &filename,
+                             QVector<QSharedPointer<TriangleList>> &patches);
+    static bool readContour(const QString &filename,
+                            QVector<QSharedPointer<QVector<Vec3>>> &strips);
+
+    //throw away the file and start a new one with these
+    static bool writeSections(const QString &filename, const QString &textFilename,
+                              const QVector<QSharedPointer<TriangleList>> &patches);
+    static bool writeContour(const QString &filename, const QString &textFilename,
+                             const QVector<QSharedPointer<QVector<Vec3>>> &strips);
+
+    //true if the text file is still the size and age the binary copy
+    //last saw it at, so the binary has everything the text has
+    static bool isBinaryInSync(const QString &textFilename, const QString &binFilename);
+
+    //AgOpenGPS Sections.txt, a vertex count then x,y,z lines for each patch
+    static void writeSectionsText(QTextStream &writer,
+                                  const QVector<QSharedPointer<TriangleList>> &patches);
+    static void readSectionsText(QTextStream &reader,
+                                 QVector<QSharedPointer<TriangleList>> &patches);
+
+    //AgOpenGPS Contour.txt, a header line then a point count and
+    //easting,northing,heading lines for each strip
+    static void writeContourText(QTextStream &writer,
+                                 const QVector<QSharedPointer<QVector<Vec3>>> &strips);
+    static void readContourText(QTextStream &reader,
+                                QVector<QSharedPointer<QVector<Vec3>>> &strips);
+
+    //append the text and, if it was in step, the binary copy. With
+    //isSync the data is pushed through to the disk before returning.
+    static bool saveSections(const QString &directoryName,
+                             const QVector<QSharedPointer<TriangleList>> &patches,
+                             bool isSync);
+    static bool saveContour(const QString &directoryName,
+                            const QVector<QSharedPointer<QVector<Vec3>>> &strips,
+                            bool isSync);
+
+    //append raw bytes to a log file in the field directory
+    static bool appendLog(const QString &directoryName, const QString &name,
+                          const QByteArray &bytes, bool isSync);
+
+    //replace a file in the field directory with bytes
+    static bool writeLog(const QString &directoryName, const QString &name,
+                         const QByteArray &bytes, bool isSync);
+
+    //flush Qt's buffer and the OS cache of an open file
+    static void syncFile(QFile &file);
+};
+
+#endif // CPATCHFILE_H
@@ -0,0 +1,224 @@
+#include "cpatchindex.h"
+#include <QtMath>
+
+CPatchIndex::CPatchIndex()
+{
+    clear();
+}
+
+void CPatchIndex::clear()
+{
+    nodes.clear();
+    sealed.clear();
+    root = -1;
+    numPatches = 0;
+    clearCount++;
+}
+
+bool CPatchIndex::patchBox(const TriangleList &patch, Box &box)
+{
+    int count = patch.size();
+    if (count < 2) return false;
+
+    //first vertex is color, skip it
+    box.minX = box.maxX = patch[1].x();
+    box.minY = box.maxY = patch[1].y();
+    for (int i = 2; i < count; i++)
+    {
+        double x = patch[i].x();
+        double y = patch[i].y();
+        if (x < box.minX) box.minX = x;
+        if (x > box.maxX) box.maxX = x;
+        if (y < box.minY) box.minY = y;
+        if (y > box.maxY) box.maxY = y;
+    }
+
+    //a bad point would grow the tree forever
+    return qIsFinite(box.minX) && qIsFinite(box.maxX) &&
+           qIsFinite(box.minY) && qIsFinite(box.maxY);
+}
+
+QSharedPointer<TriangleList> CPatchIndex::decimate(const QSharedPointer<TriangleList> &patch,
+                                                   int step)
+{
+    //color, then left and right points for every step of the strip
+    int count = patch->size();
+    int pairs = (count - 1) / 2;
+    if (step < 2 || pairs <= 2 || (count - 1) % 2) return patch;
+
+    QSharedPointer<TriangleList> coarse(new TriangleList);
+    coarse->reserve(1 + 2 * (pairs / step + 2));
+    coarse->append((*patch)[0]);
+
+    for (int p = 0; p < pairs; p += step)
+    {
+        coarse->append((*patch)[1 + 2 * p]);
+        coarse->append((*patch)[2 + 2 * p]);
+    }
+
+    //always finish where the patch finished
+    if ((pairs - 1) % step)
+    {
+        coarse->append((*patch)[count - 2]);
+        coarse->append((*patch)[count - 1]);
+    }
+
+    return coarse;
+}
+
+int CPatchIndex::lodForDistance(double camSetDistance)
+{
+    if (camSetDistance < -4800) return 4;
+    if (camSetDistance < -2400) return 3;
+    if (camSetDistance < -1500) return 2;
+    if (camSetDistance < -800) return 1;
+    return 0;
+}
+
+int CPatchIndex::addNode(double minX, double minY, double size)
+{
+    Node node;
+    node.bounds.minX = minX;
+    node.bounds.minY = minY;
+    node.bounds.maxX = minX + size;
+    node.bounds.maxY = minY + size;
+    node.child[0] = node.child[1] = node.child[2] = node.child[3] = -1;
+    nodes.append(node);
+    return nodes.size() - 1;
+}
+
+void CPatchIndex::growToFit(const Box &box)
+{
+    if (root < 0)
+    {
+        //start with a 256 m square centered on the first patch
+        double size = MINNODESIZE * 16;
+        root = addNode(floor((box.minX + box.maxX) * 0.5 - size * 0.5),
+                       floor((box.minY + box.maxY) * 0.5 - size * 0.5), size);
+    }
+
+    //double the root toward the patch until it fits, the old root
+    //becomes one quadrant of the new one
+    for (int i = 0; i < 48; i++)
+    {
+        Box rb = nodes[root].bounds;
+        if (box.minX >= rb.minX && box.maxX <= rb.maxX &&
+            box.minY >= rb.minY && box.maxY <= rb.maxY) return;
+
+        double size = rb.maxX - rb.minX;
+        int xi = (box.minX < rb.minX) ? 1 : 0;
+        int yi = (box.minY < rb.minY) ? 1 : 0;
+
+        int oldRoot = root;
+        root = addNode(rb.minX - xi * size, rb.minY - yi * size, size * 2);
+        nodes[root].child[xi + 2 * yi] = oldRoot;
+    }
+}
+
+bool CPatchIndex::makePatch(const QSharedPointer<TriangleList> &patch, Patch &item)
+{
+    if (!patchBox(*patch, item.box)) return false;
+
+    //every level halves the steps of the one before, once it stops
+    //getting any smaller the rest just share it
+    item.lod[0] = patch;
+    for (int l = 1; l < LODLEVELS; l++)
+    {
+        if (item.lod[l - 1]->size() <= 5) item.lod[l] = item.lod[l - 1];
+        else item.lod[l] = decimate(patch, 1 << l);
+    }
+    return true;
+}
+
+void CPatchIndex::insert(const QSharedPointer<TriangleList> &patch)
+{
+    Patch item;
+    if (makePatch(patch, item)) insert(item);
+}
+
+void CPatchIndex::insert(const Patch &item)
+{
+    growToFit(item.box);
+
+    //go down while the patch fits inside one quadrant
+    int n = root;
+    for (;;)
+    {
+        Box nb = nodes[n].bounds;
+        double half = (nb.maxX - nb.minX) * 0.5;
+        if (half < MINNODESIZE) break;
+
+        double midX = nb.minX + half;
+        double midY = nb.minY + half;
+        int xi, yi;
+
+        if (item.box.maxX <= midX) xi = 0;
+        else if (item.box.minX >= midX) xi = 1;
+        else break;
+
+        if (item.box.maxY <= midY) yi = 0;
+        else if (item.box.minY >= midY) yi = 1;
+        else break;
+
+        int q = xi + 2 * yi;
+        if (nodes[n].child[q] < 0)
+        {
+            int c = addNode(nb.minX + xi * half, nb.minY + yi * half, half);
+            nodes[n].child[q] = c;
+        }
+        n = nodes[n].child[q];
+    }
+
+    nodes[n].items.append(item);
+    sealed.append(item);
+    numPatches++;
+}
+
+int CPatchIndex::classify(const double *frustum, const Box &box)
+{
+    //right, left, far, near, bottom, top. z is always 0
+    bool isAllInside = true;
+
+    for (int p = 0; p < 24; p += 4)
+    {
+        double a = frustum[p];
+        double b = frustum[p + 1];
+        double d = frustum[p + 3];
+
+        //the corner furthest along the plane normal, and the nearest
+        double furthest = a * (a > 0 ? box.maxX : box.minX) + b * (b > 0 ? box.maxY : box.minY) + d;
+        if (furthest <= 0) return -1;
+
+        double nearest = a * (a > 0 ? box.minX : box.maxX) + b * (b > 0 ? box.minY : box.maxY) + d;
+        if (nearest <= 0) isAllInside = false;
+    }
+
+    return isAllInside ? 1 : 0;
+}
+
+void CPatchIndex::findInBox(const Box &box,
+                            QVector<QSharedPointer<TriangleList>> &found) const
+{
+    if (root < 0) return;
+
+    QVector<int> stack;
+    stack.append(root);
+
+    while (stack.size() > 0)
+    {
+        const Node &n = nodes[stack.takeLast()];
+
+        if (n.bounds.minX > box.maxX || n.bounds.maxX < box.minX ||
+            n.bounds.minY > box.maxY || n.bounds.maxY < box.minY) continue;
+
+        foreach (const Patch &item, n.items)
+        {
+            if (item.box.minX > box.maxX || item.box.maxX < box.minX ||
+                item.box.minY > box.maxY || item.box.maxY < box.minY) continue;
+            found.append(item.lod[0]);
+        }
+
+        for (int q = 0; q < 4; q++)
+            if (n.child[q] >= 0) stack.append(n.child[q]);
+    }
+}
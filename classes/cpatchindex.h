@@ -0,0 +1,99 @@
+#ifndef CPATCHINDEX_H
+#define CPATCHINDEX_H
+
+#include <QVector>
+#include <QSharedPointer>
+#include "csection.h"
+
+//Quadtree over every sealed coverage patch in the field. Each patch
+//gets its bounding box worked out once when it is sealed, and the tree
+//grows outward as coverage is applied further away, so a lookup only
+//visits the nodes it overlaps instead of every vertex of every patch
+//ever applied. The live patch of each section is still growing so it
+//is not in here.
+//
+//Each patch also keeps coarser copies of its strip that only use every
+//2nd, 4th, 8th or 16th step, for when the camera is pulled way back.
+//
+//The renderer no longer walks the tree. The frustum query it used to
+//make per patch was replaced by the tiles in CPatchBuffers, which are
+//culled a whole tile at a time and built from sealedPatches() and the
+//coarser copies. The tree is still what findInBox() searches for the
+//section raster.
+class CPatchIndex
+{
+public:
+    static const int LODLEVELS = 5;
+
+    struct Box
+    {
+        double minX, minY, maxX, maxY;
+    };
+
+    struct Patch
+    {
+        Box box;
+        QSharedPointer<TriangleList> lod[LODLEVELS]; //lod[0] is the patch
+    };
+
+    CPatchIndex();
+
+    void clear();
+    inline int count() const { return numPatches; }
+
+    //goes up every clear(), so anything built from sealedPatches()
+    //knows to start again
+    inline int generation() const { return clearCount; }
+
+    //every sealed patch in the order they were sealed. Sealed strips are
+    //never changed again, so they can be read without the lock.
+    inline const QVector<Patch> &sealedPatches() const { return sealed; }
+
+    //patch is a section triangle strip, first vertex is the colour
+    void insert(const QSharedPointer<TriangleList> &patch);
+    void insert(const Patch &item);
+
+    //box and coarser copies of a patch, without touching the tree, so
+    //they can be worked out on any thread. False if it has no points.
+    static bool makePatch(const QSharedPointer<TriangleList> &patch, Patch &item);
+
+    //level of detail to draw at for the camera distance, 0 is full
+    static int lodForDistance(double camSetDistance);
+
+    //every patch whose box overlaps box
+    void findInBox(const Box &box,
+                   QVector<QSharedPointer<TriangleList>> &found) const;
+
+    static bool patchBox(const TriangleList &patch, Box &box);
+
+    //frustum is the 24 plane coefficients from FormGPS::calcFrustum().
+    //-1 outside, 1 all inside, 0 crosses a plane
+    static int classify(const double *frustum, const Box &box);
+
+    //the strip keeping only every step'th pair of points, plus the last
+    static QSharedPointer<TriangleList> decimate(const QSharedPointer<TriangleList> &patch,
+                                                 int step);
+
+private:
+    //nodes never get smaller than this, in meters
+    static const int MINNODESIZE = 16;
+
+    struct Node
+    {
+        Box bounds;
+        int child[4];
+        QVector<Patch> items;
+    };
+
+    QVector<Patch> sealed;
+    int clearCount = 0;
+
+    QVector<Node> nodes;
+    int root;
+    int numPatches;
+
+    int addNode(double minX, double minY, double size);
+    void growToFit(const Box &box);
+};
+
+#endif // CPATCHINDEX_H
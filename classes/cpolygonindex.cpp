@@ -0,0 +1,179 @@
+#include "cpolygonindex.h"
+#include <math.h>
+#include "glm.h"
+
+CPolygonIndex::CPolygonIndex()
+{
+    clear();
+}
+
+void CPolygonIndex::clear()
+{
+    minNorthing = 0;
+    maxNorthing = 0;
+    slabScale = 0;
+    numSlabs = 0;
+    slabStart.clear();
+    slabEdges.clear();
+}
+
+void CPolygonIndex::buildSlabs(const QVector<Edge> &edges)
+{
+    int edgeCount = edges.size();
+
+    minNorthing = edges[0].northingI;
+    maxNorthing = edges[0].northingI;
+    for (int i = 1; i < edgeCount; i++)
+    {
+        if (edges[i].northingI < minNorthing) minNorthing = edges[i].northingI;
+        if (edges[i].northingI > maxNorthing) maxNorthing = edges[i].northingI;
+    }
+
+    //about one edge per slab for a boundary with evenly spaced points
+    numSlabs = edgeCount;
+    if (numSlabs > 4096) numSlabs = 4096;
+
+    double height = maxNorthing - minNorthing;
+    slabScale = height > 0 ? numSlabs / height : 0;
+
+    //count, then fill, each edge goes in every slab it spans
+    slabStart.fill(0, numSlabs + 1);
+    for (int i = 0; i < edgeCount; i++)
+    {
+        int lo = slabOf(qMin(edges[i].northingI, edges[i].northingJ));
+        int hi = slabOf(qMax(edges[i].northingI, edges[i].northingJ));
+        for (int s = lo; s <= hi; s++) slabStart[s + 1]++;
+    }
+    for (int s = 0; s < numSlabs; s++) slabStart[s + 1] += slabStart[s];
+
+    QVector<int> fill(slabStart);
+    slabEdges.resize(slabStart[numSlabs]);
+    for (int i = 0; i < edgeCount; i++)
+    {
+        int lo = slabOf(qMin(edges[i].northingI, edges[i].northingJ));
+        int hi = slabOf(qMax(edges[i].northingI, edges[i].northingJ));
+        for (int s = lo; s <= hi; s++) slabEdges[fill[s]++] = edges[i];
+    }
+}
+
+bool CPolygonIndex::contains(double easting, double northing) const
+{
+    //an edge only counts if one end is below and the other at or
+    //above, so nothing outside the northing range can be inside
+    if (numSlabs == 0 || northing <= minNorthing || northing > maxNorthing) return false;
+
+    int s = slabOf(northing);
+    const Edge *edge = slabEdges.constData() + slabStart[s];
+    const Edge *end = slabEdges.constData() + slabStart[s + 1];
+    bool oddNodes = false;
+
+    for (; edge < end; edge++)
+    {
+        if ((edge->northingI < northing && edge->northingJ >= northing)
+        || (edge->northingJ < northing && edge->northingI >= northing))
+        {
+            oddNodes ^= ((northing * edge->multiple) + edge->constant < easting);
+        }
+    }
+    return oddNodes; //true means inside.
+}
+
+void CPolygonIndex::contains(const QVector<Vec2> &points, QVector<bool> &result) const
+{
+    result.resize(points.size());
+    for (int i = 0; i < points.size(); i++)
+        result[i] = contains(points[i].easting, points[i].northing);
+}
+
+void CPolygonIndex::contains(const QVector<Vec3> &points, QVector<bool> &result) const
+{
+    result.resize(points.size());
+    for (int i = 0; i < points.size(); i++)
+        result[i] = contains(points[i].easting, points[i].northing);
+}
+
+void CPolygonIndex::crossings(double northing, QVector<double> &eastings) const
+{
+    if (numSlabs == 0 || northing <= minNorthing || northing > maxNorthing) return;
+
+    int s = slabOf(northing);
+    const Edge *edge = slabEdges.constData() + slabStart[s];
+    const Edge *end = slabEdges.constData() + slabStart[s + 1];
+
+    for (; edge < end; edge++)
+    {
+        if ((edge->northingI < northing && edge->northingJ >= northing)
+        || (edge->northingJ < northing && edge->northingI >= northing))
+        {
+            eastings.append((northing * edge->multiple) + edge->constant);
+        }
+    }
+}
+
+bool CPolygonIndex::rayCast(double easting, double northing, double heading, double maxDistance,
+                            double &distance, double &edgeHeading, int &edgeIndex) const
+{
+    if (numSlabs == 0) return false;
+
+    double dirE = sin(heading);
+    double dirN = cos(heading);
+
+    //skip rays that never reach the northing range of the polygon
+    double endNorthing = northing + dirN * maxDistance;
+    if (qMax(northing, endNorthing) < minNorthing || qMin(northing, endNorthing) > maxNorthing)
+        return false;
+
+    //walk the slabs in the order the ray goes through them
+    int first = slabOf(northing);
+    int last = slabOf(endNorthing);
+    int step = first <= last ? 1 : -1;
+
+    const Edge *bestEdge = NULL;
+    double bestT = maxDistance;
+
+    for (int s = first; ; s += step)
+    {
+        const Edge *edge = slabEdges.constData() + slabStart[s];
+        const Edge *end = slabEdges.constData() + slabStart[s + 1];
+
+        for (; edge < end; edge++)
+        {
+            double segE = edge->eastingI - edge->eastingJ;
+            double segN = edge->northingI - edge->northingJ;
+
+            //parallel to the ray
+            double denom = dirE * segN - dirN * segE;
+            if (fabs(denom) < 1e-12) continue;
+
+            double toE = edge->eastingJ - easting;
+            double toN = edge->northingJ - northing;
+
+            double t = (toE * segN - toN * segE) / denom;
+            if (t < 0 || t > bestT) continue;
+
+            double u = (toE * dirN - toN * dirE) / denom;
+            if (u < 0 || u > 1) continue;
+
+            bestT = t;
+            bestEdge = edge;
+        }
+
+        if (s == last) break;
+
+        //anything in the slabs still to come is farther along the ray
+        if (bestEdge)
+        {
+            double hitNorthing = northing + dirN * bestT;
+            if (step > 0 && hitNorthing <= minNorthing + (s + 1) / slabScale) break;
+            if (step < 0 && hitNorthing >= minNorthing + s / slabScale) break;
+        }
+    }
+
+    if (!bestEdge) return false;
+
+    distance = bestT;
+    edgeIndex = bestEdge->index;
+    edgeHeading = atan2(bestEdge->eastingI - bestEdge->eastingJ, bestEdge->northingI - bestEdge->northingJ);
+    if (edgeHeading < 0) edgeHeading += glm::twoPI;
+    return true;
+}
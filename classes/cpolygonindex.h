@@ -0,0 +1,96 @@
+#ifndef CPOLYGONINDEX_H
+#define CPOLYGONINDEX_H
+
+#include <QVector>
+#include "vec2.h"
+#include "vec3.h"
+
+//Northing slabs over a closed polygon, for the even-odd crossing test
+//the boundary, headland, turn, geofence and tram lines all use. Each
+//slab keeps only the edges that span it, so a test looks at a handful
+//of edges instead of all of them. Built from the line and the
+//constant/multiple calcList right after the preCalc, and gives exactly
+//the same answer as the full loop.
+class CPolygonIndex
+{
+public:
+    CPolygonIndex();
+
+    void clear();
+    inline bool isEmpty() const { return numSlabs == 0; }
+
+    //line is any list of points with easting and northing
+    template <class T>
+    void build(const QVector<T> &line, const QVector<Vec2> &calcList);
+
+    bool contains(double easting, double northing) const;
+    inline bool contains(const Vec2 &pt) const { return contains(pt.easting, pt.northing); }
+    inline bool contains(const Vec3 &pt) const { return contains(pt.easting, pt.northing); }
+
+    //many points at once, result[i] is true if points[i] is inside
+    void contains(const QVector<Vec2> &points, QVector<bool> &result) const;
+    void contains(const QVector<Vec3> &points, QVector<bool> &result) const;
+
+    //eastings where the edges cross this northing, unsorted. A point on
+    //the row is inside if an odd number of them are less than its easting.
+    void crossings(double northing, QVector<double> &eastings) const;
+
+    //first edge crossed by the ray from easting, northing along heading
+    //within maxDistance. distance is along the ray, edgeHeading is the
+    //heading of the edge from point i - 1 to point i and edgeIndex is i.
+    bool rayCast(double easting, double northing, double heading, double maxDistance,
+                 double &distance, double &edgeHeading, int &edgeIndex) const;
+
+private:
+    struct Edge
+    {
+        double northingI, northingJ;
+        double constant, multiple;
+        double eastingI, eastingJ;
+        int index;
+    };
+
+    double minNorthing, maxNorthing, slabScale;
+    int numSlabs;
+
+    //edges of slab s are slabEdges[slabStart[s]] to slabEdges[slabStart[s+1]-1]
+    QVector<int> slabStart;
+    QVector<Edge> slabEdges;
+
+    inline int slabOf(double northing) const
+    {
+        int s = (int)((northing - minNorthing) * slabScale);
+        if (s < 0) return 0;
+        if (s >= numSlabs) return numSlabs - 1;
+        return s;
+    }
+
+    void buildSlabs(const QVector<Edge> &edges);
+};
+
+template <class T>
+void CPolygonIndex::build(const QVector<T> &line, const QVector<Vec2> &calcList)
+{
+    clear();
+
+    int ptCount = line.size();
+    if (ptCount < 3 || calcList.size() < ptCount) return;
+
+    //same edge order as the crossing loops, i to j = i - 1
+    QVector<Edge> edges(ptCount);
+    int j = ptCount - 1;
+    for (int i = 0; i < ptCount; j = i++)
+    {
+        edges[i].northingI = line[i].northing;
+        edges[i].northingJ = line[j].northing;
+        edges[i].constant = calcList[i].easting;
+        edges[i].multiple = calcList[i].northing;
+        edges[i].eastingI = line[i].easting;
+        edges[i].eastingJ = line[j].easting;
+        edges[i].index = i;
+    }
+
+    buildSlabs(edges);
+}
+
+#endif // CPOLYGONINDEX_H
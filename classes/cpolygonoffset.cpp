@@ -0,0 +1,434 @@
+#include "cpolygonoffset.h"
+#include <math.h>
+#include <algorithm>
+#include "glm.h"
+
+//anything closer than this is the same point
+static const double OFFSET_EPSILON = 0.000001;
+
+//twice the signed area, positive when wound counter clockwise with
+//easting as x and northing as y
+static double signedArea2(const QVector<Vec2> &ring)
+{
+    double area = 0;
+    int j = ring.size() - 1;
+    for (int i = 0; i < ring.size(); j = i++)
+        area += (ring[j].easting * ring[i].northing) - (ring[i].easting * ring[j].northing);
+    return area;
+}
+
+static double distanceToSegmentSq(const Vec2 &pt, const Vec2 &a, const Vec2 &b)
+{
+    double dE = b.easting - a.easting;
+    double dN = b.northing - a.northing;
+    double lenSq = dE * dE + dN * dN;
+    double t = 0;
+    if (lenSq > 0)
+    {
+        t = ((pt.easting - a.easting) * dE + (pt.northing - a.northing) * dN) / lenSq;
+        if (t < 0) t = 0;
+        if (t > 1) t = 1;
+    }
+    double e = a.easting + t * dE - pt.easting;
+    double n = a.northing + t * dN - pt.northing;
+    return e * e + n * n;
+}
+
+//Uniform grid of segments, each segment is in every cell its bounding
+//box touches. Cells are packed like the slabs in CPolygonIndex, the
+//segments of cell c are cellSegs[cellStart[c]] to cellSegs[cellStart[c+1]-1].
+struct OffsetGrid
+{
+    double minE, minN, cellSize;
+    int cols, rows;
+    QVector<int> cellStart;
+    QVector<int> cellSegs;
+
+    inline int colOf(double easting) const
+    {
+        int c = (int)((easting - minE) / cellSize);
+        return c < 0 ? 0 : (c >= cols ? cols - 1 : c);
+    }
+
+    inline int rowOf(double northing) const
+    {
+        int r = (int)((northing - minN) / cellSize);
+        return r < 0 ? 0 : (r >= rows ? rows - 1 : r);
+    }
+
+    //segment i runs from pts[i] to pts[(i + 1) % count]
+    void build(const QVector<Vec2> &pts, double size)
+    {
+        int count = pts.size();
+
+        double maxE, maxN;
+        minE = maxE = pts[0].easting;
+        minN = maxN = pts[0].northing;
+        for (int i = 1; i < count; i++)
+        {
+            minE = qMin(minE, pts[i].easting);
+            maxE = qMax(maxE, pts[i].easting);
+            minN = qMin(minN, pts[i].northing);
+            maxN = qMax(maxN, pts[i].northing);
+        }
+
+        //keep the grid to a sane size for huge fields and tiny offsets
+        cellSize = qMax(size, OFFSET_EPSILON);
+        while (((maxE - minE) / cellSize + 1) * ((maxN - minN) / cellSize + 1) > 1048576)
+            cellSize *= 2;
+
+        cols = (int)((maxE - minE) / cellSize) + 1;
+        rows = (int)((maxN - minN) / cellSize) + 1;
+
+        //count, then fill
+        cellStart.fill(0, cols * rows + 1);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            QVector<int> fill;
+            if (pass == 1)
+            {
+                for (int c = 0; c < cols * rows; c++) cellStart[c + 1] += cellStart[c];
+                fill = cellStart;
+                cellSegs.resize(cellStart[cols * rows]);
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                const Vec2 &a = pts[i];
+                const Vec2 &b = pts[(i + 1) % count];
+                int c0 = colOf(qMin(a.easting, b.easting));
+                int c1 = colOf(qMax(a.easting, b.easting));
+                int r0 = rowOf(qMin(a.northing, b.northing));
+                int r1 = rowOf(qMax(a.northing, b.northing));
+
+                for (int r = r0; r <= r1; r++)
+                {
+                    for (int c = c0; c <= c1; c++)
+                    {
+                        if (pass == 0) cellStart[r * cols + c + 1]++;
+                        else cellSegs[fill[r * cols + c]++] = i;
+                    }
+                }
+            }
+        }
+    }
+};
+
+//is any edge of ring closer to pt than distance
+static bool isCloserThan(const QVector<Vec2> &ring, const OffsetGrid &grid, const Vec2 &pt, double distance)
+{
+    int count = ring.size();
+    double limitSq = (distance - OFFSET_EPSILON) * (distance - OFFSET_EPSILON);
+
+    int c0 = grid.colOf(pt.easting - distance);
+    int c1 = grid.colOf(pt.easting + distance);
+    int r0 = grid.rowOf(pt.northing - distance);
+    int r1 = grid.rowOf(pt.northing + distance);
+
+    for (int r = r0; r <= r1; r++)
+    {
+        for (int c = c0; c <= c1; c++)
+        {
+            int cell = r * grid.cols + c;
+            for (int k = grid.cellStart[cell]; k < grid.cellStart[cell + 1]; k++)
+            {
+                int i = grid.cellSegs[k];
+                if (distanceToSegmentSq(pt, ring[i], ring[(i + 1) % count]) < limitSq) return true;
+            }
+        }
+    }
+    return false;
+}
+
+//where the split points on one raw segment are, t along it and node id
+struct OffsetSplit
+{
+    double t;
+    int node;
+    bool operator<(const OffsetSplit &other) const { return t < other.t; }
+};
+
+QVector<Vec3> CPolygonOffset::offsetRing(const QVector<Vec2> &input, double distance,
+                                         double minSpacing, double maxSpacing)
+{
+    QVector<Vec3> result;
+
+    //drop repeated points, boundaries often end on their first point
+    QVector<Vec2> ring;
+    for (int i = 0; i < input.size(); i++)
+    {
+        if (ring.size() > 0 && glm::distance(ring.last(), input[i]) < OFFSET_EPSILON) continue;
+        ring.append(input[i]);
+    }
+    while (ring.size() > 1 && glm::distance(ring.last(), ring[0]) < OFFSET_EPSILON) ring.removeLast();
+
+    int count = ring.size();
+    if (count < 3) return result;
+
+    double area2 = signedArea2(ring);
+    if (area2 == 0) return result;
+
+    //left of the edges is inside when wound counter clockwise
+    double orient = area2 > 0 ? 1.0 : -1.0;
+    double absDistance = fabs(distance);
+
+    QVector<Vec2> raw;
+
+    if (absDistance < OFFSET_EPSILON)
+    {
+        raw = ring;
+    }
+    else
+    {
+        //outside normal of each edge times the distance
+        QVector<Vec2> normal(count);
+        for (int i = 0; i < count; i++)
+        {
+            const Vec2 &a = ring[i];
+            const Vec2 &b = ring[(i + 1) % count];
+            double dE = b.easting - a.easting;
+            double dN = b.northing - a.northing;
+            double len = sqrt(dE * dE + dN * dN);
+            normal[i] = Vec2(orient * dN / len * distance, -orient * dE / len * distance);
+        }
+
+        //arcs are cut in steps no longer than the spacing we want back
+        double maxStep = M_PI / 16;
+        if (maxSpacing > 0) maxStep = qMin(maxStep, maxSpacing / absDistance);
+
+        //the raw offset, every edge moved out with the corners joined
+        for (int i = 0; i < count; i++)
+        {
+            int next = (i + 1) % count;
+            const Vec2 &corner = ring[next];
+
+            raw.append(ring[i] + normal[i]);
+            raw.append(corner + normal[i]);
+
+            //does the corner open up a gap between the moved edges
+            double sweep = atan2(normal[next].northing, normal[next].easting) -
+                           atan2(normal[i].northing, normal[i].easting);
+            if (sweep > M_PI) sweep -= glm::twoPI;
+            if (sweep < -M_PI) sweep += glm::twoPI;
+
+            const Vec2 &a = ring[i];
+            const Vec2 &c = ring[(next + 1) % count];
+            double turn = ((corner.easting - a.easting) * (c.northing - corner.northing) -
+                           (corner.northing - a.northing) * (c.easting - corner.easting)) * orient;
+
+            if ((turn > 0) != (distance > 0) || fabs(sweep) < 0.000001) continue;
+
+            //fill it with an arc. The points sit outside the circle so
+            //every chord touches it, that way no bit of the arc comes
+            //closer than the distance and gets cut off.
+            int steps = (int)ceil(fabs(sweep) / maxStep);
+            double step = sweep / steps;
+            double radius = absDistance / cos(step * 0.5);
+            double start = atan2(normal[i].northing, normal[i].easting);
+            for (int k = 1; k <= steps; k++)
+            {
+                double angle = start + (k - 0.5) * step;
+                raw.append(Vec2(corner.easting + radius * cos(angle), corner.northing + radius * sin(angle)));
+            }
+        }
+
+        //no zero length segments
+        QVector<Vec2> cleaned;
+        for (int i = 0; i < raw.size(); i++)
+        {
+            if (cleaned.size() > 0 && glm::distance(cleaned.last(), raw[i]) < OFFSET_EPSILON) continue;
+            cleaned.append(raw[i]);
+        }
+        while (cleaned.size() > 1 && glm::distance(cleaned.last(), cleaned[0]) < OFFSET_EPSILON) cleaned.removeLast();
+        raw = cleaned;
+    }
+
+    int rawCount = raw.size();
+    if (rawCount < 3) return result;
+
+    //nodes are the raw points then every crossing
+    QVector<Vec2> nodes = raw;
+    QVector<QVector<OffsetSplit>> splits(rawCount);
+
+    if (absDistance >= OFFSET_EPSILON)
+    {
+        double length = 0;
+        for (int i = 0; i < rawCount; i++) length += glm::distance(raw[i], raw[(i + 1) % rawCount]);
+
+        OffsetGrid rawGrid;
+        rawGrid.build(raw, qMax(absDistance, length / rawCount));
+
+        for (int cell = 0; cell < rawGrid.cols * rawGrid.rows; cell++)
+        {
+            int begin = rawGrid.cellStart[cell];
+            int end = rawGrid.cellStart[cell + 1];
+
+            for (int p = begin; p < end; p++)
+            {
+                int i = rawGrid.cellSegs[p];
+                const Vec2 &a = raw[i];
+                const Vec2 &b = raw[(i + 1) % rawCount];
+
+                for (int q = p + 1; q < end; q++)
+                {
+                    int j = rawGrid.cellSegs[q];
+
+                    //neighbours only meet at their shared point
+                    if (j == (i + 1) % rawCount || i == (j + 1) % rawCount) continue;
+
+                    const Vec2 &c = raw[j];
+                    const Vec2 &d = raw[(j + 1) % rawCount];
+
+                    double rE = b.easting - a.easting, rN = b.northing - a.northing;
+                    double sE = d.easting - c.easting, sN = d.northing - c.northing;
+                    double denom = rE * sN - rN * sE;
+                    if (fabs(denom) < 1e-15) continue;
+
+                    double acE = c.easting - a.easting, acN = c.northing - a.northing;
+                    double t = (acE * sN - acN * sE) / denom;
+                    double u = (acE * rN - acN * rE) / denom;
+                    if (t <= 0 || t >= 1 || u <= 0 || u >= 1) continue;
+
+                    Vec2 cross(a.easting + t * rE, a.northing + t * rN);
+
+                    //the pair shows up in every cell they share, only count it once
+                    if (rawGrid.rowOf(cross.northing) * rawGrid.cols + rawGrid.colOf(cross.easting) != cell) continue;
+
+                    int node = nodes.size();
+                    nodes.append(cross);
+                    splits[i].append({ t, node });
+                    splits[j].append({ u, node });
+                }
+            }
+        }
+    }
+
+    //cut the raw offset into pieces at the crossings and keep the ones
+    //that stay the distance away from the original ring
+    OffsetGrid ringGrid;
+    ringGrid.build(ring, qMax(absDistance, OFFSET_EPSILON));
+
+    QVector<int> pieceFrom, pieceTo;
+    for (int i = 0; i < rawCount; i++)
+    {
+        std::sort(splits[i].begin(), splits[i].end());
+
+        int from = i;
+        for (int k = 0; k <= splits[i].size(); k++)
+        {
+            int to = k < splits[i].size() ? splits[i][k].node : (i + 1) % rawCount;
+
+            Vec2 mid((nodes[from].easting + nodes[to].easting) * 0.5,
+                     (nodes[from].northing + nodes[to].northing) * 0.5);
+
+            if (absDistance < OFFSET_EPSILON || !isCloserThan(ring, ringGrid, mid, absDistance))
+            {
+                pieceFrom.append(from);
+                pieceTo.append(to);
+            }
+            from = to;
+        }
+    }
+
+    //link the pieces up, each node knows the pieces leaving it
+    int pieceCount = pieceFrom.size();
+    QVector<int> firstOut(nodes.size(), -1);
+    QVector<int> nextOut(pieceCount, -1);
+    for (int p = pieceCount - 1; p >= 0; p--)
+    {
+        nextOut[p] = firstOut[pieceFrom[p]];
+        firstOut[pieceFrom[p]] = p;
+    }
+
+    QVector<bool> used(pieceCount, false);
+    QVector<Vec2> best;
+    double bestArea = 0;
+
+    for (int start = 0; start < pieceCount; start++)
+    {
+        if (used[start]) continue;
+
+        QVector<Vec2> loop;
+        QVector<int> walked;
+        int p = start;
+        bool isClosed = false;
+
+        while (p >= 0)
+        {
+            used[p] = true;
+            walked.append(p);
+            loop.append(nodes[pieceFrom[p]]);
+
+            int node = pieceTo[p];
+            if (node == pieceFrom[start])
+            {
+                isClosed = true;
+                break;
+            }
+
+            //take the first piece out of here that isn't taken yet
+            p = firstOut[node];
+            while (p >= 0 && used[p]) p = nextOut[p];
+        }
+
+        if (!isClosed || loop.size() < 3) continue;
+
+        //holes wind the other way, islands the same
+        double area2 = signedArea2(loop);
+        if (area2 * orient <= 0) continue;
+
+        if (fabs(area2) > bestArea)
+        {
+            bestArea = fabs(area2);
+            best = loop;
+        }
+    }
+
+    if (best.size() < 3) return result;
+
+    //no points closer than minSpacing, in one pass
+    QVector<Vec2> spaced;
+    spaced.reserve(best.size());
+    for (int i = 0; i < best.size(); i++)
+    {
+        if (spaced.size() > 0 && glm::distance(spaced.last(), best[i]) < minSpacing) continue;
+        spaced.append(best[i]);
+    }
+    while (spaced.size() > 3 && glm::distance(spaced.last(), spaced[0]) < minSpacing) spaced.removeLast();
+    if (spaced.size() < 3) return result;
+
+    //and none farther apart than maxSpacing
+    QVector<Vec2> dense;
+    int spacedCount = spaced.size();
+    for (int i = 0; i < spacedCount; i++)
+    {
+        const Vec2 &a = spaced[i];
+        const Vec2 &b = spaced[(i + 1) % spacedCount];
+        dense.append(a);
+
+        if (maxSpacing <= 0) continue;
+
+        int steps = (int)ceil(glm::distance(a, b) / maxSpacing);
+        for (int k = 1; k < steps; k++)
+        {
+            double t = (double)k / steps;
+            dense.append(Vec2(a.easting + t * (b.easting - a.easting), a.northing + t * (b.northing - a.northing)));
+        }
+    }
+
+    //heading from the point before to the point after
+    int denseCount = dense.size();
+    result.resize(denseCount);
+    for (int i = 0; i < denseCount; i++)
+    {
+        const Vec2 &prev = dense[(i + denseCount - 1) % denseCount];
+        const Vec2 &next = dense[(i + 1) % denseCount];
+
+        result[i].easting = dense[i].easting;
+        result[i].northing = dense[i].northing;
+        result[i].heading = atan2(next.easting - prev.easting, next.northing - prev.northing);
+        if (result[i].heading < 0) result[i].heading += glm::twoPI;
+    }
+
+    return result;
+}
@@ -0,0 +1,46 @@
+#ifndef CPOLYGONOFFSET_H
+#define CPOLYGONOFFSET_H
+
+#include <QVector>
+#include "vec2.h"
+#include "vec3.h"
+
+//Offsets a closed ring like a boundary by a distance, the way a clipper
+//does it instead of moving each point along its own normal. Every edge
+//is moved along its normal, outside corners are joined with an arc and
+//inside corners just overlap. Where the raw offset crosses itself it is
+//cut up, the pieces closer than the distance to the original ring are
+//thrown out and the rest is linked back up into rings. Crossings are
+//found through a grid, so dense boundaries stay fast.
+class CPolygonOffset
+{
+public:
+    //A positive distance grows the area the ring encloses, a negative
+    //one shrinks it, whichever way the ring is wound. The result keeps
+    //the winding of ring, has no points closer than minSpacing or
+    //farther apart than maxSpacing (0 leaves long edges alone) and gets
+    //headings from the neighbouring points. If the offset falls apart
+    //into pieces, a field pinched in two, only the biggest one is kept.
+    //Empty if nothing is left.
+    template <class T>
+    static QVector<Vec3> offset(const QVector<T> &ring, double distance,
+                                double minSpacing, double maxSpacing);
+
+private:
+    static QVector<Vec3> offsetRing(const QVector<Vec2> &ring, double distance,
+                                    double minSpacing, double maxSpacing);
+};
+
+template <class T>
+QVector<Vec3> CPolygonOffset::offset(const QVector<T> &ring, double distance,
+                                     double minSpacing, double maxSpacing)
+{
+    QVector<Vec2> points;
+    points.reserve(ring.size());
+    for (int i = 0; i < ring.size(); i++)
+        points.append(Vec2(ring[i].easting, ring[i].northing));
+
+    return offsetRing(points, distance, minSpacing, maxSpacing);
+}
+
+#endif // CPOLYGONOFFSET_H
@@ -0,0 +1,37 @@
+#include "cpositionsnapshot.h"
+#include <atomic>
+
+CPositionSnapshot::CPositionSnapshot()
+    : sequence(0)
+{
+}
+
+void CPositionSnapshot::publish(const CPositionState &newState)
+{
+    //odd while the copy is going on
+    sequence.fetchAndAddOrdered(1);
+
+    state = newState;
+
+    sequence.fetchAndAddRelease(1);
+}
+
+CPositionState CPositionSnapshot::read() const
+{
+    CPositionState copy;
+    int before, after;
+
+    do
+    {
+        before = sequence.loadAcquire();
+        if (before & 1) continue;
+
+        copy = state;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.loadAcquire();
+        if (before == after) break;
+    } while (true);
+
+    return copy;
+}
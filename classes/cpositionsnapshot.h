@@ -0,0 +1,45 @@
+#ifndef CPOSITIONSNAPSHOT_H
+#define CPOSITIONSNAPSHOT_H
+
+#include <QAtomicInt>
+#include "vec2.h"
+#include "vec3.h"
+
+//what the renderer and the UI need from the last fix
+struct CPositionState
+{
+    Vec2 fix;
+    Vec3 pivotAxlePos;
+    Vec3 steerAxlePos;
+    Vec3 toolPos;
+    double fixHeading = 0;
+    double camHeading = 0;
+    double speed = 0;
+
+    short int guidanceLineDistanceOff = 32000;
+    short int guidanceLineSteerAngle = 0;
+
+    //bit j set if section j is on
+    quint32 sectionOnBits = 0;
+};
+
+//Hands the result of each fix from the positioning thread to the GUI
+//and render threads. Single writer seqlock: publish() never waits,
+//read() copies and retries if a publish happened in the middle.
+class CPositionSnapshot
+{
+public:
+    CPositionSnapshot();
+
+    void publish(const CPositionState &newState);
+    CPositionState read() const;
+
+    //goes up by one every publish, so readers can tell there's a new fix
+    inline uint fixNumber() const { return (uint)sequence.loadAcquire() >> 1; }
+
+private:
+    QAtomicInt sequence;
+    CPositionState state;
+};
+
+#endif // CPOSITIONSNAPSHOT_H
@@ -11,7 +11,7 @@ CSection::CSection(QObject *parent) : QObject(parent)
 }
 
 void CSection::turnMappingOn() {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
     numTriangles = 0;
 
     //do not tally square meters on inital point, that would be silly
@@ -28,7 +28,7 @@ void CSection::turnMappingOn() {
         patchList.append(triangleList);
 
         //vec3 colur = new vec3(mf.sectionColorDay.R, mf.sectionColorDay.G, mf.sectionColorDay.B);
-        QVector3D colur = parseColorVector(SETTINGS_DISPLAY_SECTIONSCOLORDAY);
+        QVector3D colur = snapshot->displaySectionsColorDay;
         triangleList->append(colur);
 
 
@@ -50,6 +50,7 @@ void CSection::turnMappingOff(CTool &tool) {
     {
         //save the triangle list in a patch list to add to saving file
         tool.patchSaveList.append(triangleList);
+        tool.patchIndex.insert(triangleList);
     }
     else
     {
@@ -64,7 +65,7 @@ void CSection::turnMappingOff(CTool &tool) {
 
 void CSection::addMappingPoint(CTool &tool)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
     //add two triangles for next step.
     //left side and add the point to List
 
@@ -87,8 +88,9 @@ void CSection::addMappingPoint(CTool &tool)
     int c = triangleList->size()-1;
 
     //when closing a job the triangle patches all are emptied but the section delay keeps going.
-    //Prevented by quick check. 4 points plus colour (which we aren't implementing at this yet. TODO
-    if (c >= 5) //would be 5 if using colur thing
+    //Prevented by quick check. 4 points plus colour, so the first box
+    //of a patch counts too, as it does when the field is read back in
+    if (c >= 4)
     {
         //calculate area of these 2 new triangles - AbsoluteValue of (Ax(By-Cy) + Bx(Cy-Ay) + Cx(Ay-By)/2)
         //easting = x, northing = y!
@@ -110,6 +112,9 @@ void CSection::addMappingPoint(CTool &tool)
             emit addToTotalArea(temp);
             emit addToUserArea(temp);
         }
+
+        emit addToCoverage((*triangleList)[c - 3], (*triangleList)[c - 2],
+                           (*triangleList)[c - 1], (*triangleList)[c]);
     }
 
     if (numTriangles > 36)
@@ -118,12 +123,13 @@ void CSection::addMappingPoint(CTool &tool)
 
         //save the cutoff patch to be saved later
         tool.patchSaveList.append(triangleList);
+        tool.patchIndex.insert(triangleList);
 
         triangleList = QSharedPointer<TriangleList>( new TriangleList);
         patchList.append(triangleList);
 
         //add patch color
-        QVector3D colur = parseColorVector(SETTINGS_DISPLAY_SECTIONSCOLORDAY);
+        QVector3D colur = snapshot->displaySectionsColorDay;
         triangleList->append(colur);
 
         //add the points to List, yes its more points, but breaks up patches for culling
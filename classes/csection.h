@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QVector>
 #include <QSharedPointer>
+#include <QVector3D>
 #include "vec2.h"
 #include "vec3.h"
 #include "btnenum.h"
@@ -96,6 +97,7 @@ public:
 signals:
     void addToTotalArea(double);
     void addToUserArea(double);
+    void addToCoverage(QVector3D, QVector3D, QVector3D, QVector3D);
 };
 
 #endif // CSECTION_H
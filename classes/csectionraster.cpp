@@ -0,0 +1,243 @@
+#include "csectionraster.h"
+#include <QVector>
+#include <QtMath>
+#include "ctool.h"
+#include "cboundary.h"
+#include "chead.h"
+
+//Same camera the back buffer FBO used: 6 degree fov, 480 m up, 500
+//pixels square, so about 10 pixels per meter with the tool at pixel 250.
+static const double BACKFOV = 0.104719758;
+static const double BACKCAMERAHEIGHT = 480.0;
+static const double BACKHALFSIZE = 250.0;
+
+CSectionRaster::CSectionRaster()
+{
+    buffer = 0;
+    width = 0;
+    sinH = 0;
+    cosH = 1;
+    scale = BACKHALFSIZE / (BACKCAMERAHEIGHT * tan(BACKFOV * 0.5));
+    colOffset = 0;
+    originE = 0;
+    originN = 0;
+}
+
+void CSectionRaster::rasterize(LookAheadPixels *pixels, int numSuperSection,
+                               const CTool &tool, const Vec3 &toolPos,
+                               const CBoundary &bnd, const CHead &hd)
+{
+    buffer = pixels;
+    width = tool.rpWidth;
+
+    int total = width * RASTERHEIGHT;
+    if (total <= 0) return;
+
+    //clear to black, like glClear did
+    const LookAheadPixels black = { 0, 0, 0, 255 };
+    for (int i = 0; i < total; i++) buffer[i] = black;
+
+    //rotate so heading is straight up, tool at the bottom edge
+    sinH = sin(toolPos.heading);
+    cosH = cos(toolPos.heading);
+    originE = toolPos.easting;
+    originN = toolPos.northing;
+    colOffset = BACKHALFSIZE - tool.rpXPosition;
+
+    const LookAheadPixels applied = { 0, APPLIEDGREEN, 0, 255 };
+
+    double x0, y0, x1, y1, x2, y2;
+
+    //world box around the window, only patches that reach it are drawn
+    CPatchIndex::Box window;
+    window.minX = window.maxX = originE;
+    window.minY = window.maxY = originN;
+    for (int c = 0; c < 4; c++)
+    {
+        double e, n;
+        toWorld((c & 1) ? width : 0, (c & 2) ? RASTERHEIGHT : 0, e, n);
+        if (e < window.minX) window.minX = e;
+        if (e > window.maxX) window.maxX = e;
+        if (n < window.minY) window.minY = n;
+        if (n > window.maxY) window.maxY = n;
+    }
+
+    QVector<QSharedPointer<TriangleList>> patches;
+    tool.patchIndex.findInBox(window, patches);
+
+    //the live patch of each section isn't sealed into the index yet
+    for (int j = 0; j < numSuperSection; j++)
+    {
+        if (tool.section[j].isMappingOn && tool.section[j].patchList.size() > 0)
+            patches.append(tool.section[j].patchList.last());
+    }
+
+    foreach (const QSharedPointer<TriangleList> &triList, patches)
+    {
+        int count2 = triList->size();
+        if (count2 < 4) continue;
+
+        const QVector3D *pts = triList->constData();
+
+        //first vertex is color, skip it. Skip whole patches that
+        //have every vertex off the same side of the window.
+        bool left = true, right = true, below = true, above = true;
+        for (int i = 1; i < count2; i++)
+        {
+            toRaster(pts[i].x(), pts[i].y(), x0, y0);
+            if (x0 >= 0) left = false;
+            if (x0 <= width) right = false;
+            if (y0 >= 0) below = false;
+            if (y0 <= RASTERHEIGHT) above = false;
+        }
+        if (left || right || below || above) continue;
+
+        toRaster(pts[1].x(), pts[1].y(), x0, y0);
+        toRaster(pts[2].x(), pts[2].y(), x1, y1);
+
+        //every vertex after the first two finishes a strip triangle
+        for (int i = 3; i < count2; i++)
+        {
+            toRaster(pts[i].x(), pts[i].y(), x2, y2);
+            fillTriangle(x0, y0, x1, y1, x2, y2, applied);
+            x0 = x1; y0 = y1;
+            x1 = x2; y1 = y2;
+        }
+    }
+
+    //outer boundary line on top of the patches
+    if (bnd.bndArr.count() > 0)
+    {
+        const QVector<Vec3> &bndLine = bnd.bndArr[0].bndLine;
+        const LookAheadPixels boundary = { 0, BOUNDARYGREEN, 0, 255 };
+
+        if (bndLine.count() > 1)
+        {
+            toRaster(bndLine[0].easting, bndLine[0].northing, x0, y0);
+            for (int h = 1; h < bndLine.count(); h++)
+            {
+                toRaster(bndLine[h].easting, bndLine[h].northing, x1, y1);
+                drawLine(x0, y0, x1, y1, 2.0, boundary);
+                x0 = x1; y0 = y1;
+            }
+        }
+    }
+
+    //headland, only the parts that are flagged to be drawn
+    if (hd.isOn && hd.headArr.count() > 0)
+    {
+        const QVector<Vec3> &hdLine = hd.headArr[0].hdLine;
+        const QVector<bool> &isDrawList = hd.headArr[0].isDrawList;
+        const LookAheadPixels headland = { 245, HEADLANDGREEN, 77, 255 };
+
+        int ptCount = hdLine.count();
+        if (ptCount < 2 || isDrawList.count() < ptCount) return;
+
+        QVector<int> strip;
+        int cntr = 0;
+
+        //same runs as CHeadLines::drawHeadLineBackBuffer
+        while (cntr < ptCount)
+        {
+            if (isDrawList[cntr])
+            {
+                strip.clear();
+
+                if (cntr > 0) strip.append(cntr - 1);
+                else strip.append(ptCount - 1);
+
+                for (int i = cntr; i < ptCount; i++)
+                {
+                    cntr++;
+                    if (!isDrawList[i]) break;
+                    strip.append(i);
+                }
+                if (cntr < ptCount - 1) strip.append(cntr + 1);
+
+                toRaster(hdLine[strip[0]].easting, hdLine[strip[0]].northing, x0, y0);
+                for (int i = 1; i < strip.count(); i++)
+                {
+                    toRaster(hdLine[strip[i]].easting, hdLine[strip[i]].northing, x1, y1);
+                    drawLine(x0, y0, x1, y1, 3.0, headland);
+                    x0 = x1; y0 = y1;
+                }
+            }
+            else
+            {
+                cntr++;
+            }
+        }
+    }
+}
+
+void CSectionRaster::fillTriangle(double x0, double y0, double x1, double y1,
+                                  double x2, double y2, const LookAheadPixels &color)
+{
+    double area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    if (fabs(area) < 1e-9) return;
+
+    //strips alternate winding, so make them all counter clockwise
+    if (area < 0)
+    {
+        double t = x1; x1 = x2; x2 = t;
+        t = y1; y1 = y2; y2 = t;
+    }
+
+    //bounding box clipped to the window
+    int minX = (int)floor(qMin(x0, qMin(x1, x2)));
+    int maxX = (int)ceil(qMax(x0, qMax(x1, x2)));
+    int minY = (int)floor(qMin(y0, qMin(y1, y2)));
+    int maxY = (int)ceil(qMax(y0, qMax(y1, y2)));
+
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX > width) maxX = width;
+    if (maxY > RASTERHEIGHT) maxY = RASTERHEIGHT;
+    if (minX >= maxX || minY >= maxY) return;
+
+    //edge functions at pixel centers, stepped incrementally
+    double a0 = y1 - y2, b0 = x2 - x1;
+    double a1 = y2 - y0, b1 = x0 - x2;
+    double a2 = y0 - y1, b2 = x1 - x0;
+
+    double px = minX + 0.5;
+    double py = minY + 0.5;
+
+    double row0 = a0 * (px - x1) + b0 * (py - y1);
+    double row1 = a1 * (px - x2) + b1 * (py - y2);
+    double row2 = a2 * (px - x0) + b2 * (py - y0);
+
+    for (int y = minY; y < maxY; y++)
+    {
+        double w0 = row0, w1 = row1, w2 = row2;
+        LookAheadPixels *line = buffer + y * width;
+
+        for (int x = minX; x < maxX; x++)
+        {
+            if (w0 >= 0 && w1 >= 0 && w2 >= 0) line[x] = color;
+            w0 += a0;
+            w1 += a1;
+            w2 += a2;
+        }
+
+        row0 += b0;
+        row1 += b1;
+        row2 += b2;
+    }
+}
+
+void CSectionRaster::drawLine(double x0, double y0, double x1, double y1,
+                              double lineWidth, const LookAheadPixels &color)
+{
+    double dx = x1 - x0;
+    double dy = y1 - y0;
+    double len = sqrt(dx * dx + dy * dy);
+    if (len < 1e-9) return;
+
+    //a line is a quad of lineWidth pixels, like glLineWidth
+    double nx = -dy / len * lineWidth * 0.5;
+    double ny = dx / len * lineWidth * 0.5;
+
+    fillTriangle(x0 + nx, y0 + ny, x0 - nx, y0 - ny, x1 + nx, y1 + ny, color);
+    fillTriangle(x0 - nx, y0 - ny, x1 - nx, y1 - ny, x1 + nx, y1 + ny, color);
+}
@@ -0,0 +1,63 @@
+#ifndef CSECTIONRASTER_H
+#define CSECTIONRASTER_H
+
+#include <QVector3D>
+#include "vec3.h"
+#include "common.h"
+
+class CTool;
+class CBoundary;
+class CHead;
+
+//Software replacement for the old back buffer FBO. Rasterizes the
+//patches, outer boundary and headland into the section lookahead
+//window (tool.rpWidth x RASTERHEIGHT) directly in grnPixels layout,
+//so section control does not need a GL context or a readback.
+class CSectionRaster
+{
+public:
+    //rows of lookahead, row 0 is at the tool, rows go forward
+    static const int RASTERHEIGHT = 245;
+
+    //the same green values processSectionLookahead() looks for
+    static const uchar APPLIEDGREEN = 128;
+    static const uchar BOUNDARYGREEN = 240;
+    static const uchar HEADLANDGREEN = 250;
+
+    CSectionRaster();
+
+    void rasterize(LookAheadPixels *pixels, int numSuperSection,
+                   const CTool &tool, const Vec3 &toolPos,
+                   const CBoundary &bnd, const CHead &hd);
+
+private:
+    LookAheadPixels *buffer;
+    int width;
+
+    //world to raster transform for the current fix
+    double sinH, cosH, scale, colOffset;
+    double originE, originN;
+
+    inline void toRaster(double easting, double northing, double &x, double &y) const
+    {
+        double dE = easting - originE;
+        double dN = northing - originN;
+        x = (dE * cosH - dN * sinH) * scale + colOffset;
+        y = (dE * sinH + dN * cosH) * scale;
+    }
+
+    inline void toWorld(double x, double y, double &easting, double &northing) const
+    {
+        double u = (x - colOffset) / scale;
+        double v = y / scale;
+        easting = originE + u * cosH + v * sinH;
+        northing = originN - u * sinH + v * cosH;
+    }
+
+    void fillTriangle(double x0, double y0, double x1, double y1,
+                      double x2, double y2, const LookAheadPixels &color);
+    void drawLine(double x0, double y0, double x1, double y1,
+                  double lineWidth, const LookAheadPixels &color);
+};
+
+#endif // CSECTIONRASTER_H
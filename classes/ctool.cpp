@@ -4,6 +4,7 @@
 #include "aogsettings.h"
 #include "glutils.h"
 #include "ccamera.h"
+#include "cguidancesnapshot.h"
 
 CTool::CTool()
 {
@@ -38,7 +39,7 @@ CTool::CTool()
     */
 }
 
-void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 &modelview, QMatrix4x4 projection)
+void CTool::drawTool(const CGuidanceState &g, CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 &modelview, QMatrix4x4 projection) const
 {
     USE_SETTINGS;
 
@@ -46,15 +47,15 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
     double hitchLength = SETTINGS_TOOL_HITCHLENGTH;
 
     //translate and rotate at pivot axle, caller's mvp will be changed
-    modelview.translate(v.pivotAxlePos.easting, v.pivotAxlePos.northing, 0);
+    modelview.translate(g.pivotAxlePos.easting, g.pivotAxlePos.northing, 0);
 
     GLHelperOneColor gldraw;
 
     QMatrix4x4 mv = modelview; //push matrix
 
     //translate down to the hitch pin
-    mv.translate(sin(v.fixHeading) * hitchLength,
-                            cos(v.fixHeading) * hitchLength, 0);
+    mv.translate(sin(g.fixHeading) * hitchLength,
+                            cos(g.fixHeading) * hitchLength, 0);
 
     gl->glLineWidth(2.0f);
 
@@ -71,7 +72,7 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
     if (SETTINGS_TOOL_ISTBT && SETTINGS_TOOL_ISTRAILING)
     {
         //rotate to tank heading
-        mv.rotate(glm::toDegrees(-v.tankPos.heading), 0.0, 0.0, 1.0);
+        mv.rotate(glm::toDegrees(-g.tankPos.heading), 0.0, 0.0, 1.0);
 
 
         //draw the tank hitch
@@ -86,14 +87,14 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
 
         //move down the tank hitch, unwind, rotate to section heading
         mv.translate(0.0, trailingTank, 0.0);
-        mv.rotate(glm::toDegrees(v.tankPos.heading), 0.0, 0.0, 1.0);
-        mv.rotate(glm::toDegrees(v.toolPos.heading), 0.0, 0.0, 1.0);
+        mv.rotate(glm::toDegrees(g.tankPos.heading), 0.0, 0.0, 1.0);
+        mv.rotate(glm::toDegrees(g.toolPos.heading), 0.0, 0.0, 1.0);
     }
 
     //no tow between hitch
     else
     {
-        mv.rotate(glm::toDegrees(-v.toolPos.heading), 0.0, 0.0, 1.0);
+        mv.rotate(glm::toDegrees(-g.toolPos.heading), 0.0, 0.0, 1.0);
     }
 
     //draw the hitch if trailing
@@ -113,25 +114,25 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
 
     //lookahead section on
     cv.color = QVector4D(0.20f, 0.7f, 0.2f, 1);
-    cv.vertex = QVector3D(toolFarLeftPosition, (lookAheadDistanceOnPixelsLeft) * 0.1 + trailingTool, 0);
+    cv.vertex = QVector3D(g.toolFarLeftPosition, (g.lookAheadDistanceOnPixelsLeft) * 0.1 + trailingTool, 0);
     gldrawcolors.append(cv);
-    cv.vertex = QVector3D(toolFarRightPosition, (lookAheadDistanceOnPixelsRight) * 0.1 + trailingTool, 0);
+    cv.vertex = QVector3D(g.toolFarRightPosition, (g.lookAheadDistanceOnPixelsRight) * 0.1 + trailingTool, 0);
     gldrawcolors.append(cv);
 
     //lookahead section off
     cv.color = QVector4D(0.70f, 0.2f, 0.2f, 1);
-    cv.vertex = QVector3D(toolFarLeftPosition, (lookAheadDistanceOffPixelsLeft) * 0.1 + trailingTool, 0);
+    cv.vertex = QVector3D(g.toolFarLeftPosition, (g.lookAheadDistanceOffPixelsLeft) * 0.1 + trailingTool, 0);
     gldrawcolors.append(cv);
-    cv.vertex = QVector3D(toolFarRightPosition, (lookAheadDistanceOffPixelsRight) * 0.1 + trailingTool, 0);
+    cv.vertex = QVector3D(g.toolFarRightPosition, (g.lookAheadDistanceOffPixelsRight) * 0.1 + trailingTool, 0);
     gldrawcolors.append(cv);
 
 
     if (SETTINGS_VEHICLE_ISHYDLIFTON)
     {
         cv.color = QVector4D(0.70f, 0.2f, 0.72f, 1);
-        cv.vertex = QVector3D(section[0].positionLeft, (v.hydLiftLookAheadDistanceLeft * 0.1) + trailingTool, 0);
+        cv.vertex = QVector3D(g.section[0].positionLeft, (g.hydLiftLookAheadDistanceLeft * 0.1) + trailingTool, 0);
         gldrawcolors.append(cv);
-        cv.vertex = QVector3D(section[numOfSections - 1].positionRight, (v.hydLiftLookAheadDistanceRight * 0.1) + trailingTool, 0);
+        cv.vertex = QVector3D(g.section[numOfSections - 1].positionRight, (g.hydLiftLookAheadDistanceRight * 0.1) + trailingTool, 0);
         gldrawcolors.append(cv);
     }
 
@@ -142,15 +143,15 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
     gl->glLineWidth(4);
 
     //draw super section line
-    if (section[numOfSections].isSectionOn)
+    if (g.section[numOfSections].isSectionOn)
     {
-        if (section[0].manBtnState == btnStates::Auto) cv.color=QVector4D(0.50f, 0.97f, 0.950f, 1.0);
+        if (g.section[0].manBtnState == btnStates::Auto) cv.color=QVector4D(0.50f, 0.97f, 0.950f, 1.0);
         else cv.color = QVector4D(0.99, 0.99, 0, 1.0);
 
-        cv.vertex = QVector3D( section[numOfSections].positionLeft, trailingTool, 0);
+        cv.vertex = QVector3D( g.section[numOfSections].positionLeft, trailingTool, 0);
         gldrawcolors.append(cv);
 
-        cv.vertex = QVector3D( section[numOfSections].positionRight, trailingTool, 0);
+        cv.vertex = QVector3D( g.section[numOfSections].positionRight, trailingTool, 0);
         gldrawcolors.append(cv);
     }
     else
@@ -159,9 +160,9 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
         {
 
             //if section is on, green, if off, red color
-            if (section[j].isSectionOn)
+            if (g.section[j].isSectionOn)
             {
-                if (section[j].manBtnState == btnStates::Auto) cv.color = QVector4D(0.0f, 0.9f, 0.0f, 1.0f);
+                if (g.section[j].manBtnState == btnStates::Auto) cv.color = QVector4D(0.0f, 0.9f, 0.0f, 1.0f);
                 else cv.color = QVector4D(0.97, 0.97, 0, 1.0f);
             }
             else
@@ -170,9 +171,9 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
             }
 
             //draw section line
-            cv.vertex = QVector3D(section[j].positionLeft, trailingTool, 0);
+            cv.vertex = QVector3D(g.section[j].positionLeft, trailingTool, 0);
             gldrawcolors.append(cv);
-            cv.vertex = QVector3D(section[j].positionRight, trailingTool, 0);
+            cv.vertex = QVector3D(g.section[j].positionRight, trailingTool, 0);
             gldrawcolors.append(cv);
         }
     }
@@ -185,7 +186,7 @@ void CTool::drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix
         gldraw.clear();
         //section markers
         for (int j = 0; j < numOfSections - 1; j++)
-            gldraw.append(QVector3D(section[j].positionRight, trailingTool, 0));
+            gldraw.append(QVector3D(g.section[j].positionRight, trailingTool, 0));
 
         gldraw.draw(gl,projection*mv,QColor::fromRgbF(0,0,0),GL_POINTS,3.0f);
     }
@@ -3,12 +3,14 @@
 
 #include <QString>
 #include "csection.h"
+#include "cpatchindex.h"
 #include "common.h"
 
 class QOpenGLFunctions;
 class QMatrix4x4;
 class CVehicle;
 class CCamera;
+struct CGuidanceState;
 
 class CTool
 {
@@ -61,11 +63,15 @@ public:
     //list of the list of patch data individual triangles for field sections
     QVector<QSharedPointer<QVector<QVector3D>>> patchSaveList;
 
+    //every sealed patch of every section, for culling
+    CPatchIndex patchIndex;
+
     void sectionCalcWidths();
     void sectionSetPositions();
 
     CTool();
-    void drawTool(CVehicle &v, CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 &modelview, QMatrix4x4 projection);
+    //draws the tool as it was at the last fix
+    void drawTool(const CGuidanceState &g, CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 &modelview, QMatrix4x4 projection) const;
 };
 
 #endif // CTOOL_H
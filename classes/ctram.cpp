@@ -7,6 +7,7 @@
 #include "cboundary.h"
 #include "aogsettings.h"
 #include "glm.h"
+#include "cpolygonoffset.h"
 
 //TODO: move all these to own file, centralize the names we're using
 //      to refer to settings
@@ -23,24 +24,23 @@ CTram::CTram()
     //abOffset = (tool->toolWidth - tool->toolOverlap) / 2.0;
     abOffset = 0;
     displayMode = 0;
+    generation = nextGeometryGeneration();
 }
 
 void CTram::drawTramBnd(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
 {
     if(tramBndArr.size() > 0) {
-        QOpenGLBuffer tramBuffer;
-        QVector<QVector3D> vertices;
-        for (int h = 0; h < tramBndArr.size(); h++)
-            vertices.append(QVector3D(tramBndArr[h].easting, tramBndArr[h].northing, 0));
-
-        tramBuffer.create();
-        tramBuffer.bind();
-        tramBuffer.allocate(vertices.data(), tramBndArr.size() * sizeof(QVector3D));
-        tramBuffer.release();
-
-        glDrawArraysColor(gl, mvp, GL_TRIANGLE_STRIP,
-                          QColor::fromRgbF(0.8630f, 0.73692f, 0.60f, 0.25),
-                          tramBuffer,GL_SHORT,tramBndArr.size(),1.0f);
+        if (!isGeometryCurrent(this, generation))
+        {
+            QVector<QVector3D> vertices;
+            for (int h = 0; h < tramBndArr.size(); h++)
+                vertices.append(QVector3D(tramBndArr[h].easting, tramBndArr[h].northing, 0));
+
+            uploadGeometry(this, generation, vertices);
+        }
+
+        drawGeometry(gl, mvp, this, QColor::fromRgbF(0.8630f, 0.73692f, 0.60f, 0.25),
+                     GL_TRIANGLE_STRIP, 1.0f);
     }
 }
 
@@ -58,66 +58,18 @@ void CTram::buildTramBnd(const CBoundary &bnd)
     {
         outArr.clear();
         tramBndArr.clear();
+
+        //empties the index too, or the old field would still be inside
+        preCalcTurnLines();
     }
+
+    generation = nextGeometryGeneration();
 }
 
 void CTram::createBndTramRef(const CBoundary &bnd)
 {
-    //count the points from the boundary
-    int ptCount = bnd.bndArr[0].bndLine.size();
-    outArr.clear();
-
-    //outside point
-    Vec3 pt3;
-
-    double distSq = ((tramWidth * 0.5) - halfWheelTrack) * ((tramWidth * 0.5) - halfWheelTrack) * 0.97;
-    bool fail = false;
-
-    //make the boundary tram outer array
-    for (int i = 0; i < ptCount; i++)
-    {
-        //calculate the point inside the boundary
-        pt3.easting = bnd.bndArr[0].bndLine[i].easting -
-            (sin(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * (tramWidth * 0.5 - halfWheelTrack));
-
-        pt3.northing = bnd.bndArr[0].bndLine[i].northing -
-            (cos(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * (tramWidth * 0.5 - halfWheelTrack));
-
-        for (int j = 0; j < ptCount; j++)
-        {
-            double check = glm::distanceSquared(pt3.northing, pt3.easting,
-                                bnd.bndArr[0].bndLine[j].northing, bnd.bndArr[0].bndLine[j].easting);
-            if (check < distSq)
-            {
-                fail = true;
-                break;
-            }
-        }
-
-        if (!fail)
-        {
-            pt3.heading = bnd.bndArr[0].bndLine[i].heading;
-            outArr.append(pt3);
-        }
-        fail = false;
-    }
-
-    int cnt = outArr.size();
-    if (cnt < 6) return;
-
-    const double spacing = 2.0;
-    double distance;
-    for (int i = 0; i < cnt - 1; i++)
-    {
-        distance = glm::distance(outArr[i], outArr[i + 1]);
-        if (distance < spacing)
-        {
-            outArr.removeAt(i + 1);
-            cnt = outArr.size();
-            i--;
-        }
-    }
-
+    //the boundary tram outer array, in from the boundary to the outside wheel
+    outArr = CPolygonOffset::offset(bnd.bndArr[0].bndLine, -(tramWidth * 0.5 - halfWheelTrack), 2.0, 0);
 }
 
 void CTram::createOuterTram()
@@ -147,25 +99,12 @@ void CTram::createOuterTram()
         }
     }
 
+    generation = nextGeometryGeneration();
 }
 
 bool CTram::isPointInTramBndArea(Vec2 testPointv2)
 {
-    if (calcList.size() < 3) return false;
-    int j = outArr.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < outArr.size(); j = i++)
-    {
-        if ((outArr[i].northing < testPointv2.northing && outArr[j].northing >= testPointv2.northing)
-        ||  (outArr[j].northing < testPointv2.northing && outArr[i].northing >= testPointv2.northing))
-        {
-            oddNodes ^= ((testPointv2.northing * calcList[i].northing) + calcList[i].easting < testPointv2.easting);
-        }
-    }
-    return oddNodes; //true means inside.
-
+    return calcIndex.contains(testPointv2); //true means inside.
 }
 
 void CTram::preCalcTurnLines()
@@ -194,4 +133,6 @@ void CTram::preCalcTurnLines()
             calcList.append(constantMultiple);
         }
     }
+
+    calcIndex.build(outArr, calcList);
 }
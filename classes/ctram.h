@@ -4,6 +4,7 @@
 #include <QVector>
 #include <QMatrix4x4>
 #include "vec2.h"
+#include "cpolygonindex.h"
 #include "vec3.h"
 
 class CTool;
@@ -19,12 +20,17 @@ public:
 
     //the list of constants and multiples of the boundary
     QVector<Vec2> calcList;
+    //slabs over the same edges for the inside tests
+    CPolygonIndex calcIndex;
 
     //the outer ring of boundary tram - also used for clipping
     QVector<Vec3> outArr;
 
     //the triangle strip of the outer tram highlight
     QVector<Vec2> tramBndArr;
+    //new every time the points are rebuilt, so the GPU copy of the
+    //line is only uploaded again after an edit or load
+    int generation;
 
     //tram settings
     double wheelTrack;
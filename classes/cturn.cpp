@@ -2,6 +2,7 @@
 #include <QOpenGLFunctions>
 #include <QMatrix4x4>
 #include <math.h>
+#include <algorithm>
 #include "glm.h"
 #include "glutils.h"
 #include "vec3.h"
@@ -9,6 +10,7 @@
 #include "aogsettings.h"
 #include "cboundary.h"
 #include "cfielddata.h"
+#include "cpolygonoffset.h"
 #include "common.h"
 
 CTurn::CTurn(QObject *parent) : QObject(parent)
@@ -29,50 +31,20 @@ CTurn::CTurn(QObject *parent) : QObject(parent)
 //called only by CYouTurn
 void CTurn::findClosestTurnPoint(const CBoundary &bnd, bool isYouTurnRight, Vec3 fromPt, double headAB)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
+    double tool_toolWidth = snapshot->toolWidth;
 
     //initial scan is straight ahead of pivot point of vehicle to find the right turnLine/boundary
-    Vec3 pt;
     Vec3 rayPt;
+    int closestTurnNum = rayCastTurnLines(bnd, fromPt, headAB, 1500, rayPt);
 
-    bool isFound = false;
-    int closestTurnNum = 99;
-
-    double cosHead = cos(headAB);
-    double sinHead = sin(headAB);
-
-    for (int b = 1; b < 1500; b += 2)
+    //no turn line ahead at all
+    if (closestTurnNum < 0)
     {
-        pt.easting = fromPt.easting + (sinHead * b);
-        pt.northing = fromPt.northing + (cosHead * b);
-
-        if (turnArr[0].isPointInTurnWorkArea(pt))
-        {
-            for (int t = 1; t < bnd.bndArr.size(); t++)
-            {
-                if (!bnd.bndArr[t].isSet) continue;
-                if (bnd.bndArr[t].isDriveThru) continue;
-                if (bnd.bndArr[t].isDriveAround) continue;
-                if (turnArr[t].isPointInTurnWorkArea(pt))
-                {
-                    isFound = true;
-                    closestTurnNum = t;
-                    rayPt.easting = pt.easting;
-                    rayPt.northing = pt.northing;
-                    break;
-                }
-            }
-            if (isFound) break;
-        }
-        else
-        {
-            closestTurnNum = 0;
-            rayPt.easting = pt.easting;
-            rayPt.northing = pt.northing;
-            break;
-        }
+        turnClosestList.clear();
+        closestTurnPt = Vec3(-20000, -20000, 0);
+        return;
     }
 
     //second scan is straight ahead of outside of tool based on turn direction
@@ -188,34 +160,47 @@ void CTurn::findClosestTurnPoint(const CBoundary &bnd, bool isYouTurnRight, Vec3
             turnClosestList.append(inBox);
         }
     }
-    //which of the points is closest
-    //closestTurnPt.easting = -20000; closestTurnPt.northing = -20000;
-    ptCount = turnClosestList.size();
-    if (ptCount != 0)
+    //the boxes only scan the turn line the ray hit, so any point in them
+    //means the tool's outside edge runs into that same line. Use the
+    //exact crossing straight ahead then, and the heading of the segment
+    //it crosses, rather than the nearest vertex and its heading.
+    if (turnClosestList.size() != 0)
     {
-        double totalDist = 0.75 * sqrt(((fromPt.easting - rayPt.easting) * (fromPt.easting - rayPt.easting))
-        + ((fromPt.northing - rayPt.northing) * (fromPt.northing - rayPt.northing)));
+        closestTurnPt = rayPt;
+        if (closestTurnPt.heading < 0) closestTurnPt.heading += glm::twoPI;
+    }
+}
 
-        //determine closest point
-        double minDistance = 9999999;
-        for (int i = 0; i < ptCount; i++)
-        {
-            double dist = sqrt(((fromPt.easting - turnClosestList[i].easting) * (fromPt.easting - turnClosestList[i].easting))
-                            + ((fromPt.northing - turnClosestList[i].northing) * (fromPt.northing - turnClosestList[i].northing)));
+int CTurn::rayCastTurnLines(const CBoundary &bnd, Vec3 fromPt, double heading,
+                            double maxDistance, Vec3 &crossing) const
+{
+    int turnNum = -1;
+    double distance, edgeHeading;
+    int edgeIndex;
 
-            //double distRay = ((rayPt.easting - turnClosestList[i].easting) * (rayPt.easting - turnClosestList[i].easting))
-            //                + ((rayPt.northing - turnClosestList[i].northing) * (rayPt.northing - turnClosestList[i].northing));
+    //each line keeps cutting the ray down, so the last hit is the first crossing
+    for (int t = 0; t < turnArr.size(); t++)
+    {
+        if (t > 0)
+        {
+            if (t >= bnd.bndArr.size()) break;
+            if (!bnd.bndArr[t].isSet) continue;
+            if (bnd.bndArr[t].isDriveThru) continue;
+            if (bnd.bndArr[t].isDriveAround) continue;
+        }
 
-            if (minDistance >= dist && dist > totalDist)
-            {
-                minDistance = dist;
-                closestTurnPt.easting = turnClosestList[i].easting;
-                closestTurnPt.northing = turnClosestList[i].northing;
-                closestTurnPt.heading = turnClosestList[i].heading;
-            }
+        if (turnArr[t].calcIndex.rayCast(fromPt.easting, fromPt.northing, heading, maxDistance,
+                                         distance, edgeHeading, edgeIndex))
+        {
+            maxDistance = distance;
+            turnNum = t;
+            crossing.easting = fromPt.easting + sin(heading) * distance;
+            crossing.northing = fromPt.northing + cos(heading) * distance;
+            crossing.heading = edgeHeading;
         }
-        if (closestTurnPt.heading < 0) closestTurnPt.heading += glm::twoPI;
     }
+
+    return turnNum;
 }
 
 //not currently called from anywhere
@@ -265,57 +250,29 @@ void CTurn::buildTurnLines(const CBoundary &bnd, CFieldData &fd)
         return;
     }
 
-    //to fill the list of line points
-    Vec3 point;
-
     //determine how wide a headland space
     double totalHeadWidth = youTurnTriggerDistanceOffset;
 
-    //outside boundary - count the points from the boundary
-    turnArr[0].turnLine.clear();
-    int ptCount = bnd.bndArr[0].bndLine.size();
-    for (int i = ptCount - 1; i >= 0; i--)
-    {
-        //calculate the point inside the boundary
-        point.easting = bnd.bndArr[0].bndLine[i].easting + (-sin(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * totalHeadWidth);
-        point.northing = bnd.bndArr[0].bndLine[i].northing + (-cos(glm::PIBy2 + bnd.bndArr[0].bndLine[i].heading) * totalHeadWidth);
-        point.heading = bnd.bndArr[0].bndLine[i].heading;
-        if (point.heading < -glm::twoPI) point.heading += glm::twoPI;
-
-        //only add if inside actual field boundary
-        if (bnd.bndArr[0].isPointInsideBoundary(point))
-        {
-            Vec3 tPnt(point.easting, point.northing, point.heading);
-            turnArr[0].turnLine.append(tPnt);
-        }
-    }
-    turnArr[0].fixTurnLine(totalHeadWidth, bnd.bndArr[0].bndLine, tool_toolWidth * 0.25);
+    //turn lines are wound the opposite way of their boundary
+    QVector<Vec3> ring;
+
+    //outside boundary shrunk by the headland
+    ring = bnd.bndArr[0].bndLine;
+    std::reverse(ring.begin(), ring.end());
+    turnArr[0].turnLine = CPolygonOffset::offset(ring, -totalHeadWidth,
+                                                 tool_toolWidth * 0.25, tool_toolWidth * 0.25 * 1.25);
     turnArr[0].preCalcTurnLines();
 
-    //inside boundaries
+    //inside boundaries grown by the headland
     for (int j = 1; j < bnd.bndArr.size(); j++)
     {
         turnArr[j].turnLine.clear();
         if (!bnd.bndArr[j].isSet || bnd.bndArr[j].isDriveThru || bnd.bndArr[j].isDriveAround) continue;
 
-        ptCount = bnd.bndArr[j].bndLine.size();
-
-        for (int i = ptCount - 1; i >= 0; i--)
-        {
-            //calculate the point outside the boundary
-            point.easting = bnd.bndArr[j].bndLine[i].easting + (-sin(glm::PIBy2 + bnd.bndArr[j].bndLine[i].heading) * totalHeadWidth);
-            point.northing = bnd.bndArr[j].bndLine[i].northing + (-cos(glm::PIBy2 + bnd.bndArr[j].bndLine[i].heading) * totalHeadWidth);
-            point.heading = bnd.bndArr[j].bndLine[i].heading;
-            if (point.heading < -glm::twoPI) point.heading += glm::twoPI;
-
-            //only add if outside actual field boundary
-            if (!bnd.bndArr[j].isPointInsideBoundary(point))
-            {
-                Vec3 tPnt(point.easting, point.northing, point.heading);
-                turnArr[j].turnLine.append(tPnt);
-            }
-        }
-        turnArr[j].fixTurnLine(totalHeadWidth, bnd.bndArr[j].bndLine, tool_toolWidth * 0.4);
+        ring = bnd.bndArr[j].bndLine;
+        std::reverse(ring.begin(), ring.end());
+        turnArr[j].turnLine = CPolygonOffset::offset(ring, totalHeadWidth,
+                                                     tool_toolWidth * 0.4, tool_toolWidth * 0.4 * 1.25);
         turnArr[j].preCalcTurnLines();
     }
 
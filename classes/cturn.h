@@ -35,6 +35,13 @@ public:
     explicit CTurn(QObject *parent = NULL);
 
     void findClosestTurnPoint(const CBoundary &bnd, bool isYouTurnRight, Vec3 fromPt, double headAB);
+
+    //exact first crossing of the ray with the outer turn line or an inner
+    //one that gets turned at. Returns the turn number, -1 if there is none
+    //within maxDistance. crossing.heading is the heading of the turn line there.
+    int rayCastTurnLines(const CBoundary &bnd, Vec3 fromPt, double heading,
+                         double maxDistance, Vec3 &crossing) const;
+
     bool pointInsideWorkArea(const CBoundary &bnd, Vec2 pt);
     void resetTurnLines();
     void buildTurnLines(const CBoundary &bnd, CFieldData &fd);
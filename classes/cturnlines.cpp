@@ -8,7 +8,7 @@
 
 CTurnLines::CTurnLines()
 {
-
+    generation = nextGeometryGeneration();
 }
 
 void CTurnLines::calculateTurnHeadings()
@@ -42,82 +42,19 @@ void CTurnLines::calculateTurnHeadings()
     pt3.heading = atan2(arr[0].easting - arr[cnt - 1].easting, arr[0].northing - arr[cnt - 1].northing);
     if (pt3.heading < 0) pt3.heading += glm::twoPI;
     turnLine.append(pt3);
+
+    generation = nextGeometryGeneration();
 }
 
 void CTurnLines::resetTurn()
 {
     calcList.clear();
+    calcIndex.clear();
     turnLine.clear();
-}
-
-void CTurnLines::fixTurnLine(double totalHeadWidth, const QVector<Vec3> &curBnd, double spacing)
-{
-    //count the points from the boundary
-    int lineCount = turnLine.size();
-    double distance = 0;
-
-    //int headCount = mf.bndArr[inTurnNum].bndLine.size();
-    int bndCount = curBnd.size();
-
-    //remove the points too close to boundary
-    for (int i = 0; i < bndCount; i++)
-    {
-        for (int j = 0; j < lineCount; j++)
-        {
-            //make sure distance between headland and boundary is not less then width
-            distance = glm::distance(curBnd[i], turnLine[j]);
-            if (distance < (totalHeadWidth * 0.96))
-            {
-                turnLine.removeAt(j);
-                lineCount = turnLine.size();
-                j = -1;
-            }
-        }
-    }
-
-    //make sure distance isn't too small between points on turnLine
-    bndCount = turnLine.size();
-
-    //double spacing = mf.tool.toolWidth * 0.25;
-    for (int i = 0; i < bndCount - 1; i++)
-    {
-        distance = glm::distance(turnLine[i], turnLine[i + 1]);
-        if (distance < spacing)
-        {
-            turnLine.removeAt(i + 1);
-            bndCount = turnLine.size();
-            i--;
-        }
-    }
-
-    //make sure distance isn't too big between points on Turn
-    bndCount = turnLine.size();
-    for (int i = 0; i < bndCount; i++)
-    {
-        int j = i + 1;
-        if (j == bndCount) j = 0;
-        distance = glm::distance(turnLine[i], turnLine[j]);
-        if (distance > (spacing * 1.25))
-        {
-            Vec3 pointB = Vec3((turnLine[i].easting + turnLine[j].easting) / 2.0, (turnLine[i].northing + turnLine[j].northing) / 2.0, turnLine[i].heading);
-
-            turnLine.insert(j, pointB);
-            bndCount = turnLine.size();
-            i--;
-        }
-    }
-
-    //make sure headings are correct for calculated points
-
-    //Tate Button contributed this bug fix.
-    if (turnLine.size() > 0)
-    {
-        calculateTurnHeadings();
-    }
 
+    generation = nextGeometryGeneration();
 }
 
-
 void CTurnLines::preCalcTurnLines()
 {
     int j = turnLine.size() - 1;
@@ -144,42 +81,20 @@ void CTurnLines::preCalcTurnLines()
             calcList.append(constantMultiple);
         }
     }
+
+    calcIndex.build(turnLine, calcList);
+
+    generation = nextGeometryGeneration();
 }
 
 bool CTurnLines::isPointInTurnWorkArea(Vec3 testPointv3)
 {
-    if (calcList.size() < 3) return false;
-    int j = turnLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < turnLine.size(); j = i++)
-    {
-        if ((turnLine[i].northing < testPointv3.northing && turnLine[j].northing >= testPointv3.northing)
-        || (turnLine[j].northing < testPointv3.northing && turnLine[i].northing >= testPointv3.northing))
-        {
-            oddNodes ^= ((testPointv3.northing * calcList[i].northing) + calcList[i].easting < testPointv3.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv3); //true means inside.
 }
 
 bool CTurnLines::isPointInTurnWorkArea(Vec2 testPointv2)
 {
-    if (calcList.size() < 3) return false;
-    int j = turnLine.size() - 1;
-    bool oddNodes = false;
-
-    //test against the constant and multiples list the test point
-    for (int i = 0; i < turnLine.size(); j = i++)
-    {
-        if ((turnLine[i].northing < testPointv2.northing && turnLine[j].northing >= testPointv2.northing)
-        || (turnLine[j].northing < testPointv2.northing && turnLine[i].northing >= testPointv2.northing))
-        {
-            oddNodes ^= ((testPointv2.northing * calcList[i].northing) + calcList[i].easting < testPointv2.easting);
-        }
-    }
-    return oddNodes; //true means inside.
+    return calcIndex.contains(testPointv2); //true means inside.
 }
 
 void CTurnLines::drawTurnLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
@@ -188,13 +103,17 @@ void CTurnLines::drawTurnLine(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
     int ptCount = turnLine.size();
     if (ptCount < 1) return;
 
-    GLHelperOneColor gldraw;
+    if (!isGeometryCurrent(this, generation))
+    {
+        QVector<QVector3D> vertices;
 
+        for (int h = 0; h < ptCount; h++)
+            vertices.append(QVector3D(turnLine[h].easting, turnLine[h].northing, 0));
 
-    for (int h = 0; h < ptCount; h++)
-        gldraw.append(QVector3D(turnLine[h].easting, turnLine[h].northing, 0));
+        vertices.append(QVector3D(turnLine[0].easting, turnLine[0].northing, 0));
 
-    gldraw.append(QVector3D(turnLine[0].easting, turnLine[0].northing, 0));
+        uploadGeometry(this, generation, vertices);
+    }
 
-    gldraw.draw(gl,mvp,QColor::fromRgbF(0.8555f, 0.9232f, 0.60f),GL_POINTS,2.0f);
+    drawGeometry(gl, mvp, this, QColor::fromRgbF(0.8555f, 0.9232f, 0.60f), GL_POINTS, 2.0f);
 }
@@ -4,6 +4,7 @@
 #include <QVector>
 #include "vec3.h"
 #include "vec2.h"
+#include "cpolygonindex.h"
 
 class QOpenGLFunctions;
 class QMatrix4x4;
@@ -16,12 +17,16 @@ public:
 
     //the list of constants and multiples of the boundary
     QVector<Vec2> calcList;
+    //slabs over the same edges for the inside tests
+    CPolygonIndex calcIndex;
+    //new every time the points are rebuilt, so the GPU copy of the
+    //line is only uploaded again after an edit or load
+    int generation;
 
     CTurnLines();
 
     void calculateTurnHeadings();
     void resetTurn();
-    void fixTurnLine(double totalHeadWidth, const QVector<Vec3> &curBnd, double spacing);
     void preCalcTurnLines();
     bool isPointInTurnWorkArea(Vec3 testPointv3);
     bool isPointInTurnWorkArea(Vec2 testPointv2);
@@ -14,6 +14,7 @@
 #include "cabline.h"
 #include "cabcurve.h"
 #include "ccontour.h"
+#include "cguidancesnapshot.h"
 
 CVehicle::CVehicle(QObject *parent) : QObject(parent)
 {
@@ -23,16 +24,16 @@ CVehicle::CVehicle(QObject *parent) : QObject(parent)
 //called from various Classes, always needs current speed
 double CVehicle::updateGoalPointDistance(CNMEA &pn, double distanceFromCurrentLine)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
     //how far should goal point be away  - speed * seconds * kmph -> m/s then limit min value
-    double goalPointDistance = pn.speed * SETTINGS_VEHICLE_GOALPOINTLOOKAHEAD * 0.27777777;
+    double goalPointDistance = pn.speed * snapshot->vehicleGoalPointLookAhead * 0.27777777;
 
     if (distanceFromCurrentLine < 1.0)
-        goalPointDistance += distanceFromCurrentLine * goalPointDistance * SETTINGS_VEHICLE_DISTANCEMULTIPLIER;
+        goalPointDistance += distanceFromCurrentLine * goalPointDistance * snapshot->vehicleDistanceMultiplier;
     else
-        goalPointDistance += goalPointDistance * SETTINGS_VEHICLE_DISTANCEMULTIPLIER;
+        goalPointDistance += goalPointDistance * snapshot->vehicleDistanceMultiplier;
 
-    if (goalPointDistance < SETTINGS_VEHICLE_LOOKAHEADMINIMUM) goalPointDistance = SETTINGS_VEHICLE_LOOKAHEADMINIMUM;
+    if (goalPointDistance < snapshot->vehicleLookAheadMinimum) goalPointDistance = snapshot->vehicleLookAheadMinimum;
 
     //emit setLookAheadGoal(goalPointDistance);
     //mf.lookaheadActual = goalPointDistance; //mf.lookaheadActual is unused
@@ -41,17 +42,14 @@ double CVehicle::updateGoalPointDistance(CNMEA &pn, double distanceFromCurrentLi
 
 }
 
-void CVehicle::drawVehicle(QOpenGLFunctions *gl, QMatrix4x4 modelview,
-                           QMatrix4x4 projection,
-                           const CCamera &camera,
-                           CBoundary &bnd, CHead &hd,
-                           const CContour &ct,
-                           const CABCurve &curve, const CABLine &ABLine)
+void CVehicle::drawVehicle(const CGuidanceState &g, QOpenGLFunctions *gl,
+                           QMatrix4x4 modelview, QMatrix4x4 projection,
+                           const CCamera &camera, CBoundary &bnd) const
 {
     USE_SETTINGS;
 
     //draw vehicle
-    modelview.rotate(glm::toDegrees(-fixHeading), 0.0, 0.0, 1.0);
+    modelview.rotate(glm::toDegrees(-g.fixHeading), 0.0, 0.0, 1.0);
 
     GLHelperColors glcolors;
     GLHelperOneColor gldraw;
@@ -97,7 +95,7 @@ void CVehicle::drawVehicle(QOpenGLFunctions *gl, QMatrix4x4 modelview,
     }
     else
     {
-        if (hd.isToolUp)
+        if (g.isToolUp)
         {
             gldraw.append(QVector3D(0, SETTINGS_VEHICLE_ANTENNAPIVOT, -0.0));
             gldraw.append(QVector3D(1.0, -0, 0.0));
@@ -167,16 +165,16 @@ void CVehicle::drawVehicle(QOpenGLFunctions *gl, QMatrix4x4 modelview,
         }
     }
 
-    if (curve.isBtnCurveOn && !ct.isContourBtnOn)
+    if (g.isBtnCurveOn && !g.isContourBtnOn)
     {
         drawTextVehicle(camera, gl, mvp, 0, SETTINGS_VEHICLE_WHEELBASE,
-                        locale.toString(curve.curveNumber), 1.5,
+                        locale.toString(g.curveNumber), 1.5,
                         true, QColor::fromRgbF(0.969, 0.95, 0.9510, 0.87));
     }
-    else if (ABLine.isBtnABLineOn && !ct.isContourBtnOn)
+    else if (g.isBtnABLineOn && !g.isContourBtnOn)
     {
         drawTextVehicle(camera, gl, mvp, 0, SETTINGS_VEHICLE_WHEELBASE,
-                        locale.toString(ABLine.passNumber), 1.5,
+                        locale.toString(g.passNumber), 1.5,
                         true, QColor::fromRgbF(0.969, 0.95, 0.9510, 0.87));
     }
 
@@ -21,6 +21,7 @@ class CCamera;
 class CABCurve;
 class CABLine;
 class CContour;
+struct CGuidanceState;
 
 class CVehicle: public QObject
 {
@@ -77,7 +78,8 @@ public:
 
     explicit CVehicle(QObject *parent = 0);
     double updateGoalPointDistance(CNMEA &pn, double distanceFromCurrentLine);
-    void drawVehicle(QOpenGLFunctions *gl, QMatrix4x4 modelview, QMatrix4x4 projection, const CCamera &camera, CBoundary &bnd, CHead &hd, const CContour &ct, const CABCurve &curve, const CABLine &ABLine);
+    //draws the vehicle as it was at the last fix
+    void drawVehicle(const CGuidanceState &g, QOpenGLFunctions *gl, QMatrix4x4 modelview, QMatrix4x4 projection, const CCamera &camera, CBoundary &bnd) const;
 
 
 signals:
@@ -51,6 +51,7 @@ void CWorldGrid::drawFieldSurface(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, Q
         if (fieldBuffer.isCreated())
             fieldBuffer.destroy();
         fieldBuffer.create();
+        glFrameStats.buffersCreated++;
         fieldBuffer.bind();
         fieldBuffer.allocate(field, sizeof(SurfaceVertex) * 4);
         fieldBuffer.release();
@@ -107,6 +108,7 @@ void CWorldGrid::drawWorldGrid(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, doub
         if (gridBuffer.isCreated())
             gridBuffer.destroy();
         gridBuffer.create();
+        glFrameStats.buffersCreated++;
         gridBuffer.bind();
         gridBuffer.allocate(vertices.data(),vertices.count() * sizeof(QVector3D));
         gridBuffer.release();
@@ -16,7 +16,20 @@
 #include "glutils.h"
 #include "common.h"
 #include "cgeofence.h"
+#include "cguidancesnapshot.h"
 
+//how far the turn line crossing can move before the turn is planned again
+static const double ytPlanTolerance = 0.5;
+
+//distance of a point ahead of and to the right of fromPt along head
+static inline void alongAcross(Vec3 fromPt, double easting, double northing, double head,
+                               double &along, double &across)
+{
+    double dE = easting - fromPt.easting;
+    double dN = northing - fromPt.northing;
+    along = dE * sin(head) + dN * cos(head);
+    across = dE * cos(head) - dN * sin(head);
+}
 
 //constructor
 CYouTurn::CYouTurn(QObject *parent) : QObject(parent)
@@ -161,9 +174,9 @@ bool CYouTurn::findCurveTurnPoints(const CABCurve &curve, const CBoundary &bnd,
 
 void CYouTurn::addSequenceLines(double head, Vec3 pivot)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int youTurnStartOffset = SETTINGS_VEHICLE_YOUTURNDISTANCE;
+    int youTurnStartOffset = snapshot->vehicleYouTurnDistance;
 
     Vec3 pt;
     for (int a = 0; a < youTurnStartOffset*2; a++)
@@ -209,10 +222,10 @@ bool CYouTurn::buildDriveAround(const CABLine &ABLine,
                                 const CBoundary &bnd, CMazeGrid &mazeGrid,
                                 double minFieldX, double minFieldY)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int youTurnStartOffset = SETTINGS_VEHICLE_YOUTURNDISTANCE;
-    double minTurningRadius = SETTINGS_VEHICLE_MINTURNINGRADIUS;
+    int youTurnStartOffset = snapshot->vehicleYouTurnDistance;
+    double minTurningRadius = snapshot->vehicleMinTurningRadius;
 
     double headAB = ABLine.abHeading;
     if (!ABLine.isABSameAsVehicleHeading) headAB += M_PI;
@@ -325,27 +338,30 @@ bool CYouTurn::buildABLineDubinsYouTurn(const CVehicle &vehicle,
                                         double minFieldX, double minFieldY,
                                         bool isTurnRight)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
 
-    double minTurningRadius = SETTINGS_VEHICLE_MINTURNINGRADIUS;
-    int rowSkipsWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    double minTurningRadius = snapshot->vehicleMinTurningRadius;
+    int rowSkipsWidth = snapshot->vehicleYouSkipWidth;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
     double headAB = ABLine.abHeading;
     if (!ABLine.isABSameAsVehicleHeading) headAB += M_PI;
 
+    //grab the pure pursuit point right on ABLine
+    Vec3 onPurePoint(ABLine.rEastAB, ABLine.rNorthAB, 0);
+
     if (youTurnPhase == 0)
     {
         if (buildDriveAround(ABLine, gf, turn, bnd, mazeGrid, minFieldX, minFieldY )) return true;
 
-        //grab the pure pursuit point right on ABLine
-        Vec3 onPurePoint(ABLine.rEastAB, ABLine.rNorthAB, 0);
+        //same turn as last time, still ahead of us
+        if (restoreABLineTurn(turn, ABLine, onPurePoint, headAB)) return true;
 
         //how far are we from any turn boundary
-        turn.findClosestTurnPoint(bnd, isYouTurnRight, onPurePoint, headAB);
+        findABLineTurnPoint(bnd, turn, ABLine, onPurePoint, headAB);
 
         //or did we lose the turnLine - we are on the highway cuz we left the outer/inner turn boundary
         if ((int)turn.closestTurnPt.easting != -20000)
@@ -586,6 +602,8 @@ bool CYouTurn::buildABLineDubinsYouTurn(const CVehicle &vehicle,
             }
             break;
     }
+
+    if (youTurnPhase == 3) saveABLineTurn(turn, ABLine, onPurePoint, headAB);
     return true;
 }
 
@@ -594,13 +612,13 @@ bool CYouTurn::buildABLinePatternYouTurn(const CVehicle &vehicle,
                                          const CABLine &ABLine, CTurn &turn,
                                          bool isTurnRight)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int youTurnStartOffset = SETTINGS_VEHICLE_YOUTURNDISTANCE;
-    int rowSkipsWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    int youTurnStartOffset = snapshot->vehicleYouTurnDistance;
+    int rowSkipsWidth = snapshot->vehicleYouSkipWidth;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
     double headAB = ABLine.abHeading;
     if (!ABLine.isABSameAsVehicleHeading) headAB += M_PI;
@@ -608,8 +626,11 @@ bool CYouTurn::buildABLinePatternYouTurn(const CVehicle &vehicle,
     //grab the pure pursuit point right on ABLine
     Vec3 onPurePoint(ABLine.rEastAB, ABLine.rNorthAB, 0);
 
+    //same turn as last time, still ahead of us
+    if (youTurnPhase == 0 && restoreABLineTurn(turn, ABLine, onPurePoint, headAB)) return false;
+
     //how far are we from any turn boundary
-    turn.findClosestTurnPoint(bnd, isYouTurnRight, onPurePoint, headAB);
+    findABLineTurnPoint(bnd, turn, ABLine, onPurePoint, headAB);
 
     //or did we lose the turnLine - we are on the highway cuz we left the outer/inner turn boundary
     if ((int)turn.closestTurnPt.easting != -20000)
@@ -832,6 +853,7 @@ bool CYouTurn::buildABLinePatternYouTurn(const CVehicle &vehicle,
             break;
     }
 
+    if (youTurnPhase == 3) saveABLineTurn(turn, ABLine, onPurePoint, headAB);
     return isOutOfBounds;
 }
 
@@ -841,13 +863,16 @@ bool CYouTurn::buildCurvePatternYouTurn(const CVehicle &vehicle,
                                         CTurn &turn,
                                         bool isTurnRight, Vec3 pivotPos)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
+
+    int rowSkipsWidth = snapshot->vehicleYouSkipWidth;
+    int youTurnStartOffset = snapshot->vehicleYouTurnDistance;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
-    int rowSkipsWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
-    int youTurnStartOffset = SETTINGS_VEHICLE_YOUTURNDISTANCE;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    //same turn as last time, still ahead of us
+    if (youTurnPhase == 0 && restoreCurveTurn(turn, curve)) return true;
 
     if (youTurnPhase > 0)
     {
@@ -1047,6 +1072,7 @@ bool CYouTurn::buildCurvePatternYouTurn(const CVehicle &vehicle,
             }
         case 2:
             youTurnPhase = 3;
+            saveCurveTurn(turn, curve);
             break;
     }
     return true;
@@ -1058,13 +1084,16 @@ bool CYouTurn::buildCurveDubinsYouTurn(const CVehicle &vehicle,
                                        CTurn &turn,
                                        bool isTurnRight, Vec3 pivotPos)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
+
+    double minTurningRadius = snapshot->vehicleMinTurningRadius;
+    int rowSkipsWidth = snapshot->vehicleYouSkipWidth;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
-    double minTurningRadius = SETTINGS_VEHICLE_MINTURNINGRADIUS;
-    int rowSkipsWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    //same turn as last time, still ahead of us
+    if (youTurnPhase == 0 && restoreCurveTurn(turn, curve)) return true;
 
     if (youTurnPhase > 0)
     {
@@ -1304,6 +1333,7 @@ bool CYouTurn::buildCurveDubinsYouTurn(const CVehicle &vehicle,
 
         case 2:
             youTurnPhase = 3;
+            saveCurveTurn(turn, curve);
             break;
     }
     return true;
@@ -1329,6 +1359,7 @@ void CYouTurn::completeYouTurn()
 {
     isYouTurnTriggered = false;
     resetCreatedYouTurn();
+    resetPlannedTurn();
     //mf.seq.ResetSequenceEventTriggers();
     emit resetSequenceEventTriggers();
     //mf.seq.isSequenceTriggered = false;
@@ -1344,6 +1375,7 @@ void CYouTurn::resetYouTurn()
     isYouTurnTriggered = false;
     ytList.clear();
     resetCreatedYouTurn();
+    resetPlannedTurn();
     turnDistanceAdjuster = 0;
     //mf.isBoundAlarming = false;
     emit turnOffBoundAlarm();
@@ -1365,6 +1397,150 @@ void CYouTurn::resetCreatedYouTurn()
     ytList.clear();
 }
 
+void CYouTurn::resetPlannedTurn()
+{
+    plan = PlannedTurn();
+}
+
+bool CYouTurn::isPlanFor(const CTurn &turn, bool isCurve, double heading, double pass, bool isSameWay)
+{
+    USE_SETTINGS_SNAPSHOT;
+
+    if (!plan.isValid || plan.isCurve != isCurve || plan.heading != heading ||
+        plan.pass != pass || plan.isSameWay != isSameWay ||
+        plan.isTurnRight != isYouTurnRight || plan.settings != snapshot)
+        return false;
+
+    //turn lines rebuilt since
+    if (plan.turnGenerations.size() != turn.turnArr.size()) return false;
+    for (int i = 0; i < turn.turnArr.size(); i++)
+    {
+        if (plan.turnGenerations[i] != turn.turnArr[i].generation) return false;
+    }
+
+    return true;
+}
+
+void CYouTurn::startPlan(const CTurn &turn, bool isCurve, double heading, double pass, bool isSameWay)
+{
+    USE_SETTINGS_SNAPSHOT;
+
+    plan = PlannedTurn();
+    plan.isValid = true;
+    plan.isCurve = isCurve;
+    plan.heading = heading;
+    plan.pass = pass;
+    plan.isSameWay = isSameWay;
+    plan.isTurnRight = isYouTurnRight;
+    plan.settings = snapshot;
+
+    for (int i = 0; i < turn.turnArr.size(); i++)
+        plan.turnGenerations.append(turn.turnArr[i].generation);
+}
+
+//Driving a straight line the crossing ahead doesn't move, it only
+//moves sideways if the line is nudged. So the ray march is only done
+//again when that happens or when the crossing is behind us.
+void CYouTurn::findABLineTurnPoint(const CBoundary &bnd, CTurn &turn, const CABLine &ABLine,
+                                   Vec3 fromPt, double headAB)
+{
+    double along, across;
+
+    if (isPlanFor(turn, false, ABLine.abHeading, ABLine.howManyPathsAway, ABLine.isABSameAsVehicleHeading)
+        && plan.isTurnPtFound)
+    {
+        alongAcross(fromPt, plan.turnPt.easting, plan.turnPt.northing, headAB, along, across);
+        if (along > 0 && fabs(across - plan.turnPtAcross) < ytPlanTolerance)
+        {
+            turn.closestTurnPt = plan.turnPt;
+            return;
+        }
+    }
+
+    turn.findClosestTurnPoint(bnd, isYouTurnRight, fromPt, headAB);
+
+    startPlan(turn, false, ABLine.abHeading, ABLine.howManyPathsAway, ABLine.isABSameAsVehicleHeading);
+    if ((int)turn.closestTurnPt.easting != -20000)
+    {
+        alongAcross(fromPt, turn.closestTurnPt.easting, turn.closestTurnPt.northing, headAB, along, across);
+        plan.isTurnPtFound = true;
+        plan.turnPt = turn.closestTurnPt;
+        plan.turnPtAcross = across;
+    }
+}
+
+//put back the finished turn if it was made for this line and is still ahead
+bool CYouTurn::restoreABLineTurn(const CTurn &turn, const CABLine &ABLine, Vec3 fromPt, double headAB)
+{
+    if (!isPlanFor(turn, false, ABLine.abHeading, ABLine.howManyPathsAway, ABLine.isABSameAsVehicleHeading))
+        return false;
+    if (plan.ytList.size() == 0) return false;
+
+    double along, across;
+    alongAcross(fromPt, plan.ytList[0].easting, plan.ytList[0].northing, headAB, along, across);
+    if (along < 3 || fabs(across - plan.listAcross) > ytPlanTolerance) return false;
+
+    ytList = plan.ytList;
+    youTurnPhase = 3;
+    isTurnCreationTooClose = false;
+    return true;
+}
+
+void CYouTurn::saveABLineTurn(const CTurn &turn, const CABLine &ABLine, Vec3 fromPt, double headAB)
+{
+    if (ytList.size() == 0) return;
+
+    if (!isPlanFor(turn, false, ABLine.abHeading, ABLine.howManyPathsAway, ABLine.isABSameAsVehicleHeading))
+        startPlan(turn, false, ABLine.abHeading, ABLine.howManyPathsAway, ABLine.isABSameAsVehicleHeading);
+
+    double along;
+    alongAcross(fromPt, ytList[0].easting, ytList[0].northing, headAB, along, plan.listAcross);
+    plan.ytList = ytList;
+}
+
+//put back the finished turn if the curve point it starts from hasn't
+//moved and we haven't driven past it
+bool CYouTurn::restoreCurveTurn(const CTurn &turn, const CABCurve &curve)
+{
+    if (!isPlanFor(turn, true, 0, curve.howManyPathsAway, curve.isABSameAsVehicleHeading))
+        return false;
+    if (plan.ytList.size() == 0) return false;
+
+    int index = plan.crossingCurvePoint.index;
+    if (index < 0 || index >= curve.curList.size()) return false;
+
+    if (glm::distance(curve.curList[index].easting, curve.curList[index].northing,
+                      plan.crossingCurvePoint.easting, plan.crossingCurvePoint.northing) > ytPlanTolerance)
+        return false;
+
+    if (curve.isABSameAsVehicleHeading)
+    {
+        if (curve.currentLocationIndex >= index) return false;
+    }
+    else
+    {
+        if (curve.currentLocationIndex <= index) return false;
+    }
+
+    crossingCurvePoint = plan.crossingCurvePoint;
+    crossingTurnLinePoint = plan.crossingTurnLinePoint;
+    curListCount = curve.curList.size();
+    ytList = plan.ytList;
+    youTurnPhase = 3;
+    isTurnCreationTooClose = false;
+    return true;
+}
+
+void CYouTurn::saveCurveTurn(const CTurn &turn, const CABCurve &curve)
+{
+    if (ytList.size() == 0) return;
+
+    startPlan(turn, true, 0, curve.howManyPathsAway, curve.isABSameAsVehicleHeading);
+    plan.crossingCurvePoint = crossingCurvePoint;
+    plan.crossingTurnLinePoint = crossingTurnLinePoint;
+    plan.ytList = ytList;
+}
+
 
 void CYouTurn::loadYouTurnShapeFromFile(QString filename)
 {
@@ -1418,13 +1594,13 @@ void CYouTurn::loadYouTurnShapeFromFile(QString filename)
 void CYouTurn::buildManualYouTurn(const CABLine &ABLine, CABCurve &curve,
                                   bool isTurnRight, bool isTurnButtonTriggered)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double minTurningRadius = SETTINGS_VEHICLE_MINTURNINGRADIUS;
-    int rowSkipsWidth = SETTINGS_VEHICLE_YOUSKIPWIDTH;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_toolOverlap = SETTINGS_TOOL_OVERLAP;
-    double tool_toolOffset = SETTINGS_TOOL_OFFSET;
+    double minTurningRadius = snapshot->vehicleMinTurningRadius;
+    int rowSkipsWidth = snapshot->vehicleYouSkipWidth;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_toolOverlap = snapshot->toolOverlap;
+    double tool_toolOffset = snapshot->toolOffset;
 
     isYouTurnTriggered = true;
 
@@ -1460,7 +1636,7 @@ void CYouTurn::buildManualYouTurn(const CABLine &ABLine, CABCurve &curve,
     turnOffset *= delta;
 
     //if using dubins to calculate youturn
-    //if (SETTINGS_VEHICLE_ISUSINGDUBINSTURN)
+    //if (snapshot->vehicleIsUsingDubinsTurn)
     {
         CDubins dubYouTurnPath;
         CDubinsTurningRadius = minTurningRadius;
@@ -1526,11 +1702,11 @@ void CYouTurn::buildManualYouTurn(const CABLine &ABLine, CABCurve &curve,
 //determine distance from youTurn guidance line
 void CYouTurn::distanceFromYouTurnLine(CVehicle &vehicle, CNMEA &pn)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double maxSteerAngle = SETTINGS_VEHICLE_MAXSTEERANGLE;
-    double wheelbase = SETTINGS_VEHICLE_WHEELBASE;
-    double maxAngularVelocity = SETTINGS_VEHICLE_MAXANGULARVELOCITY;
+    double maxSteerAngle = snapshot->vehicleMaxSteerAngle;
+    double wheelbase = snapshot->vehicleWheelbase;
+    double maxAngularVelocity = snapshot->vehicleMaxAngularVelocity;
 
     //grab a copy from main - the steer position
     double minDistA = 1000000, minDistB = 1000000;
@@ -1538,7 +1714,7 @@ void CYouTurn::distanceFromYouTurnLine(CVehicle &vehicle, CNMEA &pn)
 
     if (ptCount > 0)
     {
-        if (SETTINGS_VEHICLE_ISSTANLEYUSED)
+        if (snapshot->vehicleIsStanleyUsed)
         {
             pivot = vehicle.steerAxlePos;
 
@@ -1626,12 +1802,12 @@ void CYouTurn::distanceFromYouTurnLine(CVehicle &vehicle, CNMEA &pn)
             else if (abFixHeadingDelta < -glm::PIBy2) abFixHeadingDelta += M_PI;
 
             //normally set to 1, less then unity gives less heading error.
-            abFixHeadingDelta *= SETTINGS_VEHICLE_STANLEYHEADINGERRORGAIN;
+            abFixHeadingDelta *= snapshot->vehicleStanleyHeadingErrorGain;
             if (abFixHeadingDelta > 0.74) abFixHeadingDelta = 0.74;
             if (abFixHeadingDelta < -0.74) abFixHeadingDelta = -0.74;
 
             //the non linear distance error part of stanley
-            steerAngleYT = atan((distanceFromCurrentLine * SETTINGS_VEHICLE_STANLEYGAIN) / ((pn.speed * 0.277777) + 1));
+            steerAngleYT = atan((distanceFromCurrentLine * snapshot->vehicleStanleyGain) / ((pn.speed * 0.277777) + 1));
 
             //clamp it to max 42 degrees
             if (steerAngleYT > 0.74) steerAngleYT = 0.74;
@@ -1735,7 +1911,7 @@ void CYouTurn::distanceFromYouTurnLine(CVehicle &vehicle, CNMEA &pn)
             double goalPointDistance = vehicle.updateGoalPointDistance(pn,distanceFromCurrentLine);
 
             //sharp turns on you turn.
-            goalPointDistance = SETTINGS_VEHICLE_LOOKAHEADUTURNMULT * goalPointDistance;
+            goalPointDistance = snapshot->vehicleLookAheadUTurnMult * goalPointDistance;
             //emit setLookaheadGoal(goalPointDistance);
             //mf.lookaheadActual = goalPointDistance; //unused
 
@@ -1830,20 +2006,20 @@ void CYouTurn::distanceFromYouTurnLine(CVehicle &vehicle, CNMEA &pn)
 }
 
 //Duh.... What does this do....
-void CYouTurn::drawYouTurn(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
+void CYouTurn::drawYouTurn(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp) const
 {
     USE_SETTINGS;
 
     GLHelperOneColor gldraw;
 
-    int ptCount = ytList.size();
+    int ptCount = g.ytList.size();
     if (ptCount < 3) return;
 
-    if (isYouTurnTriggered)
+    if (g.isYouTurnTriggered)
     {
         for (int i = 0; i < ptCount; i++)
         {
-            gldraw.append(QVector3D(ytList[i].easting, ytList[i].northing, 0));
+            gldraw.append(QVector3D(g.ytList[i].easting, g.ytList[i].northing, 0));
         }
         gldraw.draw(gl, mvp, QColor::fromRgbF(0.95f, 0.95f, 0.25f),
                     GL_POINTS, SETTINGS_DISPLAY_LINEWIDTH);
@@ -1851,14 +2027,14 @@ void CYouTurn::drawYouTurn(QOpenGLFunctions *gl, const QMatrix4x4 &mvp)
     else
     {
         QColor color;
-        if (!isOutOfBounds)
+        if (!g.isOutOfBounds)
             color = QColor::fromRgbF(0.395f, 0.925f, 0.30f);
         else
             color = QColor::fromRgbF(0.9495f, 0.395f, 0.325f);
 
         for (int i = 0; i < ptCount; i++)
         {
-            gldraw.append(QVector3D(ytList[i].easting, ytList[i].northing, 0));
+            gldraw.append(QVector3D(g.ytList[i].easting, g.ytList[i].northing, 0));
         }
 
         gldraw.draw(gl, mvp, color, GL_POINTS, SETTINGS_DISPLAY_LINEWIDTH);
@@ -6,6 +6,7 @@
 #include <QVector>
 #include <QVector2D>
 #include <QVector4D>
+#include <QSharedPointer>
 #include "vec4.h"
 #include "vec3.h"
 #include "vec2.h"
@@ -20,6 +21,8 @@ class CTurn;
 class CGeoFence;
 class CMazeGrid;
 class CNMEA;
+struct CGuidanceState;
+struct AOGSettingsSnapshot;
 
 //class QMatrix4x4;
 
@@ -31,6 +34,39 @@ private:
     bool isABSameAsFixHeading = true, isOnRightSideCurrentLine = true;
     int numShapePoints;
 
+    //The last turn planned, kept while the line, pass, turn direction,
+    //turn lines and settings stay the same so the headland approach
+    //doesn't redo the turn line search and the whole path every fix.
+    struct PlannedTurn
+    {
+        bool isValid = false;
+        bool isCurve = false;
+        double heading = 0, pass = 0;
+        bool isSameWay = true, isTurnRight = false;
+        QVector<int> turnGenerations;
+        QSharedPointer<const AOGSettingsSnapshot> settings;
+
+        //AB line crossing from the ray march, and how far off the line it is
+        bool isTurnPtFound = false;
+        Vec3 turnPt;
+        double turnPtAcross = 0;
+
+        //the finished turn, empty till phase 3
+        QVector<Vec3> ytList;
+        double listAcross = 0;
+        Vec4 crossingCurvePoint, crossingTurnLinePoint;
+    } plan;
+
+    bool isPlanFor(const CTurn &turn, bool isCurve, double heading, double pass, bool isSameWay);
+    void startPlan(const CTurn &turn, bool isCurve, double heading, double pass, bool isSameWay);
+
+    void findABLineTurnPoint(const CBoundary &bnd, CTurn &turn, const CABLine &ABLine,
+                             Vec3 fromPt, double headAB);
+    bool restoreABLineTurn(const CTurn &turn, const CABLine &ABLine, Vec3 fromPt, double headAB);
+    void saveABLineTurn(const CTurn &turn, const CABLine &ABLine, Vec3 fromPt, double headAB);
+    bool restoreCurveTurn(const CTurn &turn, const CABCurve &curve);
+    void saveCurveTurn(const CTurn &turn, const CABCurve &curve);
+
 public:
     //triggered right after youTurnTriggerPoint is set
     bool isYouTurnTriggered;
@@ -147,6 +183,9 @@ public:
 
     void resetCreatedYouTurn();
 
+    //forget the cached turn so the next one is planned from scratch
+    void resetPlannedTurn();
+
     //get list of points from txt shape file
     void loadYouTurnShapeFromFile(QString filename);
 
@@ -158,7 +197,8 @@ public:
     void distanceFromYouTurnLine(CVehicle &v, CNMEA &pn);
 
     //Duh.... What does this do....
-    void drawYouTurn(QOpenGLFunctions *gl, const QMatrix4x4 &mvp);
+    //draws the turn as it was at the last fix
+    void drawYouTurn(const CGuidanceState &g, QOpenGLFunctions *gl, const QMatrix4x4 &mvp) const;
 signals:
     void showMessage(int,QString,QString);
     void outOfBounds();
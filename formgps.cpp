@@ -3,16 +3,22 @@
 #include <QColor>
 #include <QRgb>
 #include "qmlutil.h"
+#include "aogpositionworker.h"
+#include "aogsaveworker.h"
 #include "glm.h"
+#include "glutils.h"
 #include <QLocale>
 #include <QLabel>
+#include <QDebug>
+#include <QThreadPool>
 
 extern QLabel *grnPixelsWindow;
 
 
 
 FormGPS::FormGPS(QWidget *parent) :
-    QQuickView(qobject_cast<QWindow *>(parent))
+    QQuickView(qobject_cast<QWindow *>(parent)),
+    fixLock(QMutex::Recursive)
 {
     USE_SETTINGS;
     setupGui();
@@ -21,9 +27,20 @@ FormGPS::FormGPS(QWidget *parent) :
     /**************************
      * SerialComm.Designer.cs *
      **************************/
-    sp.setDataBits(QSerialPort::Data8);
-    sp.setParity(QSerialPort::NoParity);
-    sp.setStopBits(QSerialPort::OneStop);
+    //serial and UDP are read, and fixes worked out, in their own thread
+    positionWorker = new AOGPositionWorker(this);
+    positionWorker->moveToThread(&positionThread);
+    connect(&positionThread, SIGNAL(finished()), positionWorker, SLOT(deleteLater()));
+    connect(positionWorker, SIGNAL(fixProcessed()), this, SLOT(onFixProcessed()));
+    connect(positionWorker, SIGNAL(serialError(QString,QString)), this, SLOT(onSerialError(QString,QString)));
+    positionThread.start();
+
+    //field saves are written in their own thread too
+    saveWorker = new AOGSaveWorker;
+    saveWorker->setSyncEachSave(SETTINGS_FIELD_SYNCSAVES);
+    saveWorker->moveToThread(&saveThread);
+    connect(&saveThread, SIGNAL(finished()), saveWorker, SLOT(deleteLater()));
+    saveThread.start();
 
 
     isUDPServerOn = s.value("port/udp_on", true).toBool();
@@ -119,7 +136,7 @@ FormGPS::FormGPS(QWidget *parent) :
     //try and open
     SerialPortOpenGPS();
 
-    if (sp.isOpen())
+    if (positionWorker->isSerialOpen())
     {
         // TODO QAOG simulatorOnToolStripMenuItem.Checked = false;
         qmlItem(qml_root,"simSpeed")->setProperty("visible", false);
@@ -135,41 +152,47 @@ FormGPS::FormGPS(QWidget *parent) :
     if (isUDPServerOn) startUDPServer();
 
     //TODO: connect signals from various classes
-    connect(&pn, SIGNAL(setRollX16(int)), &ahrs, SLOT(setRollX16(int)));
-    connect(&pn, SIGNAL(setCorrectionHeadingX16(int)), &ahrs,SLOT(setCorrectionHeadingX16(int)));
-    connect(&pn, SIGNAL(clearRecvCounter()), this, SLOT(onClearRecvCounter()));
-    connect(&pn, SIGNAL(newSpeed(double)), &vehicle, SLOT(onNewSpeed(double)));
-    connect(&pn, SIGNAL(headingSource(int)), this, SLOT(onHeadingSource(int)));
 
-    connect(&curve, SIGNAL(doSequence(CYouTurn&)), &seq, SLOT(DoSequenceEvent(CYouTurn&)));
+    //These all fire in the middle of a fix on the positioning thread
+    //and only touch fix data, so they are called directly, inside
+    //fixLock, rather than queued to the GUI thread.
+    connect(&pn, SIGNAL(setRollX16(int)), &ahrs, SLOT(setRollX16(int)), Qt::DirectConnection);
+    connect(&pn, SIGNAL(setCorrectionHeadingX16(int)), &ahrs,SLOT(setCorrectionHeadingX16(int)), Qt::DirectConnection);
+    connect(&pn, SIGNAL(clearRecvCounter()), this, SLOT(onClearRecvCounter()), Qt::DirectConnection);
+    connect(&pn, SIGNAL(newSpeed(double)), &vehicle, SLOT(onNewSpeed(double)), Qt::DirectConnection);
+    connect(&pn, SIGNAL(headingSource(int)), this, SLOT(onHeadingSource(int)), Qt::DirectConnection);
 
-    connect(&ABLine, SIGNAL(doSequence(CYouTurn&)), &seq, SLOT(DoSequenceEvent(CYouTurn&)));
+    connect(&curve, SIGNAL(doSequence(CYouTurn&)), &seq, SLOT(DoSequenceEvent(CYouTurn&)), Qt::DirectConnection);
+
+    connect(&ABLine, SIGNAL(doSequence(CYouTurn&)), &seq, SLOT(DoSequenceEvent(CYouTurn&)), Qt::DirectConnection);
     //connect(&ABLine,SIGNAL(showMessage(int,QString,QString)),...
 
     //connnect(&ct, SIGNAL(showMessage(int,QString,QString))
 
     for(int i=0; i < MAXSECTIONS+1 ; i++) {
         //connect sections so they can increment area counters
-        connect(&tool.section[i], SIGNAL(addToTotalArea(double)), &fd, SLOT(addToTotalArea(double)));
-        connect(&tool.section[i], SIGNAL(addToUserArea(double)), &fd, SLOT(addToUserArea(double)));
+        connect(&tool.section[i], SIGNAL(addToTotalArea(double)), &fd, SLOT(addToTotalArea(double)), Qt::DirectConnection);
+        connect(&tool.section[i], SIGNAL(addToUserArea(double)), &fd, SLOT(addToUserArea(double)), Qt::DirectConnection);
+        connect(&tool.section[i], SIGNAL(addToCoverage(QVector3D,QVector3D,QVector3D,QVector3D)),
+                &fd, SLOT(addToCoverage(QVector3D,QVector3D,QVector3D,QVector3D)), Qt::DirectConnection);
     }
 
-    connect(&hd, SIGNAL(moveHydraulics(int)), &mc, SLOT(setHydLift(int)));
+    connect(&hd, SIGNAL(moveHydraulics(int)), &mc, SLOT(setHydLift(int)), Qt::DirectConnection);
 
     //connect(&mc, SIGNAL(sendOutUSBAutoSteerPort(uchar*,int)),
     //connect(&mc, SIGNAL(sendOutUSBMachinePort(uchar*,int)),
 
-    connect(&yt, SIGNAL(outOfBounds()), &mc, SLOT(setOutOfBounds()));
-    connect(&yt, SIGNAL(resetSequenceEventTriggers()), &seq, SLOT(ResetSequenceEventTriggers()));
+    connect(&yt, SIGNAL(outOfBounds()), &mc, SLOT(setOutOfBounds()), Qt::DirectConnection);
+    connect(&yt, SIGNAL(resetSequenceEventTriggers()), &seq, SLOT(ResetSequenceEventTriggers()), Qt::DirectConnection);
     //connect(&yt, SIGNAL(showMessage(int,QString,QString))
-    connect(&yt, SIGNAL(swapDirection()), this, SLOT(swapDirection()));
-    connect(&yt, SIGNAL(setTriggerSequence(bool)), &seq, SLOT(setIsSequenceTriggered(bool)));
-    connect(&yt, SIGNAL(turnOffBoundAlarm()), this, SLOT(turnOffBoundAlarm()));
+    connect(&yt, SIGNAL(swapDirection()), this, SLOT(swapDirection()), Qt::DirectConnection);
+    connect(&yt, SIGNAL(setTriggerSequence(bool)), &seq, SLOT(setIsSequenceTriggered(bool)), Qt::DirectConnection);
+    connect(&yt, SIGNAL(turnOffBoundAlarm()), this, SLOT(turnOffBoundAlarm()), Qt::DirectConnection);
 
     connect(&recPath, SIGNAL(setSimStepDistance(double)),&sim,SLOT(setSimStepDistance(double)));
     //connect(&recPath,SIGNAL(stoppedDriving())
 
-    connect(&seq, SIGNAL(doYouTurnSequenceEvent(int,int)), this, SLOT(DoYouTurnSequenceEvent(int,int)));
+    connect(&seq, SIGNAL(doYouTurnSequenceEvent(int,int)), this, SLOT(DoYouTurnSequenceEvent(int,int)), Qt::DirectConnection);
     //connect(&seq, SIGNAL(setDistanceToolToTurnLine(double)) //unused
 
     connect(&sim, SIGNAL(new_position(QByteArray)), this, SLOT(onSimNewPosition(QByteArray)));
@@ -182,22 +205,56 @@ FormGPS::~FormGPS()
     /* clean up our dynamically-allocated
      * objects.
      */
+    QMetaObject::invokeMethod(positionWorker, "stop", Qt::BlockingQueuedConnection);
+    positionThread.quit();
+    positionThread.wait();
+
+    //anything still queued is written before the thread goes
+    saveWorker->flush();
+    saveThread.quit();
+    saveThread.wait();
+
+    //a field still being read on the thread pool is read into our child
+    if (fieldLoader) QThreadPool::globalInstance()->waitForDone();
 }
 
-//This used to be part of oglBack_paint in the C# code, but
-//because openGL rendering can potentially be in another thread here, it's
-//broken out here.  So the lookaheadPixels array has been populated already
-//by the rendering routine.
-void FormGPS::processSectionLookahead() {
-    USE_SETTINGS;
+//The positioning thread has published a new fix. Everything that
+//touches the GUI after a fix happens here, on the GUI thread.
+void FormGPS::onFixProcessed()
+{
+    USE_SETTINGS_SNAPSHOT;
 
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
-    double tool_minUnappliedPixels = SETTINGS_TOOL_MINAPPLIED;
+    //openGLControl_Draw routine triggered manually
+    update();
+    openGLControl->update();
+
+    updateFixDisplay();
 
     //not using regular Qt Widgets in the main window anymore.  For
     //debugging purposes, this could go in another popup window
-    if (SETTINGS_DISPLAY_SHOWBACK)
+    if (snapshot->displayShowBack)
+    {
+        QMutexLocker lock(&fixLock);
+        grnPix = QImage((const uchar *)grnPixels, tool.rpWidth,
+                        CSectionRaster::RASTERHEIGHT,
+                        QImage::Format_RGBX8888).copy();
         grnPixelsWindow->setPixmap(QPixmap::fromImage(grnPix.mirrored()));
+    }
+}
+
+//This used to be part of oglBack_paint in the C# code. Instead of
+//drawing into an offscreen GL buffer and reading it back, the lookahead
+//window is rasterized on the CPU straight into grnPixels, so no GL
+//context is needed for section control.
+void FormGPS::processSectionLookahead() {
+    USE_SETTINGS_SNAPSHOT;
+
+    int tool_numOfSections = snapshot->toolNumSections;
+    double tool_minUnappliedPixels = snapshot->toolMinApplied;
+
+    //patches, boundary and headland into the rpWidth x 245 window
+    sectionRaster.rasterize(grnPixels, tool_numOfSections + 1, tool,
+                            vehicle.toolPos, bnd, hd);
 
     bool isHeadlandClose = false, isBoundaryClose = false, isMapping = true;
 
@@ -233,7 +290,7 @@ void FormGPS::processSectionLookahead() {
     }
 
     //if only one section, or going slow no need for super section
-    if (tool_numOfSections == 1 || pn.speed <= SETTINGS_TOOL_SLOWSPEEDCUTOFF)
+    if (tool_numOfSections == 1 || pn.speed <= snapshot->toolSlowSpeedCutoff)
             tool.isSuperSectionAllowedOn = false;
 
     //clamp the height after looking way ahead, this is for switching off super section only
@@ -740,7 +797,7 @@ GetOutSectionOff1:
             }
 
             //if going too slow turn off sections
-            if (pn.speed <= SETTINGS_TOOL_SLOWSPEEDCUTOFF)
+            if (pn.speed <= snapshot->toolSlowSpeedCutoff)
             {
                 tool.section[j].sectionOnRequest = false;
                 tool.section[j].sectionOffRequest = true;
@@ -779,7 +836,7 @@ GetOutSectionOff1:
             }
 
             //if going too slow turn off sections
-            if (pn.speed <= SETTINGS_TOOL_SLOWSPEEDCUTOFF)
+            if (pn.speed <= snapshot->toolSlowSpeedCutoff)
             {
                 tool.section[j].mappingOnRequest = false;
                 tool.section[j].mappingOffRequest = true;
@@ -788,7 +845,7 @@ GetOutSectionOff1:
         }
     } // end of supersection is off
     //Checks the workswitch if required
-    if (isJobStarted && SETTINGS_TOOL_ISWORKSWITCHENABLED)
+    if (isJobStarted && snapshot->toolIsWorkSwitchEnabled)
     {
         //TODO: workSwitch.checkWorkSwitch();
     }
@@ -808,22 +865,25 @@ GetOutSectionOff1:
 
 
     //if a minute has elapsed save the field in case of crash and to be able to resume
-    if (minuteCounter > 60 && sentenceCounter < 20)
+    if (minuteCounter.load() > 60 && sentenceCounter.load() < 20)
     {
         //tmrWatchdog->stop();
 
         //don't save if no gps
         if (isJobStarted )
         {
-            //auto save the field patches, contours accumulated so far
-            //TODO:FileSaveSections();
-            //TODO: FileSaveContour();
+            //auto save the field patches, contours accumulated so far.
+            //These only hand the lists to the save thread.
+            fileSaveSections();
+            fileSaveContour();
+            fileSaveCoverage();
 
             //NMEA log file
-            //TODO: if (isLogNMEA) FileSaveNMEA();
-            //TODO: if (isLogElevation) FileSaveElevation();
+            if (snapshot->gpsLogNMEA) fileSaveNMEA();
+            if (snapshot->gpsLogElevation) fileSaveElevation();
             //FileSaveFieldKML();
         }
+        minuteCounter.store(0);
 
         /*
          TODO:
@@ -868,11 +928,11 @@ GetOutSectionOff1:
 //Does the logic to process section on off requests
 void FormGPS::processSectionOnOffRequests(bool isMapping)
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double tool_turnOffDelay = SETTINGS_TOOL_OFFDELAY;
+    double tool_turnOffDelay = snapshot->toolOffDelay;
 
-    for (int j = 0; j < SETTINGS_TOOL_NUMSECTIONS + 1; j++)
+    for (int j = 0; j < snapshot->toolNumSections + 1; j++)
     {
         //SECTIONS -
 
@@ -969,291 +1029,290 @@ void FormGPS::processSectionOnOffRequests(bool isMapping)
     }
 }
 
-void FormGPS::tmrWatchdog_timeout()
+//GUI side of every new fix, called from onFixProcessed()
+void FormGPS::updateFixDisplay()
 {
     USE_SETTINGS;
 
-    //Check for a newline char, if none then just return
-    sentenceCounter++;
-    int cr = pn.rawBuffer.indexOf("\n");
-    if (sentenceCounter > 80)
-        sentenceCounter = 100; //show no GPS warning
+    //reset the dead GPS counter
+    if (sentenceCounter.load() > 98)
+    {
+        camera.camSetDistance = -200;
+        setZoom();
+    }
 
-    if (cr == -1) return;
+    sentenceCounter.store(0);
 
-    //tmrWatchdog->stop();
 
-    //did we get a new fix position?
-    if (scanForNMEA())
+    if (threeSecondCounter++ >= fixUpdateHz * 2)
     {
-        //reset the dead GPS counter
-        if (sentenceCounter > 98)
-        {
-            camera.camSetDistance = -200;
-            setZoom();
-        }
+        threeSecondCounter = 0;
+        threeSeconds++;
+    }
+    if (oneSecondCounter++ >= fixUpdateHz)
+    {
+        oneSecondCounter = 0;
+        oneSecond++;
+    }
+    if (oneHalfSecondCounter++ >= fixUpdateHz / 2)
+    {
+        oneHalfSecondCounter = 0;
+        oneHalfSecond++;
+    }
+    if (oneFifthSecondCounter++ >= fixUpdateHz / 5)
+    {
+        oneFifthSecondCounter = 0;
+        oneFifthSecond++;
+    }
 
-        sentenceCounter = 0;
+    /////////////////////////////////////////////////////////   333333333333333  ////////////////////////////////////////
+    //every 3 second update status
+    if (displayUpdateThreeSecondCounter != threeSeconds)
+    {
+        //reset the counter
+        displayUpdateThreeSecondCounter = threeSeconds;
+
+        //check to make sure the grid is big enough
+        CPositionState position = positionSnapshot.read();
+        worldGrid.checkZoomWorldGrid(position.fix.northing, position.fix.easting);
+
+        if (SETTINGS_GPS_LOGFIXLATENCY) qDebug() << fixLatency.toString();
+        if (SETTINGS_DISPLAY_LOGFRAMESTATS) qDebug() << glFrameStatsString();
 
+        //TODO: batman panel
 
-        if (threeSecondCounter++ >= fixUpdateHz * 2)
+        if (SETTINGS_DISPLAY_ISMETRIC)
         {
-            threeSecondCounter = 0;
-            threeSeconds++;
+            //TODO: status bar updates
+            /*
+            lblTotalFieldArea.Text = fd.AreaBoundaryLessInnersHectares;
+            lblTotalAppliedArea.Text = fd.WorkedHectares;
+            lblWorkRemaining.Text = fd.WorkedAreaRemainHectares;
+            lblPercentRemaining.Text = fd.WorkedAreaRemainPercentage;
+            lblTimeRemaining.Text = fd.TimeTillFinished;
+
+            lblAreaAppliedMinusOverlap.Text = ((fd.actualAreaCovered * glm.m2ha).ToString("N2"));
+            lblAreaMinusActualApplied.Text = (((fd.areaBoundaryOuterLessInner - fd.actualAreaCovered) * glm.m2ha).ToString("N2"));
+            lblOverlapPercent.Text = (fd.overlapPercent.ToString("N2")) + "%";
+            lblAreaOverlapped.Text = (((fd.workedAreaTotal - fd.actualAreaCovered) * glm.m2ha).ToString("N3"));
+
+            btnManualOffOn.Text = fd.AreaBoundaryLessInnersHectares;
+            lblEqSpec.Text = (Math.Round(tool.toolWidth, 2)).ToString() + " m  " + vehicleFileName + toolFileName;
+            */
         }
-        if (oneSecondCounter++ >= fixUpdateHz)
+        else //imperial
         {
-            oneSecondCounter = 0;
-            oneSecond++;
+            /*
+            lblTotalFieldArea.Text = fd.AreaBoundaryLessInnersAcres;
+            lblTotalAppliedArea.Text = fd.WorkedAcres;
+            lblWorkRemaining.Text = fd.WorkedAreaRemainAcres;
+            lblPercentRemaining.Text = fd.WorkedAreaRemainPercentage;
+            lblTimeRemaining.Text = fd.TimeTillFinished;
+
+            lblAreaAppliedMinusOverlap.Text = ((fd.actualAreaCovered * glm.m2ac).ToString("N2"));
+            lblAreaMinusActualApplied.Text = (((fd.areaBoundaryOuterLessInner - fd.actualAreaCovered) * glm.m2ac).ToString("N2"));
+            lblOverlapPercent.Text = (fd.overlapPercent.ToString("N2")) + "%";
+            lblAreaOverlapped.Text = (((fd.workedAreaTotal - fd.actualAreaCovered) * glm.m2ac).ToString("N3"));
+
+            btnManualOffOn.Text = fd.AreaBoundaryLessInnersAcres;
+            lblEqSpec.Text =  (Math.Round(tool.toolWidth * glm.m2ft, 2)).ToString() + " ft  " + vehicleFileName + toolFileName;
+            */
         }
-        if (oneHalfSecondCounter++ >= fixUpdateHz / 2)
+
+        //not Metric/Standard units sensitive
+        //TODO: line button updates
+        /*
+        if (ABLine.isBtnABLineOn) btnABLine.Text = "# " + PassNumber;
+        else btnABLine.Text = "";
+
+        if (curve.isBtnCurveOn) btnCurve.Text = "# " + CurveNumber;
+        else btnCurve.Text = "";
+
+        //update the online indicator 63 green red 64
+        if (recvCounter > 20 && toolStripBtnGPSStength.Image.Height != 64)
         {
-            oneHalfSecondCounter = 0;
-            oneHalfSecond++;
+            //stripOnlineGPS.Value = 1;
+            lblEasting.Text = "-";
+            lblNorthing.Text = gStr.gsNoGPS;
+            //lblZone.Text = "-";
+            toolStripBtnGPSStength.Image = Resources.GPSSignalPoor;
         }
-        if (oneFifthSecondCounter++ >= fixUpdateHz / 5)
+        else if (recvCounter < 20 && toolStripBtnGPSStength.Image.Height != 63)
         {
-            oneFifthSecondCounter = 0;
-            oneFifthSecond++;
+            //stripOnlineGPS.Value = 100;
+            toolStripBtnGPSStength.Image = Resources.GPSSignalGood;
         }
 
-        /////////////////////////////////////////////////////////   333333333333333  ////////////////////////////////////////
-        //every 3 second update status
-        if (displayUpdateThreeSecondCounter != threeSeconds)
-        {
-            //reset the counter
-            displayUpdateThreeSecondCounter = threeSeconds;
-
-            //check to make sure the grid is big enough
-            worldGrid.checkZoomWorldGrid(pn.fix.northing, pn.fix.easting);
-
-            //TODO: batman panel
-
-            if (SETTINGS_DISPLAY_ISMETRIC)
-            {
-                //TODO: status bar updates
-                /*
-                lblTotalFieldArea.Text = fd.AreaBoundaryLessInnersHectares;
-                lblTotalAppliedArea.Text = fd.WorkedHectares;
-                lblWorkRemaining.Text = fd.WorkedAreaRemainHectares;
-                lblPercentRemaining.Text = fd.WorkedAreaRemainPercentage;
-                lblTimeRemaining.Text = fd.TimeTillFinished;
-
-                lblAreaAppliedMinusOverlap.Text = ((fd.actualAreaCovered * glm.m2ha).ToString("N2"));
-                lblAreaMinusActualApplied.Text = (((fd.areaBoundaryOuterLessInner - fd.actualAreaCovered) * glm.m2ha).ToString("N2"));
-                lblOverlapPercent.Text = (fd.overlapPercent.ToString("N2")) + "%";
-                lblAreaOverlapped.Text = (((fd.workedAreaTotal - fd.actualAreaCovered) * glm.m2ha).ToString("N3"));
-
-                btnManualOffOn.Text = fd.AreaBoundaryLessInnersHectares;
-                lblEqSpec.Text = (Math.Round(tool.toolWidth, 2)).ToString() + " m  " + vehicleFileName + toolFileName;
-                */
-            }
-            else //imperial
-            {
-                /*
-                lblTotalFieldArea.Text = fd.AreaBoundaryLessInnersAcres;
-                lblTotalAppliedArea.Text = fd.WorkedAcres;
-                lblWorkRemaining.Text = fd.WorkedAreaRemainAcres;
-                lblPercentRemaining.Text = fd.WorkedAreaRemainPercentage;
-                lblTimeRemaining.Text = fd.TimeTillFinished;
-
-                lblAreaAppliedMinusOverlap.Text = ((fd.actualAreaCovered * glm.m2ac).ToString("N2"));
-                lblAreaMinusActualApplied.Text = (((fd.areaBoundaryOuterLessInner - fd.actualAreaCovered) * glm.m2ac).ToString("N2"));
-                lblOverlapPercent.Text = (fd.overlapPercent.ToString("N2")) + "%";
-                lblAreaOverlapped.Text = (((fd.workedAreaTotal - fd.actualAreaCovered) * glm.m2ac).ToString("N3"));
-
-                btnManualOffOn.Text = fd.AreaBoundaryLessInnersAcres;
-                lblEqSpec.Text =  (Math.Round(tool.toolWidth * glm.m2ft, 2)).ToString() + " ft  " + vehicleFileName + toolFileName;
-                */
-            }
+        lblDateTime.Text = DateTime.Now.ToString("HH:mm:ss") + "\n\r" + DateTime.Now.ToString("ddd MMM yyyy");
+        */
+    }//end every 3 seconds
 
-            //not Metric/Standard units sensitive
-            //TODO: line button updates
-            /*
-            if (ABLine.isBtnABLineOn) btnABLine.Text = "# " + PassNumber;
-            else btnABLine.Text = "";
 
-            if (curve.isBtnCurveOn) btnCurve.Text = "# " + CurveNumber;
-            else btnCurve.Text = "";
 
-            //update the online indicator 63 green red 64
-            if (recvCounter > 20 && toolStripBtnGPSStength.Image.Height != 64)
-            {
-                //stripOnlineGPS.Value = 1;
-                lblEasting.Text = "-";
-                lblNorthing.Text = gStr.gsNoGPS;
-                //lblZone.Text = "-";
-                toolStripBtnGPSStength.Image = Resources.GPSSignalPoor;
-            }
-            else if (recvCounter < 20 && toolStripBtnGPSStength.Image.Height != 63)
-            {
-                //stripOnlineGPS.Value = 100;
-                toolStripBtnGPSStength.Image = Resources.GPSSignalGood;
-            }
-
-            lblDateTime.Text = DateTime.Now.ToString("HH:mm:ss") + "\n\r" + DateTime.Now.ToString("ddd MMM yyyy");
-            */
-        }//end every 3 seconds
+    //every second update all status ///////////////////////////   1 1 1 1 1 1 ////////////////////////////
+    if (displayUpdateOneSecondCounter != oneSecond)
+    {
+        //reset the counter
+        displayUpdateOneSecondCounter = oneSecond;
 
+        //counter used for saving field in background
+        minuteCounter.ref();
 
+        qmlItem(qml_root,"btnPerimeter")->setProperty("buttonText", fd.getWorkedHectares());
 
-        //every second update all status ///////////////////////////   1 1 1 1 1 1 ////////////////////////////
-        if (displayUpdateOneSecondCounter != oneSecond)
+        /*
+        if (panelBatman.Visible)
         {
-            //reset the counter
-            displayUpdateOneSecondCounter = oneSecond;
+            //both
+            lblLatitude.Text = Latitude;
+            lblLongitude.Text = Longitude;
 
-            //counter used for saving field in background
-            minuteCounter++;
+            pbarRelayComm.Value = pbarRelay;
 
-            qmlItem(qml_root,"btnPerimeter")->setProperty("buttonText", fd.getWorkedHectares());
+            lblRoll.Text = RollInDegrees;
+            lblYawHeading.Text = GyroInDegrees;
+            lblGPSHeading.Text = GPSHeading;
 
-            /*
-            if (panelBatman.Visible)
+            //up in the menu a few pieces of info
+            if (isJobStarted)
             {
-                //both
-                lblLatitude.Text = Latitude;
-                lblLongitude.Text = Longitude;
-
-                pbarRelayComm.Value = pbarRelay;
+                lblEasting.Text = "E:" + (pn.fix.easting).ToString("N2");
+                lblNorthing.Text = "N:" + (pn.fix.northing).ToString("N2");
+            }
+            else
+            {
+                lblEasting.Text = "E:" + (pn.actualEasting).ToString("N2");
+                lblNorthing.Text = "N:" + (pn.actualNorthing).ToString("N2");
+            }
 
-                lblRoll.Text = RollInDegrees;
-                lblYawHeading.Text = GyroInDegrees;
-                lblGPSHeading.Text = GPSHeading;
+            lblUturnByte.Text = Convert.ToString(mc.autoSteerData[mc.sdYouTurnByte], 2).PadLeft(6, '0');
+        }
 
-                //up in the menu a few pieces of info
-                if (isJobStarted)
-                {
-                    lblEasting.Text = "E:" + (pn.fix.easting).ToString("N2");
-                    lblNorthing.Text = "N:" + (pn.fix.northing).ToString("N2");
-                }
-                else
-                {
-                    lblEasting.Text = "E:" + (pn.actualEasting).ToString("N2");
-                    lblNorthing.Text = "N:" + (pn.actualNorthing).ToString("N2");
-                }
+        if (ABLine.isBtnABLineOn && !ct.isContourBtnOn)
+        {
+            btnEditHeadingB.Text = ((int)(ABLine.moveDistance * 100)).ToString();
+        }
+        if (curve.isBtnCurveOn && !ct.isContourBtnOn)
+        {
+            btnEditHeadingB.Text = ((int)(curve.moveDistance * 100)).ToString();
+        }
 
-                lblUturnByte.Text = Convert.ToString(mc.autoSteerData[mc.sdYouTurnByte], 2).PadLeft(6, '0');
-            }
+        pbarAutoSteerComm.Value = pbarSteer;
+        pbarUDPComm.Value = pbarUDP;
+        */
 
-            if (ABLine.isBtnABLineOn && !ct.isContourBtnOn)
-            {
-                btnEditHeadingB.Text = ((int)(ABLine.moveDistance * 100)).ToString();
-            }
-            if (curve.isBtnCurveOn && !ct.isContourBtnOn)
-            {
-                btnEditHeadingB.Text = ((int)(curve.moveDistance * 100)).ToString();
-            }
+        if (mc.steerSwitchValue == 0)
+        {
+            //this.AutoSteerToolBtn.BackColor = System.Drawing.Color.LightBlue;
+        }
+        else
+        {
+            //this.AutoSteerToolBtn.BackColor = System.Drawing.Color.Transparent;
+        }
 
-            pbarAutoSteerComm.Value = pbarSteer;
-            pbarUDPComm.Value = pbarUDP;
-            */
 
+        //AutoSteerAuto button enable - Ray Bear inspired code - Thx Ray!
+        if (isJobStarted && ahrs.isAutoSteerAuto && !recPath.isDrivingRecordedPath &&
+            (ABLine.isBtnABLineOn || ct.isContourBtnOn || curve.isBtnCurveOn))
+        {
             if (mc.steerSwitchValue == 0)
             {
-                //this.AutoSteerToolBtn.BackColor = System.Drawing.Color.LightBlue;
+                //if (!isAutoSteerBtnOn) btnAutoSteer.PerformClick();
             }
             else
             {
-                //this.AutoSteerToolBtn.BackColor = System.Drawing.Color.Transparent;
+                //if ( isAutoSteerBtnOn) btnAutoSteer.PerformClick();
             }
+        }
 
+        //Make sure it is off when it should
+        //if ((!ABLine.isBtnABLineOn && !ct.isContourBtnOn && !curve.isBtnCurveOn && isAutoSteerBtnOn) || (recPath.isDrivingRecordedPath && isAutoSteerBtnOn)) btnAutoSteer.PerformClick();
 
-            //AutoSteerAuto button enable - Ray Bear inspired code - Thx Ray!
-            if (isJobStarted && ahrs.isAutoSteerAuto && !recPath.isDrivingRecordedPath &&
-                (ABLine.isBtnABLineOn || ct.isContourBtnOn || curve.isBtnCurveOn))
-            {
-                if (mc.steerSwitchValue == 0)
-                {
-                    //if (!isAutoSteerBtnOn) btnAutoSteer.PerformClick();
-                }
-                else
-                {
-                    //if ( isAutoSteerBtnOn) btnAutoSteer.PerformClick();
-                }
-            }
+        //do all the NTRIP routines
+        //DoNTRIPSecondRoutine();
 
-            //Make sure it is off when it should
-            //if ((!ABLine.isBtnABLineOn && !ct.isContourBtnOn && !curve.isBtnCurveOn && isAutoSteerBtnOn) || (recPath.isDrivingRecordedPath && isAutoSteerBtnOn)) btnAutoSteer.PerformClick();
+        //the main formgps window
+        /*
+        if (isMetric)  //metric or imperial
+        {
+            //Hectares on the master section soft control and sections
+            btnSectionOffAutoOn.Text = fd.WorkedHectares;
+            lblSpeed.Text = SpeedKPH;
 
-            //do all the NTRIP routines
-            //DoNTRIPSecondRoutine();
+            //status strip values
+            distanceToolBtn.Text = fd.DistanceUserMeters + "\r\n" + fd.WorkedUserHectares2;
 
-            //the main formgps window
-            /*
-            if (isMetric)  //metric or imperial
-            {
-                //Hectares on the master section soft control and sections
-                btnSectionOffAutoOn.Text = fd.WorkedHectares;
-                lblSpeed.Text = SpeedKPH;
+            btnContour.Text = XTE; //cross track error
 
-                //status strip values
-                distanceToolBtn.Text = fd.DistanceUserMeters + "\r\n" + fd.WorkedUserHectares2;
+        }
+        else  //Imperial Measurements
+        {
+            //acres on the master section soft control and sections
+            btnSectionOffAutoOn.Text = fd.WorkedAcres;
+            lblSpeed.Text = SpeedMPH;
 
-                btnContour.Text = XTE; //cross track error
+            //status strip values
+            distanceToolBtn.Text = fd.DistanceUserFeet + "\r\n" + fd.WorkedUserAcres2;
+            btnContour.Text = InchXTE; //cross track error
+        }
 
-            }
-            else  //Imperial Measurements
+        //statusbar flash red undefined headland
+        if (mc.isOutOfBounds && statusStripBottom.BackColor == Color.Transparent
+            || !mc.isOutOfBounds && statusStripBottom.BackColor == Color.Tomato)
+        {
+            if (!mc.isOutOfBounds)
             {
-                //acres on the master section soft control and sections
-                btnSectionOffAutoOn.Text = fd.WorkedAcres;
-                lblSpeed.Text = SpeedMPH;
-
-                //status strip values
-                distanceToolBtn.Text = fd.DistanceUserFeet + "\r\n" + fd.WorkedUserAcres2;
-                btnContour.Text = InchXTE; //cross track error
+                statusStripBottom.BackColor = Color.Transparent;
             }
-
-            //statusbar flash red undefined headland
-            if (mc.isOutOfBounds && statusStripBottom.BackColor == Color.Transparent
-                || !mc.isOutOfBounds && statusStripBottom.BackColor == Color.Tomato)
+            else
             {
-                if (!mc.isOutOfBounds)
-                {
-                    statusStripBottom.BackColor = Color.Transparent;
-                }
-                else
-                {
-                    statusStripBottom.BackColor = Color.Tomato;
-                }
+                statusStripBottom.BackColor = Color.Tomato;
             }
-            */
         }
+        */
+    }
 
-        //every half of a second update all status  ////////////////    0.5  0.5   0.5    0.5    /////////////////
-        if (displayUpdateHalfSecondCounter != oneHalfSecond)
-        {
-            //reset the counter
-            displayUpdateHalfSecondCounter = oneHalfSecond;
-
-           //lblTrigger.Text = sectionTriggerStepDistance.ToString("N2");
-            //lblLift.Text = mc.pgn[mc.azRelayData][mc.rdHydLift].ToString();
+    //every half of a second update all status  ////////////////    0.5  0.5   0.5    0.5    /////////////////
+    if (displayUpdateHalfSecondCounter != oneHalfSecond)
+    {
+        //reset the counter
+        displayUpdateHalfSecondCounter = oneHalfSecond;
 
-        } //end every 1/2 second
+       //lblTrigger.Text = sectionTriggerStepDistance.ToString("N2");
+        //lblLift.Text = mc.pgn[mc.azRelayData][mc.rdHydLift].ToString();
 
-        //every fifth second update  ///////////////////////////   FIFTH Fifth ////////////////////////////
-        if (displayUpdateOneFifthCounter != oneFifthSecond)
-        {
-            //reset the counter
-            displayUpdateOneFifthCounter = oneFifthSecond;
+    } //end every 1/2 second
 
-            if (hd.isOn)
-            {
-            }
+    //every fifth second update  ///////////////////////////   FIFTH Fifth ////////////////////////////
+    if (displayUpdateOneFifthCounter != oneFifthSecond)
+    {
+        //reset the counter
+        displayUpdateOneFifthCounter = oneFifthSecond;
 
-            if ((vehicle.guidanceLineDistanceOff == 32020) | (vehicle.guidanceLineDistanceOff == 32000))
-            {
-                //steerAnglesToolStripDropDownButton1.Text = "Off \r\n" + ActualSteerAngle;
-            }
-            else
-            {
-                //steerAnglesToolStripDropDownButton1.Text = SetSteerAngle + "\r\n" + ActualSteerAngle;
-            }
+        if (hd.isOn)
+        {
+        }
 
-            //lblHz.Text = NMEAHz + "Hz " + (int)(frameTime) + "\r\n" + FixQuality + HzTime.ToString("N1") + " Hz";
+        if ((vehicle.guidanceLineDistanceOff == 32020) | (vehicle.guidanceLineDistanceOff == 32000))
+        {
+            //steerAnglesToolStripDropDownButton1.Text = "Off \r\n" + ActualSteerAngle;
+        }
+        else
+        {
+            //steerAnglesToolStripDropDownButton1.Text = SetSteerAngle + "\r\n" + ActualSteerAngle;
         }
 
-    } //there was a new GPS update
+        //lblHz.Text = NMEAHz + "Hz " + (int)(frameTime) + "\r\n" + FixQuality + HzTime.ToString("N1") + " Hz";
+    }
+}
+
+void FormGPS::tmrWatchdog_timeout()
+{
+    //Fixes are processed as soon as they are framed, see
+    //onFixProcessed(). All this timer does is count up until a fix
+    //resets the counter, and the per cycle UI updates.
+    if (sentenceCounter.fetchAndAddRelaxed(1) + 1 > 80)
+        sentenceCounter.store(100); //show no GPS warning
 
     //Do these updates every cycle
 
@@ -1323,6 +1382,8 @@ void FormGPS::lineUpManualBtns()
 //udate individual btn based on state after push.
 void FormGPS::manualBtnUpdate(int sectNumber)
 {
+    QMutexLocker lock(&fixLock);
+
     QObject *button = qmlItem(qml_root,QString("section")+QString::number(sectNumber));
 
     switch(tool.section[sectNumber].manBtnState) {
@@ -1360,6 +1421,10 @@ QString FormGPS::speedMPH() {
 }
 
 void FormGPS::swapDirection() {
+    //called in the middle of a fix, but it is a slot so take the lock
+    //in case it comes from anywhere else
+    QMutexLocker lock(&fixLock);
+
     if (!yt.isYouTurnTriggered)
     {
         //is it turning right already?
@@ -1398,8 +1463,14 @@ void FormGPS::onHeadingSource(int tempInt)
     else { headingFromSource = headingFromSourceBak; }
 }
 
-void FormGPS::jobClose()
+void FormGPS::jobClose(bool flushSaves)
 {
+    //save what is left and wait for it, so the field reopens whole.
+    //Done before taking the lock, the save thread may need it.
+    if (isJobStarted && flushSaves) fileFlushSaves();
+
+    QMutexLocker lock(&fixLock);
+
     //settings are always live in FormGPS
 
     pn.fixOffset.easting = 0;
@@ -1498,6 +1569,7 @@ void FormGPS::jobClose()
         tool.section[j].patchList.clear();
         tool.section[j].triangleList.clear();
     }
+    tool.patchIndex.clear();
 
     //clear the flags
     flagPts.clear();
@@ -1554,6 +1626,14 @@ void FormGPS::jobClose()
 
     //reset acre and distance counters
     fd.workedAreaTotal = 0;
+    double coverageResolution = SETTINGS_FIELD_COVERAGERESOLUTION;
+    if (coverageResolution <= 0)
+    {
+        qWarning() << "Coverage resolution" << coverageResolution << "is not valid, using 0.25";
+        coverageResolution = 0.25;
+    }
+    fd.coverage.clear(coverageResolution);
+    fd.updateOverlap();
 
     //reset boundaries
     bnd.resetBoundaries();
@@ -1575,11 +1655,14 @@ void FormGPS::jobClose()
     //reset all Port Module values
     mc.resetAllModuleCommValues();
 
-
+    //stop drawing the old field's lines without waiting for a fix
+    publishGuidance();
 }
 
 void FormGPS::jobNew()
 {
+    QMutexLocker lock(&fixLock);
+
     /*
      * TODO:
     if (Settings.Default.setMenu_isOGLZoomOn == 1)
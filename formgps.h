@@ -8,6 +8,7 @@
 #include <QOpenGLTexture>
 #include <QUdpSocket>
 #include <QElapsedTimer>
+#include <QAtomicInt>
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
 #include <QSurfaceFormat>
@@ -15,6 +16,8 @@
 #include <QOpenGLBuffer>
 #include <QQuickView>
 #include <QSerialPort>
+#include <QThread>
+#include <QMutex>
 
 #include "common.h"
 
@@ -46,6 +49,11 @@
 #include "cahrs.h"
 #include "crecordedpath.h"
 #include "cgeofence.h"
+#include "csectionraster.h"
+#include "cpatchbuffers.h"
+#include "cpositionsnapshot.h"
+#include "cguidancesnapshot.h"
+#include "clatencyhistogram.h"
 
 //forward declare classes referred to below, to break circular
 //references in the code
@@ -53,6 +61,9 @@ class TopLineDisplay;
 
 class QOpenGLShaderProgram;
 class AOGRendererInSG;
+class AOGPositionWorker;
+class AOGSaveWorker;
+class CFieldLoader;
 
 class FormGPS : public QQuickView
 {
@@ -70,6 +81,32 @@ public:
     QTimer *tmrWatchdog;
     QTimer simTimer;
 
+    //serial, UDP and fix processing run here, see AOGPositionWorker
+    QThread positionThread;
+    AOGPositionWorker *positionWorker;
+
+    //field files are appended here, see AOGSaveWorker
+    QThread saveThread;
+    AOGSaveWorker *saveWorker;
+
+    //field being read on the thread pool by fileOpenField(), until
+    //onFieldLoaded() swaps it in
+    CFieldLoader *fieldLoader = NULL;
+
+    //held by the positioning thread for a whole fix, and by anything
+    //on the GUI thread that rebuilds the field or guidance data
+    QMutex fixLock;
+
+    //last published fix, for the renderer and the UI
+    CPositionSnapshot positionSnapshot;
+
+    //guidance lines, U-turn and tool as of the last fix, what the
+    //renderer draws instead of reading them under fixLock
+    CGuidanceSnapshot guidanceSnapshot;
+
+    //receive to steer output time of every fix, for tuning
+    CLatencyHistogram fixLatency;
+
     /***************************
      * Qt and QML GUI elements *
      ***************************/
@@ -118,12 +155,6 @@ public:
 
     AOGSettings settings;
 
-    //offscreen GL objects:
-    QSurfaceFormat backSurfaceFormat;
-    QOpenGLContext backOpenGLContext;
-    QOffscreenSurface backSurface;
-    QOpenGLFramebufferObject *backFBO = 0;
-
     /*******************
      * from FormGPS.cs *
      *******************/
@@ -198,7 +229,9 @@ private:
      int oneSecondCounter = 0, oneSecond = 0;
      int oneHalfSecondCounter = 0, oneHalfSecond = 0;
      int oneFifthSecondCounter = 0, oneFifthSecond = 0;
-     int minuteCounter = 1;
+     //counted up on the GUI thread, checked and reset on the
+     //positioning thread
+     QAtomicInt minuteCounter = 1;
 public:
      int pbarSteer, pbarRelay, pbarUDP;
      double nudNumber = 0;
@@ -213,6 +246,7 @@ public:
     //create world grid
     //QScopedPointer <CWorldGrid> worldGrid;
     CWorldGrid worldGrid;
+    CPatchBuffers patchBuffers;
 
     //Parsing object of NMEA sentences
     //QScopedPointer<CNMEA> pn;
@@ -403,6 +437,7 @@ public:
     void fileCreateFlags();
     void fileCreateContour();
     void fileSaveContour();
+    void fileFlushSaves();
     void fileSaveBoundary();
     void fileCreateRecPath();
     void fileSaveHeadland();
@@ -410,6 +445,7 @@ public:
     void fileSaveFlags();
     void fileSaveNMEA();
     void fileSaveElevation();
+    void fileSaveCoverage();
     void fileSaveSingleFlagKML2(int flagNumber);
     void fileSaveSingleFlagKML(int flagNumber);
     void fileMakeKMLFromCurrentPosition(double lat, double lon);
@@ -430,10 +466,11 @@ public:
 
     bool isDay;
 
-    //data buffer for pixels read from off screen buffer
+    //section lookahead pixels, rasterized on the CPU each fix
     //uchar grnPixels[80001];
     LookAheadPixels grnPixels[80001];
     QImage grnPix;
+    CSectionRaster sectionRaster;
 
     /*
     QOpenGLShaderProgram *simpleColorShader = 0;
@@ -443,15 +480,14 @@ public:
     QOpenGLBuffer skyBuffer;
     QOpenGLBuffer flagsBuffer;
 
-    uint sentenceCounter = 0;
+    //reset by each fix on the GUI thread, counted up by the watchdog,
+    //read by the autosave check and the renderer
+    QAtomicInt sentenceCounter = 0;
 
 
     /***********************
      * UDPComm.designer.cs *
      ***********************/
-private:
-    QUdpSocket *udpSocket = NULL;
-
 public:
     bool isUDPServerOn = false;
 
@@ -488,7 +524,7 @@ public:
                              int count);
     */
     void drawManUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp);
-    void drawUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp);
+    void drawUTurnBtn(const CGuidanceState &g, QOpenGLFunctions *gl, QMatrix4x4 mvp);
     void makeFlagMark(QOpenGLFunctions *gl);
     void drawFlags(QOpenGLFunctions *gl, QMatrix4x4 mvp);
 
@@ -520,9 +556,16 @@ public:
     QString speedKPH();
     void processSectionOnOffRequests(bool isMapping);
     bool scanForNMEA();
+    void updateFixDisplay();
+
+    //copy what the renderer draws into guidanceSnapshot, with
+    //fixLock held
+    void publishGuidance();
 
     void jobNew();
-    void jobClose();
+    //flushSaves waits for the save thread, so it must be false when
+    //the caller holds fixLock and has flushed already
+    void jobClose(bool flushSaves = true);
 
     /**************************
      * SerialComm.Designer.cs *
@@ -531,11 +574,6 @@ private:
     QString portNameGPS = "COM GPS";
     int baudRateGPS = QSerialPort::Baud4800;
 
-    //serial port gps is connected to
-    QSerialPort sp;
-
-    void SerialLineReceived(QByteArray sentence);
-
 public:
 
     double actualSteerAngleDisp;
@@ -621,26 +659,24 @@ public slots:
     void openGLControl_Shutdown();
     //void openGLControl_Resize();
 
-    void openGLControlBack_Draw();
     void openGLControlBack_Initialized();
 
 
 
     /*
-     * from UDPComm.Designer.cs
+     * From Position.Designer.cs
      */
+    void processSectionLookahead(); //called at the end of every fix
 
-    void udpServerReadDatagrams();
+    //positioning thread finished a fix
+    void onFixProcessed();
 
-    /*
-     * From Position.Designer.cs
-     */
-    void processSectionLookahead(); //called when section lookahead GL stuff is rendered
+    //positioning thread could not open the GPS port
+    void onSerialError(const QString &portName, const QString &error);
 
-    /**************************
-     * SerialComm.Designer.cs *
-     **************************/
-    void sp_DataReceived();
+    //field files read so far, and the whole field read, see fileOpenField()
+    void onFieldLoadProgress(const QString &filename, int filesDone, int filesTotal);
+    void onFieldLoaded();
 
     /*
      * simulator
@@ -31,6 +31,7 @@ void FormGPS::openGLControl_Draw()
 
     QOpenGLContext *glContext = QOpenGLContext::currentContext();
     QOpenGLFunctions *gl = glContext->functions();
+    beginGLFrame();
     //int width = glContext->surface()->size().width();
     //int height = glContext->surface()->size().height();
     QMatrix4x4 projection;
@@ -80,7 +81,7 @@ void FormGPS::openGLControl_Draw()
 
     int deadCam = 0;
 
-    if(sentenceCounter > 99)
+    if(sentenceCounter.load() > 99)
     {
         gl->glEnable(GL_BLEND);
 
@@ -203,7 +204,9 @@ void FormGPS::openGLControl_Draw()
             modelview.setToIdentity();
 
             //camera does translations and rotations
-            camera.setWorldCam(modelview, vehicle.pivotAxlePos.easting + offX, vehicle.pivotAxlePos.northing + offY, camera.camHeading);
+            //camera follows the last published fix, not one half done
+            CPositionState position = positionSnapshot.read();
+            camera.setWorldCam(modelview, position.pivotAxlePos.easting + offX, position.pivotAxlePos.northing + offY, position.camHeading);
 
             //calculate the frustum planes for culling
             calcFrustum(projection*modelview);
@@ -240,107 +243,95 @@ void FormGPS::openGLControl_Draw()
             //we'll have to do it with LINES
             //if (isDrawPolygons) gl->glPolygonMode(GL_FRONT, GL_LINE);
 
-            //draw patches of sections
-            for (int j = 0; j < tool_numSuperSection; j++)
+            //the guidance lines, U-turn, tool and sections are drawn as
+            //they were at the end of the last fix. The positioning thread
+            //only hands over a new snapshot, it never waits on the frame.
+            QSharedPointer<const CGuidanceState> g = guidanceSnapshot.read();
+
+            //draw patches of sections. Sealed patches are batched into
+            //one strip per field tile, coarser the further out the camera
+            //is. Only the live patch of each section that is still
+            //growing gets checked point by point.
+            QVector<QSharedPointer<TriangleList>> livePatches;
+            QVector<TriangleList> livePoints;
             {
-                //every time the section turns off and on is a new patch
+                //the fix lock is only held to copy what addMappingPoint
+                //keeps growing. The copies are shared with the live lists
+                //until the next point is added, so this is cheap.
+                QMutexLocker fixLocker(&fixLock);
 
-                //check if in frustum or not
-                bool isDraw;
-                int patches = tool.section[j].patchList.size();
+                patchBuffers.takeSealed(tool.patchIndex);
 
-                if (patches > 0)
+                for (int j = 0; j < tool_numSuperSection; j++)
                 {
-                    //initialize the steps for mipmap of triangles (skipping detail while zooming out)
-                    /* Unused since we use the triangle lists directly with the buffers
-                    int mipmap = 0;
-                    if (camera.camSetDistance < -800) mipmap = 2;
-                    if (camera.camSetDistance < -1500) mipmap = 4;
-                    if (camera.camSetDistance < -2400) mipmap = 8;
-                    if (camera.camSetDistance < -4800) mipmap = 16;
-                    */
-                    //for every new chunk of patch
-
-                    //foreach is a Qt macro that iterates over Qt containers
-                    foreach (QSharedPointer<TriangleList> triList, tool.section[j].patchList)
-                    {
-                        isDraw = false;
-                        int count2 = triList->size();
-                        for (int i = 1; i < count2; i += 3) //first vertice is color
-                        {
-                            //determine if point is in frustum or not, if < 0, its outside so abort, z always is 0
-                            //x is easting, y is northing
-                            if (frustum[0] * (*triList)[i].x() + frustum[1] * (*triList)[i].y() + frustum[3] <= 0)
-                                continue;//right
-                            if (frustum[4] * (*triList)[i].x() + frustum[5] * (*triList)[i].y() + frustum[7] <= 0)
-                                continue;//left
-                            if (frustum[16] * (*triList)[i].x() + frustum[17] * (*triList)[i].y() + frustum[19] <= 0)
-                                continue;//bottom
-                            if (frustum[20] * (*triList)[i].x() + frustum[21] * (*triList)[i].y() + frustum[23] <= 0)
-                                continue;//top
-                            if (frustum[8] * (*triList)[i].x() + frustum[9] * (*triList)[i].y() + frustum[11] <= 0)
-                                continue;//far
-                            if (frustum[12] * (*triList)[i].x() + frustum[13] * (*triList)[i].y() + frustum[15] <= 0)
-                                continue;//near
-
-                            //point is in frustum so draw the entire patch. The downside of triangle strips.
-                            isDraw = true;
-                            break;
-                        }
-
-                        if (isDraw)
-                        {
-                            //QVector<QVector3D> vertices;
-                            QOpenGLBuffer triBuffer;
-
-                            triBuffer.create();
-                            triBuffer.bind();
+                    if (!tool.section[j].isMappingOn || tool.section[j].patchList.size() == 0) continue;
 
-                            //triangle lists are now using QVector3D, so we can allocate buffers
-                            //directly from list data.
-                            triBuffer.allocate(triList->data() + 1, (count2-1) * sizeof(QVector3D));
-                            triBuffer.release();
+                    livePatches.append(tool.section[j].patchList.last());
+                    livePoints.append(*tool.section[j].patchList.last());
+                }
+            }
 
-                            glDrawArraysColor(gl,projection*modelview,
-                                              GL_TRIANGLE_STRIP, sectionColor,
-                                              triBuffer,GL_FLOAT,count2-1);
+            patchBuffers.drawSealed(gl, projection*modelview, sectionColor, frustum,
+                                    CPatchIndex::lodForDistance(camera.camSetDistance));
 
-                            triBuffer.destroy();
-                        }
-                    }
+            for (int p = 0; p < livePatches.size(); p++)
+            {
+                const TriangleList &triList = livePoints[p];
+                int count2 = triList.size();
+                for (int i = 1; i < count2; i += 3) //first vertice is color
+                {
+                    //determine if point is in frustum or not, if < 0, its outside so abort, z always is 0
+                    //x is easting, y is northing
+                    if (frustum[0] * triList[i].x() + frustum[1] * triList[i].y() + frustum[3] <= 0)
+                        continue;//right
+                    if (frustum[4] * triList[i].x() + frustum[5] * triList[i].y() + frustum[7] <= 0)
+                        continue;//left
+                    if (frustum[16] * triList[i].x() + frustum[17] * triList[i].y() + frustum[19] <= 0)
+                        continue;//bottom
+                    if (frustum[20] * triList[i].x() + frustum[21] * triList[i].y() + frustum[23] <= 0)
+                        continue;//top
+                    if (frustum[8] * triList[i].x() + frustum[9] * triList[i].y() + frustum[11] <= 0)
+                        continue;//far
+                    if (frustum[12] * triList[i].x() + frustum[13] * triList[i].y() + frustum[15] <= 0)
+                        continue;//near
+
+                    //point is in frustum so draw the entire patch. The downside of triangle strips.
+                    //buffer is kept between frames, only new points
+                    //of the live patch get uploaded
+                    patchBuffers.drawPatch(gl, projection*modelview,
+                                           sectionColor, livePatches[p], triList);
+                    break;
                 }
             }
+            patchBuffers.endFrame();
 
             // the follow up to sections patches
-            int patchCount = 0;
-
             if (autoBtnState == btnStates::Auto || manualBtnState == btnStates::On)
             {
                 //section patch color
-                if (tool.section[tool_numOfSections].isSectionOn && tool.section[tool_numOfSections].patchList.count() > 0)
+                if (g->section[tool_numOfSections].isSectionOn && g->section[tool_numOfSections].hasPatch)
                 {
-                    patchCount = tool.section[tool_numOfSections].patchList.count();
+                    const CGuidanceState::Section &section = g->section[tool_numOfSections];
 
                     //draw the triangle in each triangle strip
                     gldraw1.clear();
 
                     //left side of triangle
-                    QVector3D pt((vehicle.cosSectionHeading * tool.section[tool_numOfSections].positionLeft) + vehicle.toolPos.easting,
-                            (vehicle.sinSectionHeading * tool.section[tool_numOfSections].positionLeft) + vehicle.toolPos.northing, 0);
+                    QVector3D pt((g->cosSectionHeading * section.positionLeft) + g->toolPos.easting,
+                            (g->sinSectionHeading * section.positionLeft) + g->toolPos.northing, 0);
                     gldraw1.append(pt);
 
                     //TODO: label3.Text = pt.northing.ToString();
 
                     //Right side of triangle
-                    pt = QVector3D((vehicle.cosSectionHeading * tool.section[tool_numOfSections].positionRight) + vehicle.toolPos.easting,
-                       (vehicle.sinSectionHeading * tool.section[tool_numOfSections].positionRight) + vehicle.toolPos.northing, 0);
+                    pt = QVector3D((g->cosSectionHeading * section.positionRight) + g->toolPos.easting,
+                       (g->sinSectionHeading * section.positionRight) + g->toolPos.northing, 0);
                     gldraw1.append(pt);
 
-                    int last = tool.section[tool_numOfSections].patchList[patchCount - 1]->count();
                     //antenna
-                    gldraw1.append((*tool.section[tool_numOfSections].patchList[patchCount - 1])[last - 2]);
-                    gldraw1.append((*tool.section[tool_numOfSections].patchList[patchCount - 1])[last - 1]);
-                    //TODO: label4.Text = (*tool.section[tool_numOfSections].patchList[patchCount - 1])[last - 2].y().ToString();
+                    gldraw1.append(section.patchLeft);
+                    gldraw1.append(section.patchRight);
+                    //TODO: label4.Text = section.patchLeft.y().ToString();
 
                     gldraw1.draw(gl, projection*modelview, sectionColor, GL_TRIANGLE_STRIP, 1.0f);
 
@@ -349,28 +340,28 @@ void FormGPS::openGLControl_Draw()
                 {
                     for (int j = 0; j < tool_numSuperSection; j++)
                     {
-                        if (tool.section[j].isSectionOn && tool.section[j].patchList.count() > 0)
+                        const CGuidanceState::Section &section = g->section[j];
+
+                        if (section.isSectionOn && section.hasPatch)
                         {
                             gldraw1.clear();
-                            patchCount = tool.section[j].patchList.count();
 
                             //draw the triangle in each triangle strip
                             //left side of triangle
-                            QVector3D pt((vehicle.cosSectionHeading * tool.section[j].positionLeft) + vehicle.toolPos.easting,
-                                    (vehicle.sinSectionHeading * tool.section[j].positionLeft) + vehicle.toolPos.northing, 0);
+                            QVector3D pt((g->cosSectionHeading * section.positionLeft) + g->toolPos.easting,
+                                    (g->sinSectionHeading * section.positionLeft) + g->toolPos.northing, 0);
                             gldraw1.append(pt);
                             //TODO: label3.Text = pt.northing.ToString();
 
                             //Right side of triangle
-                            pt = QVector3D((vehicle.cosSectionHeading * tool.section[j].positionRight) + vehicle.toolPos.easting,
-                               (vehicle.sinSectionHeading * tool.section[j].positionRight) + vehicle.toolPos.northing, 0);
+                            pt = QVector3D((g->cosSectionHeading * section.positionRight) + g->toolPos.easting,
+                               (g->sinSectionHeading * section.positionRight) + g->toolPos.northing, 0);
                             gldraw1.append(pt);
 
-                            int last = tool.section[j].patchList[patchCount - 1]->count();
                             //antenna
-                            gldraw1.append((*tool.section[j].patchList[patchCount - 1])[last - 2]);
-                            gldraw1.append((*tool.section[j].patchList[patchCount - 1])[last - 1]);
-                            //TODO: label4.Text = (*tool.section[j].patchList[patchCount - 1])[last - 2].y().ToString();
+                            gldraw1.append(section.patchLeft);
+                            gldraw1.append(section.patchRight);
+                            //TODO: label4.Text = section.patchLeft.y().ToString();
 
                             gldraw1.draw(gl,projection*modelview, sectionColor, GL_TRIANGLE_STRIP, 1.0f);
                         }
@@ -379,14 +370,14 @@ void FormGPS::openGLControl_Draw()
             }
 
             //draw contour line if button on
-            if (ct.isContourBtnOn)
+            if (g->isContourBtnOn)
             {
-                ct.drawContourLine(gl, projection*modelview);
+                ct.drawContourLine(*g, gl, projection*modelview);
             }
             else// draw the current and reference AB Lines or CurveAB Ref and line
             {
-                if (ABLine.isABLineSet | ABLine.isABLineBeingSet) ABLine.drawABLines(gl, projection*modelview, yt, tram, camera);
-                if (curve.isBtnCurveOn) curve.drawCurve(gl, projection*modelview, vehicle, yt, tram, camera);
+                if (g->isABLineSet | g->isABLineBeingSet) ABLine.drawABLines(*g, gl, projection*modelview, yt, tram, camera);
+                if (g->isBtnCurveOn) curve.drawCurve(*g, gl, projection*modelview, yt, tram, camera);
             }
 
             //if (recPath.isRecordOn)
@@ -397,16 +388,16 @@ void FormGPS::openGLControl_Draw()
             bnd.drawBoundaryLines(vehicle, gl, projection*modelview);
 
             //draw the turnLines
-            if (yt.isYouTurnBtnOn)
+            if (g->isYouTurnBtnOn)
             {
-                if (!ABLine.isEditing && !curve.isEditing && !ct.isContourBtnOn)
+                if (!g->isABEditing && !g->isCurveEditing && !g->isContourBtnOn)
                 {
                     turn.drawTurnLines(bnd, gl, projection*modelview);
                 }
             }
-            else if (!yt.isYouTurnBtnOn && SETTINGS_DISPLAY_UTURNALWAYSON)
+            else if (!g->isYouTurnBtnOn && SETTINGS_DISPLAY_UTURNALWAYSON)
             {
-                if (!ABLine.isEditing && !curve.isEditing && !ct.isContourBtnOn)
+                if (!g->isABEditing && !g->isCurveEditing && !g->isContourBtnOn)
                 {
                     turn.drawTurnLines(bnd, gl, projection*modelview);
                 }
@@ -424,7 +415,7 @@ void FormGPS::openGLControl_Draw()
                 gl->glLineWidth(SETTINGS_DISPLAY_LINEWIDTH);
                 gldraw1.clear();
                 //TODO: implement with shader: GL.LineStipple(1, 0x0707);
-                gldraw1.append(QVector3D(vehicle.pivotAxlePos.easting, vehicle.pivotAxlePos.northing, 0));
+                gldraw1.append(QVector3D(g->pivotAxlePos.easting, g->pivotAxlePos.northing, 0));
                 gldraw1.append(QVector3D(flagPts[flagNumberPicked-1].easting, flagPts[flagNumberPicked-1].northing, 0));
                 gldraw1.draw(gl, projection*modelview,
                              QColor::fromRgbF(0.930f, 0.72f, 0.32f),
@@ -433,8 +424,8 @@ void FormGPS::openGLControl_Draw()
 
 
             //draw the vehicle/implement
-            tool.drawTool(vehicle, camera, gl, modelview, projection);
-            vehicle.drawVehicle(gl, modelview, projection, camera, bnd, hd, ct, curve, ABLine);
+            tool.drawTool(*g, camera, gl, modelview, projection);
+            vehicle.drawVehicle(*g, gl, modelview, projection, camera, bnd);
 
             // 2D Ortho --------------------------
             //no need to "push" matrix since it will be regenerated next time
@@ -445,6 +436,9 @@ void FormGPS::openGLControl_Draw()
             //  Create the appropriate modelview matrix.
             modelview.setToIdentity();
 
+            //HUD text is collected and drawn in one go at the end
+            beginTextBatch();
+
             if(SETTINGS_DISPLAY_SKYON) drawSky(gl, projection*modelview, width, height);
 
             if(SETTINGS_DISPLAY_LIGHTBARON) {
@@ -452,7 +446,7 @@ void FormGPS::openGLControl_Draw()
                 drawLightBarText(gl, projection*modelview, width, height);
             }
 
-            if (bnd.bndArr.size() > 0 && yt.isYouTurnBtnOn) drawUTurnBtn(gl, projection*modelview);
+            if (bnd.bndArr.size() > 0 && g->isYouTurnBtnOn) drawUTurnBtn(*g, gl, projection*modelview);
 
             //Manual UTurn buttons are now in QML and are manipulated
             //in tmrWatchdog_timeout()
@@ -472,6 +466,8 @@ void FormGPS::openGLControl_Draw()
 
             }
 
+            endTextBatch(gl);
+
             gl->glFlush();
 
             //draw the zoom window
@@ -494,8 +490,8 @@ void FormGPS::openGLControl_Draw()
 
         //qmlview->resetOpenGLState();
 
-        //directly call section lookahead GL stuff from here
-        openGLControlBack_Draw();
+        //section lookahead is rasterized on the CPU in
+        //processSectionLookahead(), no back buffer to draw here.
         gl->glFlush();
     }
 }
@@ -553,176 +549,10 @@ void FormGPS::openGLControl_Shutdown()
     destroyTextures();
     //destroy any openGL buffers.
     worldGrid.destroyGLBuffers();
-}
-
-//main openGL draw function
-void FormGPS::openGLControlBack_Draw()
-{
-    //Because this is potentially running in another thread, we cannot
-    //safely make any GUI calls to set buttons, etc.  So instead, we
-    //do the GL drawing here and get the lookahead pixmap from GL here.
-    //After this, this widget will emit a finished signal, where the main
-    //thread can then run the second part of this function, which I've
-    //split out into its own function.
-    QOpenGLContext *glContext = QOpenGLContext::currentContext();
-    QMatrix4x4 projection;
-    QMatrix4x4 modelview;
-
-    GLHelperOneColor gldraw;
-
-    USE_SETTINGS;
-
-    int tool_numSuperSection = SETTINGS_TOOL_NUMSECTIONS + 1;
-
-    /* use the QML context with an offscreen surface to draw
-     * the lookahead triangles
-     */
-    if (!backFBO ) {
-        QOpenGLFramebufferObjectFormat format;
-        format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-        //TODO: backFBO is leaking... delete it in the destructor?
-        //I think context has to be active to delete it...
-        backFBO = new QOpenGLFramebufferObject(QSize(500,500),format);
-    }
-
-    glContext->makeCurrent(&backSurface);
-    backFBO->bind();
-    glContext->functions()->glViewport(0,0,500,500);
-    QOpenGLFunctions *gl = glContext->functions();
-
-    //int width = glContext->surface()->size().width();
-    //int height = glContext->surface()->size().height();
-
-    gl->glPixelStorei(GL_PACK_ALIGNMENT, 1);
-
-    //  Load the identity.
-    projection.setToIdentity();
-
-    //projection.perspective(6.0f,1,1,6000);
-    projection.perspective(glm::toDegrees((double)0.104719758f), 1.0f, 50.0f, 520.0f);
-
-    gl->glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    gl->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);	// Clear The Screen And The Depth Buffer
-    //gl->glLoadIdentity();					// Reset The View
-    modelview.setToIdentity();
-
-    //back the camera up
-    modelview.translate(0, 0, -480);
-
-    //rotate camera so heading matched fix heading in the world
-    //gl->glRotated(toDegrees(fixHeadingSection), 0, 0, 1);
-    modelview.rotate(glm::toDegrees(vehicle.toolPos.heading), 0, 0, 1);
-
-    //translate to that spot in the world
-    modelview.translate(-vehicle.toolPos.easting, -vehicle.toolPos.northing, 0);
-
-    //patch color
-    QColor patchColor = QColor::fromRgbF(0.0f, 0.5f, 0.0f);
-
-    //to draw or not the triangle patch
-    bool isDraw;
-
-    //calculate the frustum for the section control window
-    calcFrustum(projection*modelview);
-
-    //draw patches j= # of sections
-    for (int j = 0; j < tool_numSuperSection; j++)
-    {
-        //every time the section turns off and on is a new patch
-        int patchCount = tool.section[j].patchList.size();
-
-        if (patchCount > 0)
-        {
-            //for every new chunk of patch
-            foreach (QSharedPointer<QVector<QVector3D>> triList, tool.section[j].patchList)
-            {
-                isDraw = false;
-                int count2 = triList->size();
-                for (int i = 1; i < count2; i+=3)
-                {
-                    //determine if point is in frustum or not
-                    //x is easting, y is northing
-                    if (frustum[0] * (*triList)[i].x() + frustum[1] * (*triList)[i].y() + frustum[3] <= 0)
-                        continue;//right
-                    if (frustum[4] * (*triList)[i].x() + frustum[5] * (*triList)[i].y() + frustum[7] <= 0)
-                        continue;//left
-                   if (frustum[16] * (*triList)[i].x() + frustum[17] * (*triList)[i].y() + frustum[19] <= 0)
-                        continue;//bottom
-                    if (frustum[20] * (*triList)[i].x() + frustum[21] * (*triList)[i].y() + frustum[23] <= 0)
-                        continue;//top
-
-                    //point is in frustum so draw the entire patch
-                    isDraw = true;
-                    break;
-                }
-
-                if (isDraw)
-                {
-                    QOpenGLBuffer triBuffer;
-
-                    triBuffer.create();
-                    triBuffer.bind();
-
-                    //triangle lists are now using QVector3D, so we can allocate buffers
-                    //directly from list data.
-
-                    //first vertice is color, so we should skip it
-                    triBuffer.allocate(triList->data() + 1, (count2-1) * sizeof(QVector3D));
-                    //triBuffer.allocate(triList->data(), count2 * sizeof(QVector3D));
-                    triBuffer.release();
-
-                    //draw the triangles in each triangle strip
-                    glDrawArraysColor(gl,projection*modelview,
-                                      GL_TRIANGLE_STRIP, patchColor,
-                                      triBuffer,GL_FLOAT,count2-1);
-
-                    triBuffer.destroy();
-                }
-            }
-        }
-    }
-
-    //draw bright green on back buffer
-    if (bnd.bndArr.count() > 0)
-    {
-        ////draw the bnd line
-        int ptCount = bnd.bndArr[0].bndLine.count();
-        if (ptCount > 1)
-        {
-            gl->glLineWidth(2);
-            for (int h = 0; h < ptCount; h++)
-                gldraw.append(QVector3D(bnd.bndArr[0].bndLine[h].easting, bnd.bndArr[0].bndLine[h].northing, 0));
-
-            gldraw.draw( gl, projection*modelview, QColor::fromRgbF(0.0f, 0.99f, 0.0f),
-                         GL_LINE_STRIP, 2.0);
-        }
-    }
-
-    //draw the headland
-    if (hd.isOn) hd.drawHeadLinesBack(gl, projection*modelview);
-
-    //finish it up - we need to read the ram of video card
-    gl->glFlush();
-
-    //read the whole block of pixels up to max lookahead, one read only
-    //we'll use Qt's QImage function to grab it.
-    grnPix = backFBO->toImage().mirrored().convertToFormat(QImage::Format_RGBX8888);
-    //qDebug() << grnPix.size();
-    QImage temp = grnPix.copy(tool.rpXPosition, 250, tool.rpWidth, 245 /*(int)rpHeight*/);
-    memcpy(grnPixels, temp.constBits(), temp.size().width() * temp.size().height() * 4);
-    //grnPix = temp;
-
-    //The remaining codesteerSlider the original method in the C# code is
-    //broken out into a callback in formgps.c called
-    //processSectionLookahead().
-
-    glContext->functions()->glFlush();
-
-    //restore QML's context
-    backFBO->bindDefault();
-    glContext->doneCurrent();
-    glContext->makeCurrent(this);
-    resetOpenGLState();
+    patchBuffers.destroyGLBuffers();
+    destroyTextBuffers();
+    destroyStreamBuffers();
+    destroyGeometryBuffers();
 }
 
 //Draw section OpenGL window, not visible
@@ -750,7 +580,7 @@ void  FormGPS::drawManUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp)
     gldraw.draw(gl, mvp, Textures::TURNMANUAL, GL_TRIANGLE_STRIP, true, QColor::fromRgbF(0.90f, 0.90f, 0.293f));
 }
 
-void FormGPS::drawUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp)
+void FormGPS::drawUTurnBtn(const CGuidanceState &g, QOpenGLFunctions *gl, QMatrix4x4 mvp)
 {
     QColor color;
     Textures whichtex;
@@ -758,10 +588,10 @@ void FormGPS::drawUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp)
     VertexTexcoord vt;
     QLocale locale;
 
-    if (!yt.isYouTurnTriggered)
+    if (!g.isYouTurnTriggered)
     {
         whichtex = Textures::TURN;
-        if (distancePivotToTurnLine > 0 && !yt.isOutOfBounds) color = QColor::fromRgbF(0.3f, 0.95f, 0.3f);
+        if (g.distancePivotToTurnLine > 0 && !g.isOutOfBounds) color = QColor::fromRgbF(0.3f, 0.95f, 0.3f);
         else color = QColor::fromRgbF(0.97f, 0.635f, 0.4f);
     }
     else
@@ -771,7 +601,7 @@ void FormGPS::drawUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp)
     }
 
     int two3 = qmlItem(qml_root, "openglcontrol")->property("width").toReal() / 5;
-    if (!yt.isYouTurnRight)
+    if (!g.isYouTurnRight)
     {
         vt.texcoord = QVector2D(0, 0); vt.vertex = QVector3D(-62 + two3, 50,0); //
         gldraw.append(vt);
@@ -799,25 +629,25 @@ void FormGPS::drawUTurnBtn(QOpenGLFunctions *gl, QMatrix4x4 mvp)
     // Done Building Triangle Strip
     if (SETTINGS_DISPLAY_ISMETRIC)
     {
-        if (!yt.isYouTurnTriggered)
+        if (!g.isYouTurnTriggered)
         {
             //drawText(gl, mvp, -30 + two3, 80, DistPivotM, 1.0, true, color);
         }
         else
         {
-            drawText(gl, mvp, -30 + two3, 80, locale.toString(yt.onA), 1.0, true, color);
+            drawText(gl, mvp, -30 + two3, 80, locale.toString(g.onA), 1.0, true, color);
         }
     }
     else
     {
 
-        if (!yt.isYouTurnTriggered)
+        if (!g.isYouTurnTriggered)
         {
             //drawText(gl, mvp, -40 + two3, 85, DistPivotFt, 1.0, true, color);
         }
         else
         {
-            drawText(gl, mvp, -40 + two3, 85, locale.toString(yt.onA), 1.0, true, color);
+            drawText(gl, mvp, -40 + two3, 85, locale.toString(g.onA), 1.0, true, color);
         }
     }
 
@@ -1136,6 +966,7 @@ void FormGPS::drawSky(QOpenGLFunctions *gl, QMatrix4x4 mvp, int width, int heigh
             if (skyBuffer.isCreated())
                 skyBuffer.destroy();
             skyBuffer.create();
+            glFrameStats.buffersCreated++;
             skyBuffer.bind();
             skyBuffer.allocate(vertices,4*sizeof(VertexTexcoord));
             //skyBuffer.allocate(vertices,4*sizeof(QVector3D));
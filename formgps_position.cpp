@@ -16,11 +16,12 @@
 #include "aogrenderer.h"
 #include "aogsettings.h"
 
-//called by watchdog timer every 50 ms
+//called on the positioning thread with fixLock held, as soon as new
+//bytes are framed. Returns true once a whole fix has been processed.
 bool FormGPS::scanForNMEA()
 {
     double nowHz;
-    //parse any data from pn.rawBuffer
+    //parse any sentences waiting in the NMEA ring buffer
     //qDebug() << stopwatch.restart();
 
     //pass in the last heading we had and the last roll
@@ -58,10 +59,10 @@ bool FormGPS::scanForNMEA()
 //call for position update after valid NMEA sentence
 void FormGPS::updateFixPosition()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double minFixStepDist = SETTINGS_VEHICLE_MINFIXSTEP;
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
+    double minFixStepDist = snapshot->vehicleMinFixStep;
+    int tool_numOfSections = snapshot->toolNumSections;
 
     startCounter++;
     totalFixSteps = fixUpdateHz * 6;
@@ -160,7 +161,7 @@ void FormGPS::updateFixPosition()
             addSectionOrContourPathPoints();
 
             //grab fix and elevation
-            if (SETTINGS_GPS_LOGELEVATION)
+            if (snapshot->gpsLogElevation)
             {
                 sbFix.append(QByteArray::number(pn.fix.easting, 'f', 2));
                 sbFix.append(",");
@@ -282,7 +283,7 @@ void FormGPS::updateFixPosition()
     //TODO: sendOutUSBAutoSteerPort(mc.autoSteerData, pgnSentenceLength);
 
     //send out to network
-    if (SETTINGS_COMM_UDPISON)
+    if (snapshot->commUdpIsOn)
     {
         //send autosteer since it never is logic controlled
         sendUDPMessage(mc.autoSteerData);
@@ -341,7 +342,7 @@ void FormGPS::updateFixPosition()
                         }
                         else
                         {
-                            if (SETTINGS_VEHICLE_ISUSINGDUBINSTURN)
+                            if (snapshot->vehicleIsUsingDubinsTurn)
                             {
                                 if (ABLine.isABLineSet) yt.buildABLineDubinsYouTurn(vehicle, bnd, gf,
                                                                                     ABLine, turn, mazeGrid,
@@ -709,29 +710,134 @@ void FormGPS::updateFixPosition()
     // end adds by MTZ8302 ------------------------------------------------------------------------------------
     //#endregion
 
-    //openGLControl_Draw routine triggered manually
-    update();
-    AOGRendererInSG *renderer = qml_root->findChild<AOGRendererInSG *>("openglcontrol");
-    renderer->update();
-
-    //since we're in the main thread we can directly call processSectionLookahead()
-    //Do we need to move this somewhere else? I don't think so.
+    //section control works straight off the CPU raster, so it stays
+    //in this thread with the rest of the fix
     processSectionLookahead();
 
+    //hand the result to the renderer and the UI, onFixProcessed()
+    //triggers the redraw
+    CPositionState position;
+    position.fix = pn.fix;
+    position.pivotAxlePos = vehicle.pivotAxlePos;
+    position.steerAxlePos = vehicle.steerAxlePos;
+    position.toolPos = vehicle.toolPos;
+    position.fixHeading = vehicle.fixHeading;
+    position.camHeading = camera.camHeading;
+    position.speed = pn.speed;
+    position.guidanceLineDistanceOff = vehicle.guidanceLineDistanceOff;
+    position.guidanceLineSteerAngle = vehicle.guidanceLineSteerAngle;
+    for (int j = 0; j < MAXSECTIONS; j++)
+    {
+        if (tool.section[j].isSectionOn) position.sectionOnBits |= (1u << j);
+    }
+    positionSnapshot.publish(position);
+
+    publishGuidance();
+}
+
+void FormGPS::publishGuidance()
+{
+    QSharedPointer<CGuidanceState> g(new CGuidanceState);
+
+    g->isContourBtnOn = ct.isContourBtnOn;
+    g->ctList = ct.ctList;
+    g->goalPointCT = ct.goalPointCT;
+    g->ctDistanceFromCurrentLine = ct.distanceFromCurrentLine;
+
+    g->isABLineSet = ABLine.isABLineSet;
+    g->isABLineBeingSet = ABLine.isABLineBeingSet;
+    g->isBtnABLineOn = ABLine.isBtnABLineOn;
+    g->isABEditing = ABLine.isEditing;
+    g->isABSameAsVehicleHeading = ABLine.isABSameAsVehicleHeading;
+    g->refPoint1 = ABLine.refPoint1;
+    g->refPoint2 = ABLine.refPoint2;
+    g->refABLineP1 = ABLine.refABLineP1;
+    g->refABLineP2 = ABLine.refABLineP2;
+    g->currentABLineP1 = ABLine.currentABLineP1;
+    g->currentABLineP2 = ABLine.currentABLineP2;
+    g->goalPointAB = ABLine.goalPointAB;
+    g->abHeading = ABLine.abHeading;
+    g->passNumber = ABLine.passNumber;
+
+    g->isBtnCurveOn = curve.isBtnCurveOn;
+    g->isCurveSet = curve.isCurveSet;
+    g->isCurveEditing = curve.isEditing;
+    g->isSmoothWindowOpen = curve.isSmoothWindowOpen;
+    g->refList = curve.refList;
+    g->curList = curve.curList;
+    g->smooList = curve.smooList;
+    g->goalPointCu = curve.goalPointCu;
+    g->radiusPointCu = curve.radiusPointCu;
+    g->ppRadiusCu = curve.ppRadiusCu;
+    g->aveLineHeading = curve.aveLineHeading;
+    g->curveNumber = curve.curveNumber;
+
+    g->isYouTurnBtnOn = yt.isYouTurnBtnOn;
+    g->isYouTurnTriggered = yt.isYouTurnTriggered;
+    g->isYouTurnRight = yt.isYouTurnRight;
+    g->isOutOfBounds = yt.isOutOfBounds;
+    g->isRecordingCustomYouTurn = yt.isRecordingCustomYouTurn;
+    g->ytList = yt.ytList;
+    g->youFileList = yt.youFileList;
+    g->onA = yt.onA;
+    g->distancePivotToTurnLine = distancePivotToTurnLine;
+
+    g->fixHeading = vehicle.fixHeading;
+    g->cosSectionHeading = vehicle.cosSectionHeading;
+    g->sinSectionHeading = vehicle.sinSectionHeading;
+    g->pivotAxlePos = vehicle.pivotAxlePos;
+    g->toolPos = vehicle.toolPos;
+    g->tankPos = vehicle.tankPos;
+    g->hydLiftLookAheadDistanceLeft = vehicle.hydLiftLookAheadDistanceLeft;
+    g->hydLiftLookAheadDistanceRight = vehicle.hydLiftLookAheadDistanceRight;
+    g->isToolUp = hd.isToolUp;
+    g->toolFarLeftPosition = tool.toolFarLeftPosition;
+    g->toolFarRightPosition = tool.toolFarRightPosition;
+    g->lookAheadDistanceOnPixelsLeft = tool.lookAheadDistanceOnPixelsLeft;
+    g->lookAheadDistanceOnPixelsRight = tool.lookAheadDistanceOnPixelsRight;
+    g->lookAheadDistanceOffPixelsLeft = tool.lookAheadDistanceOffPixelsLeft;
+    g->lookAheadDistanceOffPixelsRight = tool.lookAheadDistanceOffPixelsRight;
+
+    for (int j = 0; j <= MAXSECTIONS; j++)
+    {
+        const CSection &section = tool.section[j];
+        CGuidanceState::Section &out = g->section[j];
+
+        out.isSectionOn = section.isSectionOn;
+        out.manBtnState = section.manBtnState;
+        out.positionLeft = section.positionLeft;
+        out.positionRight = section.positionRight;
+
+        if (section.patchList.size() > 0)
+        {
+            const TriangleList &patch = *section.patchList.last();
+            int last = patch.size();
+
+            //first vertex is the color
+            if (last >= 3)
+            {
+                out.hasPatch = true;
+                out.patchLeft = patch[last - 2];
+                out.patchRight = patch[last - 1];
+            }
+        }
+    }
+
+    guidanceSnapshot.publish(g);
 }
 
 void FormGPS::calculatePositionHeading()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    double wheelbase = SETTINGS_VEHICLE_WHEELBASE;
-    double antennaPivot = SETTINGS_VEHICLE_ANTENNAPIVOT;
-    double tool_toolWidth = SETTINGS_TOOL_WIDTH;
-    double tool_hitchLength = SETTINGS_TOOL_HITCHLENGTH;
-    bool tool_isToolTrailing = SETTINGS_TOOL_ISTRAILING;
-    bool tool_isToolTBT = SETTINGS_TOOL_ISTBT;
-    double tool_toolTankTrailingHitchLength = SETTINGS_TOOL_TANKTRAILINGHITCHLENGTH;
-    double tool_toolTrailingHitchLength = SETTINGS_TOOL_TRAILINGHITCHLENGTH;
+    double wheelbase = snapshot->vehicleWheelbase;
+    double antennaPivot = snapshot->vehicleAntennaPivot;
+    double tool_toolWidth = snapshot->toolWidth;
+    double tool_hitchLength = snapshot->toolHitchLength;
+    bool tool_isToolTrailing = snapshot->toolIsTrailing;
+    bool tool_isToolTBT = snapshot->toolIsTBT;
+    double tool_toolTankTrailingHitchLength = snapshot->toolTankTrailingHitchLength;
+    double tool_toolTrailingHitchLength = snapshot->toolTrailingHitchLength;
 
 
     if (!simTimer.isActive()) // use heading true if using simulator
@@ -765,8 +871,8 @@ void FormGPS::calculatePositionHeading()
     }
 
     //an IMU with heading correction, add the correction
-    if (SETTINGS_GPS_ISHEADINGCORRECTIONFROMBRICK || SETTINGS_GPS_ISHEADINGCORRECTIONFROMAUTOSTEER ||
-            SETTINGS_GPS_ISHEADINGCORRECTIONFROMEXTUDP)
+    if (snapshot->gpsIsHeadingCorrectionFromBrick || snapshot->gpsIsHeadingCorrectionFromAutoSteer ||
+            snapshot->gpsIsHeadingCorrectionFromExtUdp)
     {
         //current gyro angle in radians
         double correctionHeading = (glm::toRadians((double)ahrs.correctionHeadingX16 * 0.0625));
@@ -982,9 +1088,9 @@ void FormGPS::addBoundaryPoint()
 //add the points for section, contour line points, Area Calc feature
 void FormGPS::addSectionOrContourPathPoints()
 {
-    USE_SETTINGS;
+    USE_SETTINGS_SNAPSHOT;
 
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
+    int tool_numOfSections = snapshot->toolNumSections;
 
     if (recPath.isRecordOn)
     {
@@ -1050,11 +1156,11 @@ void FormGPS::addSectionOrContourPathPoints()
 //calculate the extreme tool left, right velocities, each section lookahead, and whether or not its going backwards
 void FormGPS::calculateSectionLookAhead(double northing, double easting, double cosHeading, double sinHeading)
 {
-    USE_SETTINGS;
-    double hydLiftLookAheadTime = SETTINGS_VEHICLE_HYDLIFTLOOKAHEAD;
-    int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
-    double tool_lookAheadOnSetting = SETTINGS_TOOL_LOOKAHEADON;
-    double tool_lookAheadOffSetting = SETTINGS_TOOL_LOOKAHEADOFF;
+    USE_SETTINGS_SNAPSHOT;
+    double hydLiftLookAheadTime = snapshot->vehicleHydLiftLookAhead;
+    int tool_numOfSections = snapshot->toolNumSections;
+    double tool_lookAheadOnSetting = snapshot->toolLookAheadOn;
+    double tool_lookAheadOffSetting = snapshot->toolLookAheadOff;
 
     //calculate left side of section 1
     Vec3 left(0,0,0);
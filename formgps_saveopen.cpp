@@ -1,7 +1,14 @@
 #include "formgps.h"
 #include <QDir>
+#include <QFileInfo>
+#include <QtConcurrent>
+#include <QFutureWatcher>
 #include "aogsettings.h"
 #include "cmodulecomm.h"
+#include "cpatchfile.h"
+#include "aogsaveworker.h"
+#include "cfieldloader.h"
+#include "qmlutil.h"
 
 QString caseInsensitiveFilename(QString directory, QString filename)
 {
@@ -114,51 +121,8 @@ void FormGPS::fileLoadCurveLines()
     }
 
     QTextStream reader(&curveFile);
-
-    QString line;
-
-    //read header $CurveLine
-    line = reader.readLine();
-
-    while (!reader.atEnd())
-    {
-        line = reader.readLine();
-        if(line.isNull()) break; //no more to read
-
-        curve.curveArr.append(CCurveLines());
-
-        //read header $CurveLine
-        curve.curveArr[curve.numCurveLines].Name = line;
-        // get the average heading
-        line = reader.readLine();
-        curve.curveArr[curve.numCurveLines].aveHeading = line.toDouble();
-
-        line = reader.readLine();
-        int numPoints = line.toInt();
-
-        if (numPoints > 1)
-        {
-            curve.curveArr[curve.numCurveLines].curvePts.clear();
-
-            for (int i = 0; i < numPoints; i++)
-            {
-                line = reader.readLine();
-                QStringList words = line.split(',');
-                Vec3 vecPt(words[0].toDouble(),
-                           words[1].toDouble(),
-                           words[2].toDouble());
-                curve.curveArr[curve.numCurveLines].curvePts.append(vecPt);
-            }
-            curve.numCurveLines++;
-        }
-        else
-        {
-            if (curve.curveArr.count() > 0)
-            {
-                curve.curveArr.removeAt(curve.numCurveLines);
-            }
-        }
-    }
+    CFieldLoader::readCurveLines(reader, curve.curveArr);
+    curve.numCurveLines = curve.curveArr.count();
 
     if (curve.numCurveLines == 0) curve.numCurveLineSelected = 0;
     if (curve.numCurveLineSelected > curve.numCurveLines) curve.numCurveLineSelected = curve.numCurveLines;
@@ -242,36 +206,9 @@ void FormGPS::fileLoadABLines()
 
     QTextStream reader(&linesFile);
 
-    QString line;
-    ABLine.numABLines = 0;
     ABLine.numABLineSelected = 0;
-    ABLine.lineArr.clear();
-
-    //read all the lines
-    for (int i = 0; !reader.atEnd(); i++)
-    {
-
-        line = reader.readLine();
-        QStringList words = line.split(',');
-
-        if (words.length() != 4) break;
-
-        ABLine.lineArr.append(CABLines());
-
-        ABLine.lineArr[i].Name = words[0];
-
-
-        ABLine.lineArr[i].heading = glm::toRadians(words[1].toDouble());
-        ABLine.lineArr[i].origin.easting = words[2].toDouble();
-        ABLine.lineArr[i].origin.northing = words[3].toDouble();
-
-        ABLine.lineArr[i].ref1.easting = ABLine.lineArr[i].origin.easting - (sin(ABLine.lineArr[i].heading) * 1000.0);
-        ABLine.lineArr[i].ref1.northing = ABLine.lineArr[i].origin.northing - (cos(ABLine.lineArr[i].heading) *1000.0);
-
-        ABLine.lineArr[i].ref2.easting = ABLine.lineArr[i].origin.easting + (sin(ABLine.lineArr[i].heading) * 1000.0);
-        ABLine.lineArr[i].ref2.northing = ABLine.lineArr[i].origin.northing + (cos(ABLine.lineArr[i].heading) * 1000.0);
-        ABLine.numABLines++;
-    }
+    CFieldLoader::readABLines(reader, ABLine.lineArr);
+    ABLine.numABLines = ABLine.lineArr.count();
 
     if (ABLine.numABLines == 0) ABLine.numABLineSelected = 0;
     if (ABLine.numABLineSelected > ABLine.numABLines) ABLine.numABLineSelected = ABLine.numABLines;
@@ -1376,91 +1313,106 @@ bool FormGPS::fileOpenEnvironment(QString filename)
 
 void FormGPS::fileOpenField(QString fieldDir)
 {
+    if (fieldLoader)
+    {
+        qWarning() << "Still opening a field," << fieldDir << "not opened";
+        return;
+    }
+
     QString directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
             + "/" + QCoreApplication::applicationName() + "/Fields/" + fieldDir;
 
-    QString filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Field.txt");
+    //the open field may be the one being read, so it is saved and
+    //closed first. Fixes that come in during the read then have
+    //nothing to add to it.
+    if (isJobStarted) jobClose();
 
-    QFile fieldFile(filename);
-    if (!fieldFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open field " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
+    //every file is read at once on the thread pool, without holding up
+    //the GUI, then swapped in by onFieldLoaded()
+    fieldLoader = new CFieldLoader(this);
+    fieldLoader->coverage.clear(fd.coverage.resolution());
+    connect(fieldLoader, SIGNAL(progress(QString,int,int)),
+            this, SLOT(onFieldLoadProgress(QString,int,int)), Qt::QueuedConnection);
 
-    QTextStream reader(&fieldFile);
+    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(onFieldLoaded()));
+    connect(watcher, SIGNAL(finished()), watcher, SLOT(deleteLater()));
 
-    //close the existing job and reset everything
-    jobClose();
+    qmlItem(qml_root, "fieldLoadProgress")->setProperty("text", tr("Opening") + " " + fieldDir);
+    qmlItem(qml_root, "fieldLoadProgress")->setProperty("visible", true);
 
-    //and open a new job
-    jobNew();
+    watcher->setFuture(QtConcurrent::run(fieldLoader, &CFieldLoader::load, directoryName));
+}
+
+void FormGPS::onFieldLoadProgress(const QString &filename, int filesDone, int filesTotal)
+{
+    qmlItem(qml_root, "fieldLoadProgress")->setProperty("text",
+            tr("Opening") + QString(" %1 (%2/%3)").arg(filename).arg(filesDone).arg(filesTotal));
+}
 
-    //Saturday, February 11, 2017  -->  7:26:52 AM
-    //$FieldDir
-    //Bob_Feb11
-    //$Offsets
-    //533172,5927719,12 - offset easting, northing, zone
+void FormGPS::onFieldLoaded()
+{
+    QScopedPointer<CFieldLoader> loader(fieldLoader);
+    fieldLoader = NULL;
 
-    //start to read the file
-    QString line;
+    qmlItem(qml_root, "fieldLoadProgress")->setProperty("visible", false);
 
-    //Date time line
-    line = reader.readLine();
+    QString breakdown;
+    for (int i = 0; i < CFieldLoader::NUMFILES; i++)
+        breakdown += QString(" %1 %2ms").arg(CFieldLoader::fileName(i)).arg(loader->readTime[i], 0, 'f', 1);
+    qDebug() << "Field" << loader->fieldDirectory << "read in" << loader->totalTime << "ms:" << qPrintable(breakdown);
+
+    if (!loader->isRead[CFieldLoader::FieldTxt])
+    {
+        qWarning() << "Couldn't open field " << loader->directory() << "for reading!";
+        //TODO timed messagebox
+        return;
+    }
 
-    //dir header $FieldDir
-    line = reader.readLine();
+    //no fixes while the field is swapped out underneath them
+    QMutexLocker lock(&fixLock);
 
-    //read field directory
-    line = reader.readLine();
+    //reset everything a fix may have started while the files were
+    //read. The old field was saved and closed in fileOpenField(),
+    //waiting on the save thread here would be with fixLock held
+    jobClose(false);
 
-    currentFieldDirectory = line.trimmed();
+    //and open a new job
+    jobNew();
 
-    //Offset header
-    line = reader.readLine();
+    currentFieldDirectory = loader->fieldDirectory;
 
-    //read the Offsets
-    line = reader.readLine();
-    QStringList offs = line.split(',');
-    pn.utmEast = offs[0].toInt();
-    pn.utmNorth = offs[1].toInt();
-    pn.actualEasting = offs[0].toDouble();
-    pn.actualNorthing = offs[1].toDouble();
-    pn.zone = offs[2].toInt();
+    pn.utmEast = loader->utmEast;
+    pn.utmNorth = loader->utmNorth;
+    pn.actualEasting = loader->actualEasting;
+    pn.actualNorthing = loader->actualNorthing;
+    pn.zone = loader->zone;
     isFirstFixPositionSet = true;
 
     //create a new grid
     worldGrid.createWorldGrid(pn.actualNorthing - pn.utmNorth, pn.actualEasting - pn.utmEast);
 
     //convergence angle update
-    if (!reader.atEnd())
+    if (loader->hasConvergence)
     {
-        line = reader.readLine(); //Convergence
-        line = reader.readLine();
-        pn.convergenceAngle = line.toDouble();
+        pn.convergenceAngle = loader->convergenceAngle;
         //TODO lblConvergenceAngle.Text = Math.Round(glm.toDegrees(pn.convergenceAngle), 3).ToString();
     }
 
     //start positions
-    if (!reader.atEnd())
+    if (loader->hasStart)
     {
-        line = reader.readLine();
-        line = reader.readLine();
-        offs = line.split(',');
-
-        pn.latStart = offs[0].toDouble();
-        pn.lonStart = offs[1].toDouble();
+        pn.latStart = loader->latStart;
+        pn.lonStart = loader->lonStart;
     }
 
     sim.latitude = pn.latStart;
     sim.longitude = pn.lonStart;
 
-    fieldFile.close();
-
-
     // ABLine -------------------------------------------------------------------------------------------------
-    fileLoadABLines();
+    ABLine.moveDistance = 0;
+    ABLine.lineArr = loader->lineArr;
+    ABLine.numABLines = ABLine.lineArr.count();
 
     if (ABLine.lineArr.count() > 0)
     {
@@ -1475,13 +1427,16 @@ void FormGPS::fileOpenField(QString fieldDir)
     }
     else
     {
+        ABLine.numABLineSelected = 0;
         ABLine.isABLineSet = false;
         ABLine.isABLineLoaded = false;
     }
 
-
     //CurveLines
-    fileLoadCurveLines();
+    curve.moveDistance = 0;
+    curve.curveArr = loader->curveArr;
+    curve.numCurveLines = curve.curveArr.count();
+
     if (curve.curveArr.count() > 0)
     {
         curve.numCurveLineSelected = 1;
@@ -1497,266 +1452,48 @@ void FormGPS::fileOpenField(QString fieldDir)
     }
     else
     {
+        curve.numCurveLineSelected = 0;
         curve.isCurveSet = false;
         curve.refList.clear();
     }
 
-    //section patches
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Sections.txt");
+    //the rest stops at the first file that is missing, as it always has
 
-    QFile sectionsFile(filename);
-    if (!sectionsFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open sections " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
+    //section patches
+    if (!loader->isRead[CFieldLoader::SectionsTxt]) return;
 
-    reader.setDevice(&sectionsFile);
-    bool isv3 = false;
-    fd.workedAreaTotal = 0;
+    fd.workedAreaTotal = loader->workedAreaTotal;
     fd.distanceUser = 0;
-    QVector3D vecFix;
-
-    //read header
-    while (!reader.atEnd())
-    {
-        line = reader.readLine();
-        if (line.contains("ect"))
-        {
-            isv3 = true;
-            break;
-        }
-
-        int verts = line.toInt();
-
-        tool.section[0].triangleList = QSharedPointer<TriangleList>( new TriangleList);
-        tool.section[0].patchList.append(tool.section[0].triangleList);
-
-
-        for (int v = 0; v < verts; v++)
-        {
-            line = reader.readLine();
-            QStringList words = line.split(',');
-            vecFix.setX(words[0].toDouble());
-            vecFix.setY(words[1].toDouble());
-            vecFix.setZ(words[2].toDouble());
-            tool.section[0].triangleList->append(vecFix);
-        }
-
-        //calculate area of this patch - AbsoluteValue of (Ax(By-Cy) + Bx(Cy-Ay) + Cx(Ay-By)/2)
-        verts -= 2;
-        if (verts >= 2)
-        {
-            for (int j = 1; j < verts; j++)
-            {
-                double temp = 0;
-                temp = (*tool.section[0].triangleList)[j].x() * ((*tool.section[0].triangleList)[j + 1].y() - (*tool.section[0].triangleList)[j + 2].y()) +
-                         (*tool.section[0].triangleList)[j + 1].x() * ((*tool.section[0].triangleList)[j + 2].y() - (*tool.section[0].triangleList)[j].y()) +
-                             (*tool.section[0].triangleList)[j + 2].x() * ((*tool.section[0].triangleList)[j].y() - (*tool.section[0].triangleList)[j + 1].y());
-
-                fd.workedAreaTotal += fabs((temp * 0.5));
-            }
-        }
+    fd.coverage = loader->coverage;
+    fd.updateOverlap();
 
-        //was old version prior to v4
-        if (isv3)
-        {
-                //Append the current list to the field file
-        }
-    }
-    sectionsFile.close();
+    if (loader->patches.count() > 0)
+        tool.section[0].triangleList = loader->patches.last();
+    tool.section[0].patchList += loader->patches;
+    foreach (const CPatchIndex::Patch &item, loader->patchItems)
+        tool.patchIndex.insert(item);
 
     // Contour points ----------------------------------------------------------------------------
+    if (!loader->isRead[CFieldLoader::ContourTxt]) return;
 
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Contour.txt");
-
-    QFile contourFile(filename);
-    if (!contourFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open contour " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
-
-    reader.setDevice(&contourFile);
-
-    //read header
-    line = reader.readLine();
-
-    while (!reader.atEnd())
-    {
-        //read how many vertices in the following patch
-        line = reader.readLine();
-        int verts = line.toInt();
-
-        Vec3 vecFix(0, 0, 0);
-
-        ct.ptList = QSharedPointer<QVector<Vec3>>(new QVector<Vec3>);
-        ct.stripList.append(ct.ptList);
-
-        for (int v = 0; v < verts; v++)
-        {
-            line = reader.readLine();
-            QStringList words = line.split(',');
-            vecFix.easting = words[0].toDouble();
-            vecFix.northing = words[1].toDouble();
-            vecFix.heading = words[2].toDouble();
-            ct.ptList->append(vecFix);
-        }
-    }
-
-    contourFile.close();
+    if (loader->strips.count() > 0)
+        ct.ptList = loader->strips.last();
+    ct.stripList += loader->strips;
+    ct.rebuildIndex();
 
     // Flags -------------------------------------------------------------------------------------------------
+    if (!loader->isRead[CFieldLoader::FlagsTxt]) return;
 
-    //Either exit or update running save
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Flags.txt");
-
-    QFile flagsFile(filename);
-    if (!flagsFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open flags " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
-
-    reader.setDevice(&flagsFile);
-
-    flagPts.clear();
-    //read header
-    line = reader.readLine();
-
-    //number of flags
-    line = reader.readLine();
-    int points = line.toInt();
-
-    if (points > 0)
-    {
-        double lat;
-        double longi;
-        double east;
-        double nort;
-        double head;
-        int color, ID;
-        QString notes;
-
-        for (int v = 0; v < points; v++)
-        {
-            line = reader.readLine();
-            QStringList words = line.split(',');
-
-            if (words.count() == 8)
-            {
-                lat = words[0].toDouble();
-                longi = words[1].toDouble();
-                east = words[2].toDouble();
-                nort = words[3].toDouble();
-                head = words[4].toDouble();
-                color = words[5].toInt();
-                ID = words[6].toInt();
-                notes = words[7].trimmed();
-            }
-            else
-            {
-                lat = words[0].toDouble();
-                longi = words[1].toDouble();
-                east = words[2].toDouble();
-                nort = words[3].toDouble();
-                head = 0;
-                color = words[4].toInt();
-                ID = words[5].toInt();
-                notes = "";
-            }
-
-            CFlag flagPt(lat, longi, east, nort, head, color, ID, notes);
-            flagPts.append(flagPt);
-        }
-    }
-    flagsFile.close();
+    flagPts = loader->flagPts;
 
     //Boundaries
-    //Either exit or update running save
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Boundary.txt");
-
-    QFile boundariesFile(filename);
-    if (!boundariesFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open boundaries " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
-
-    reader.setDevice(&boundariesFile);
-    //read header
-    line = reader.readLine();//Boundary
+    if (!loader->isRead[CFieldLoader::BoundaryTxt]) return;
 
-    for (int k = 0; true; k++)
+    foreach (const CBoundaryLines &bndLines, loader->bndArr)
     {
-        if (reader.atEnd()) break;
-
-        bnd.bndArr.append(CBoundaryLines());
+        bnd.bndArr.append(bndLines);
         turn.turnArr.append(CTurnLines());
         gf.geoFenceArr.append(CGeoFenceLines());
-
-        //True or False OR points from older boundary files
-        line = reader.readLine();
-
-        //Check for older boundary files, then above line string is num of points
-        if (line == "True")
-        {
-            bnd.bndArr[k].isDriveThru = true;
-            line = reader.readLine();
-        } else if (line == "False")
-        {
-            bnd.bndArr[k].isDriveThru = false;
-            line = reader.readLine(); //number of points
-        }
-
-        //Check for latest boundary files, then above line string is num of points
-        if (line == "True")
-        {
-            bnd.bndArr[k].isDriveAround = true;
-            line = reader.readLine(); //number of points
-        } else if( line == "False")
-        {
-            bnd.bndArr[k].isDriveAround = false;
-            line = reader.readLine(); //number of points
-        }
-
-        int numPoints = line.toInt();
-
-        if (numPoints > 0)
-        {
-            //load the line
-            for (int i = 0; i < numPoints; i++)
-            {
-                line = reader.readLine();
-                QStringList words = line.split(',');
-                Vec3 vecPt( words[0].toDouble(),
-                            words[1].toDouble(),
-                            words[2].toDouble() );
-
-                //if (turnheading)
-                //{
-                //    vecPt.heading = vecPt.heading + Math.PI;
-                //}
-                bnd.bndArr[k].bndLine.append(vecPt);
-            }
-
-            bnd.bndArr[k].calculateBoundaryArea();
-            bnd.bndArr[k].preCalcBoundaryLines();
-            if (bnd.bndArr[k].area > 0) bnd.bndArr[k].isSet = true;
-            else bnd.bndArr[k].isSet = false;
-        }
-        else
-        {
-            bnd.bndArr.removeAt(bnd.bndArr.count() - 1);
-            turn.turnArr.removeAt(bnd.bndArr.count() - 1);
-            gf.geoFenceArr.removeAt(bnd.bndArr.count() - 1);
-            k = k - 1;
-        }
-        if (reader.atEnd()) break;
     }
 
     calculateMinMax();
@@ -1764,46 +1501,23 @@ void FormGPS::fileOpenField(QString fieldDir)
     gf.buildGeoFenceLines(bnd);
     mazeGrid.buildMazeGridArray(bnd,gf, minFieldX, maxFieldX, minFieldY, maxFieldY);
 
-    flagsFile.close();
-
     // Headland  -------------------------------------------------------------------------------------------------
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Headland.txt");
-
-    QFile headlandFile(filename);
-    if (!headlandFile.open(QIODevice::ReadOnly))
+    if (loader->isRead[CFieldLoader::HeadlandTxt])
     {
-        qWarning() << "Couldn't open headland " << filename << "for reading!";
-        //TODO timed messagebox
-    } else {
-        reader.setDevice(&headlandFile);
-
-        //read header
-        line = reader.readLine();
-
-        for (int k = 0; true; k++)
+        //the draw flags need the geofence built above
+        for (int k = 0; k < loader->headLines.count(); k++)
         {
-            if (reader.atEnd()) break;
-
             hd.headArr[0].hdLine.clear();
 
-            //read the number of points
-            line = reader.readLine();
-            int numPoints = line.toInt();
-
-            if (numPoints > 0 && bnd.bndArr.count() >= hd.headArr.count())
+            const QVector<Vec3> &hdLine = loader->headLines[k];
+            if (hdLine.count() > 0 && bnd.bndArr.count() >= hd.headArr.count() &&
+                k < hd.headArr.count())
             {
-
                 hd.headArr[k].hdLine.clear();
                 hd.headArr[k].calcList.clear();
 
-                //load the line
-                for (int i = 0; i < numPoints; i++)
+                foreach (const Vec3 &vecPt, hdLine)
                 {
-                    line = reader.readLine();
-                    QStringList words = line.split(',');
-                    Vec3 vecPt(words[0].toDouble(),
-                               words[1].toDouble(),
-                               words[2].toDouble());
                     hd.headArr[k].hdLine.append(vecPt);
 
                     if (gf.geoFenceArr[0].isPointInGeoFenceArea(vecPt)) hd.headArr[0].isDrawList.append(true);
@@ -1818,46 +1532,12 @@ void FormGPS::fileOpenField(QString fieldDir)
 
         //if (hd.isOn) btnHeadlandOnOff.Image = Properties.Resources.HeadlandOn;
         //TODO: btnHeadlandOnOff.Image = Properties.Resources.HeadlandOff;
-
-        headlandFile.close();
     }
 
     //Recorded Path
-    filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "RecPath.txt");
-
-    QFile recpathFile(filename);
-    if (!recpathFile.open(QIODevice::ReadOnly))
-    {
-        qWarning() << "Couldn't open recpath " << filename << "for reading!";
-        //TODO timed messagebox
-        return;
-    }
+    if (!loader->isRead[CFieldLoader::RecPathTxt]) return;
 
-    reader.setDevice(&recpathFile);
-    //read header
-    line = reader.readLine();
-    line = reader.readLine();
-    int numPoints = line.toInt();
-    recPath.recList.clear();
-
-    while (!reader.atEnd())
-    {
-        for (int v = 0; v < numPoints; v++)
-        {
-            line = reader.readLine();
-            QStringList words = line.split(',');
-            CRecPathPt point(
-                words[0].toDouble(),
-                words[1].toDouble(),
-                words[2].toDouble(),
-                words[3].toDouble(),
-                (words[4] == "True" ? true : false) );
-
-            //add the point
-            recPath.recList.append(point);
-        }
-    }
-    recpathFile.close();
+    recPath.recList = loader->recList;
 }
 
 void FormGPS::fileCreateField()
@@ -1968,43 +1648,17 @@ void FormGPS::fileCreateElevation()
 
 void FormGPS::fileSaveSections()
 {
-    if (tool.patchSaveList.count() == 0) return;
-
-    QString myFilename;
-
-    //get the directory and make sure it exists, create if not
-
-    QString directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
-            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
-
-    myFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Sections.txt");
-    QFile sectionFile(myFilename);
-    if (!sectionFile.open(QIODevice::Append))
-    {
-        qWarning() << "Couldn't open " << myFilename << "for appending!";
-        return;
-    }
-
-    QTextStream writer(&sectionFile);
-
-    //for each patch, write out the list of triangles to the file
-    QSharedPointer<QVector<QVector3D>> triList;
-    foreach(triList, tool.patchSaveList)
+    //hand the sealed patches to the save thread, fixes keep going
+    AOGSaveBatch batch;
     {
-        int count2 = triList->count();
-        writer << count2 << Qt::endl;
-
-        for (int i=0; i < count2; i++)
-        {
-            writer << qSetRealNumberPrecision(3)
-                   << (*triList)[i].x() << "," << (*triList)[i].y()
-                   << "," << (*triList)[i].z() << Qt::endl;
-        }
+        QMutexLocker lock(&fixLock);
+        if (tool.patchSaveList.count() == 0) return;
+        batch.patches.swap(tool.patchSaveList);
     }
 
-    //clear out that patchList and begin adding new ones for next save
-    tool.patchSaveList.clear();
-    sectionFile.close();
+    batch.directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
+    saveWorker->enqueue(batch);
 }
 
 void FormGPS::fileCreateSections()
@@ -2026,43 +1680,29 @@ void FormGPS::fileCreateContour()
 
 void FormGPS::fileSaveContour()
 {
-    if (contourSaveList.count() == 0) return;
-
-    QString myFilename;
-
-    //get the directory and make sure it exists, create if not
-
-    QString directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
-            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
-
-    myFilename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Contour.txt");
-    QFile contourFile(myFilename);
-    if (!contourFile.open(QIODevice::Append))
+    AOGSaveBatch batch;
     {
-        qWarning() << "Couldn't open " << myFilename << "for appending!";
-        return;
+        QMutexLocker lock(&fixLock);
+        if (contourSaveList.count() == 0) return;
+        batch.contours.swap(contourSaveList);
     }
 
-    QTextStream writer(&contourFile);
-    QSharedPointer<QVector<Vec3>> triList;
-
-    foreach (triList, contourSaveList)
-    {
-        int count2 = triList->count();
-
-        writer << count2 << Qt::endl;
-
-        for (int i = 0; i < count2; i++)
-        {
-            writer << qSetRealNumberPrecision(3)
-                   << (*triList)[i].easting << ","
-                   << (*triList)[i].northing << ","
-                   << (*triList)[i].heading << Qt::endl;
-        }
-    }
+    batch.directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
+    saveWorker->enqueue(batch);
+}
 
-    contourSaveList.clear();
-    contourFile.close();
+void FormGPS::fileFlushSaves()
+{
+    USE_SETTINGS_SNAPSHOT;
+
+    //queue whatever hasn't been saved yet and wait until it is written
+    fileSaveSections();
+    fileSaveContour();
+    if (snapshot->gpsLogNMEA) fileSaveNMEA();
+    if (snapshot->gpsLogElevation) fileSaveElevation();
+    fileSaveCoverage();
+    saveWorker->flush();
 }
 
 void FormGPS::fileSaveBoundary()
@@ -2281,66 +1921,44 @@ void FormGPS::fileSaveFlags()
 
 void FormGPS::fileSaveNMEA()
 {
-    QString directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
-            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
-
-    QDir saveDir(directoryName);
-    if (!saveDir.exists()) {
-        bool ok = saveDir.mkpath(directoryName);
-        if (!ok) {
-            qWarning() << "Couldn't create path " << directoryName;
-            return;
-        }
-    }
-
-    QString filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "NMEA_log.txt");
-
-    QFile nmeafile(filename);
-    if (!nmeafile.open(QIODevice::Append))
+    AOGSaveBatch batch;
     {
-        qWarning() << "Couldn't open " << filename << "for writing!";
-        return;
+        QMutexLocker lock(&fixLock);
+        if (pn.logNMEASentence.size() == 0) return;
+        batch.nmea.swap(pn.logNMEASentence);
     }
 
-    QTextStream writer(&nmeafile);
-
-    writer << pn.logNMEASentence;
-
-    pn.logNMEASentence.clear();
-
-    nmeafile.close();
+    batch.directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
+    saveWorker->enqueue(batch);
 }
 
 void FormGPS::fileSaveElevation()
 {
-    QString directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
-            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
-
-    QDir saveDir(directoryName);
-    if (!saveDir.exists()) {
-        bool ok = saveDir.mkpath(directoryName);
-        if (!ok) {
-            qWarning() << "Couldn't create path " << directoryName;
-            return;
-        }
+    AOGSaveBatch batch;
+    {
+        QMutexLocker lock(&fixLock);
+        if (sbFix.size() == 0) return;
+        batch.elevation.swap(sbFix);
     }
 
-    QString filename = directoryName + "/" + caseInsensitiveFilename(directoryName, "Elevation.txt");
+    batch.directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
+    saveWorker->enqueue(batch);
+}
 
-    QFile elevfile(filename);
-    if (!elevfile.open(QIODevice::Append))
+void FormGPS::fileSaveCoverage()
+{
+    AOGSaveBatch batch;
     {
-        qWarning() << "Couldn't open " << filename << "for writing!";
-        return;
+        QMutexLocker lock(&fixLock);
+        if (fd.coverage.appliedArea() == 0) return;
+        batch.coverage = fd.coverageReport();
     }
 
-    QTextStream writer(&elevfile);
-
-    writer << sbFix;
-
-    sbFix.clear();
-
-    elevfile.close();
+    batch.directoryName = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + QCoreApplication::applicationName() + "/Fields/" + currentFieldDirectory;
+    saveWorker->enqueue(batch);
 }
 
 void FormGPS::fileSaveSingleFlagKML2(int flagNumber)
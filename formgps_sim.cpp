@@ -1,9 +1,13 @@
 #include "formgps.h"
 #include "classes/csim.h"
 #include "qmlutil.h"
+#include "aogpositionworker.h"
 
 void FormGPS::onSimNewPosition(QByteArray nmea_data) {
-    pn.rawBuffer.append(nmea_data);
+    //the framer belongs to the positioning thread
+    QMetaObject::invokeMethod(positionWorker, "appendRaw",
+                              Qt::QueuedConnection,
+                              Q_ARG(QByteArray, nmea_data));
 }
 
 void FormGPS::onSimTimerTimeout()
@@ -16,12 +20,14 @@ void FormGPS::onSimTimerTimeout()
     double steerAngle = (qmlobject->property("value").toReal() - 300) * 0.1;
 
     //if a GPS is connected disable sim
-    if (!sp.isOpen())
+    if (!positionWorker->isSerialOpen())
     {
-        if (isAutoSteerBtnOn && (vehicle.guidanceLineDistanceOff != 32000))
-            sim.DoSimTick(vehicle.guidanceLineSteerAngle * 0.01);
+        CPositionState position = positionSnapshot.read();
+
+        if (isAutoSteerBtnOn && (position.guidanceLineDistanceOff != 32000))
+            sim.DoSimTick(position.guidanceLineSteerAngle * 0.01);
         else if (recPath.isDrivingRecordedPath)
-            sim.DoSimTick(vehicle.guidanceLineSteerAngle * 0.01);
+            sim.DoSimTick(position.guidanceLineSteerAngle * 0.01);
         //else if (self.isSelfDriving) sim.DoSimTick(guidanceLineSteerAngle * 0.01);
         else
             //TODO: sim.DoSimTick(sim.steerAngleScrollBar);
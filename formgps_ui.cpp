@@ -245,6 +245,10 @@ void FormGPS::onBtnPerimeter_clicked(){
 }
 
 void FormGPS::onBtnAreaSide_clicked() {
+    //fixes are processed on the positioning thread, anything a
+    //button changes that a fix reads is changed with the fix lock held
+    QMutexLocker lock(&fixLock);
+
     isAreaOnRight = !isAreaOnRight;
     settings.setValue("vehicle/isAreaOnRight", isAreaOnRight);
     contextArea->setProperty("visible",false);
@@ -252,6 +256,8 @@ void FormGPS::onBtnAreaSide_clicked() {
 }
 
 void FormGPS::onBtnAutoSteer_clicked(){
+    QMutexLocker lock(&fixLock);
+
     if (isAutoSteerBtnOn) {
         isAutoSteerBtnOn = false;
         btnAutoSteer->setProperty("icon","/images/AutoSteerOff.png");
@@ -288,6 +294,8 @@ void FormGPS::onBtnABLine_clicked(){
 void FormGPS::onBtnContour_clicked(){
     qDebug()<<"contour button clicked." ;
 
+    QMutexLocker lock(&fixLock);
+
     ct.isContourBtnOn = !ct.isContourBtnOn;
     if (ct.isContourBtnOn) {
         qmlItem(qml_root,"btnContour")->setProperty("isChecked",true);
@@ -297,11 +305,15 @@ void FormGPS::onBtnContour_clicked(){
         qmlItem(qml_root,"btnContourPriority")->setProperty("visible",false);
     }
 
+    //show it now rather than at the next fix
+    publishGuidance();
 }
 
 void FormGPS::onBtnContourPriority_clicked(){
     qDebug()<<"contour priority button clicked." ;
 
+    QMutexLocker lock(&fixLock);
+
     ct.isRightPriority = !ct.isRightPriority;
     if (ct.isRightPriority)
         qmlItem(qml_root,"btnContourPriority")->setProperty("isChecked",true);
@@ -315,6 +327,8 @@ void FormGPS::onBtnManualOffOn_clicked(){
     int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
 
     qDebug()<<"Manual off on button clicked." ;
+
+    QMutexLocker lock(&fixLock);
     switch (manualBtnState)
     {
     case btnStates::Off:
@@ -362,6 +376,8 @@ void FormGPS::onBtnSectionOffAutoOn_clicked(){
     int tool_numOfSections = SETTINGS_TOOL_NUMSECTIONS;
 
     qDebug()<<"Section off auto on button clicked." ;
+
+    QMutexLocker lock(&fixLock);
     switch (autoBtnState)
     {
         case btnStates::Off:
@@ -407,6 +423,8 @@ void FormGPS::onBtnSectionOffAutoOn_clicked(){
 //individual buttons for section (called by actual
 //qt callback onSectionButton_clicked() SLOT
 void FormGPS::onBtnSectionMan_clicked(int sectNumber) {
+    QMutexLocker lock(&fixLock);
+
     if (autoBtnState != btnStates::Auto) {
         //if auto is off just have on-off for choices of section buttons
         if (tool.section[sectNumber].manBtnState == btnStates::Off) {
@@ -555,20 +573,26 @@ void FormGPS::onBtnDeleteAllFlags_clicked()
 
 void FormGPS::onBtnManUTurnLeft_clicked()
 {
+    QMutexLocker lock(&fixLock);
+
     if (yt.isYouTurnTriggered) {
         yt.resetYouTurn();
     }else {
         yt.isYouTurnTriggered = true;
         yt.buildManualYouTurn(ABLine, curve, false, true);
    }
+    publishGuidance();
 }
 
 void FormGPS::onBtnManUTurnRight_clicked()
 {
+    QMutexLocker lock(&fixLock);
+
     if (yt.isYouTurnTriggered) {
         yt.resetYouTurn();
     }else {
         yt.isYouTurnTriggered = true;
         yt.buildManualYouTurn(ABLine, curve, true, true);
    }
+    publishGuidance();
 }
@@ -2,6 +2,9 @@
 #include <QThread>
 #include <QOpenGLTexture>
 #include <QOpenGLShaderProgram>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
 #include "ccamera.h"
 #include <assert.h>
 #include <math.h>
@@ -11,6 +14,7 @@
 QOpenGLShaderProgram *simpleColorShader = 0;
 QOpenGLShaderProgram *texShader = 0;
 QOpenGLShaderProgram *interpColorShader = 0;
+QOpenGLShaderProgram *colorsTexShader = 0;
 
 QVector<QOpenGLTexture *> texture;
 
@@ -20,6 +24,76 @@ static int GlyphWidth = 16;
 static int GlyphHeight = 32;
 static int CharXSpacing = 14;
 
+//a string laid out at size 1 with its first glyph at 0,0. The caller
+//moves and scales it with the mvp matrix.
+struct TextLayout {
+    QOpenGLBuffer buffer;
+    int count;
+    int lastUsed;
+};
+
+//drawText() has the font texture the other way up from drawText3D()
+//and drawTextVehicle(), so they are cached separately
+static QHash<QString, TextLayout *> textLayouts[2];
+static int textFrame = 0;
+
+//layouts not drawn for this many frames are dropped
+static const int TEXTSWEEPFRAMES = 300;
+
+struct TextBatchEntry {
+    QString text;
+    double x;
+    double y;
+    double size;
+    QColor color;
+
+    bool operator==(const TextBatchEntry &other) const {
+        return x == other.x && y == other.y && size == other.size &&
+               color == other.color && text == other.text;
+    }
+};
+
+static bool textBatchOpen = false;
+static QMatrix4x4 textBatchMvp;
+static QVector<TextBatchEntry> textBatch;
+static QVector<TextBatchEntry> textBatchUploaded;
+static QOpenGLBuffer textBatchBuffer;
+static int textBatchCount = 0;
+static int textBatchCapacity = 0;
+
+//ring of stream buffers for GLHelperOneColor and GLHelperColors. The
+//ring moves on every frame, so a buffer is not written again until
+//the GPU has had a couple of frames to finish drawing from it.
+static const int STREAMBUFFERS = 3;
+static const int STREAMBUFFERSIZE = 512 * 1024; //bytes
+
+static QOpenGLBuffer streamBuffers[STREAMBUFFERS];
+static int streamCapacity[STREAMBUFFERS] = { 0, 0, 0 };
+static int streamCurrent = 0;
+static int streamOffset = 0;
+
+GLFrameStats glFrameStats = { 0, 0, 0, 0, 0 };
+static GLFrameStats lastFrameStats = { 0, 0, 0, 0, 0 };
+static QMutex frameStatsLock;
+
+//GPU copies of the static field layers, keyed by the owning object.
+//Generations come from one counter for all owners, so an object that
+//reuses the address of a deleted one never matches its old entry.
+struct GeometryBuffer {
+    QOpenGLBuffer buffer;
+    int generation;
+    int count;
+    int capacity;
+    int lastUsed;
+};
+
+static QHash<const void *, GeometryBuffer *> geometryBuffers;
+static QAtomicInt geometryGeneration(0);
+static int geometryFrame = 0;
+
+//buffers of owners not drawn for this many frames are dropped
+static const int GEOMETRYSWEEPFRAMES = 300;
+
 int textureWidth;
 int textureHeight;
 
@@ -51,6 +125,12 @@ void initializeShaders() {
         assert(interpColorShader->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/colors_fshader.fsh"));
         assert(interpColorShader->link());
     }
+    if (!colorsTexShader) {
+        colorsTexShader = new QOpenGLShaderProgram(QThread::currentThread()); //memory managed by Qt
+        assert(colorsTexShader->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/colorstex_vshader.vsh"));
+        assert(colorsTexShader->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/colorstex_fshader.fsh"));
+        assert(colorsTexShader->link());
+    }
 }
 
 void initializeTextures() {
@@ -101,6 +181,11 @@ void destroyShaders() {
         delete interpColorShader;
         interpColorShader = 0;
     }
+
+    if(colorsTexShader) {
+        delete colorsTexShader;
+        colorsTexShader = 0;
+    }
 }
 
 void destroyTextures() {
@@ -118,7 +203,8 @@ void glDrawArraysColor(QOpenGLFunctions *gl,
                        QOpenGLBuffer &vertexBuffer,
                        GLenum GL_type,
                        int count,
-                       float pointSize)
+                       float pointSize,
+                       int offset)
 {
     //bind shader
     assert(simpleColorShader->bind());
@@ -141,7 +227,7 @@ void glDrawArraysColor(QOpenGLFunctions *gl,
                               GL_type, //type of data GL_FLAOT or GL_DOUBLE
                               GL_FALSE, //not normalized vertices!
                               0, //no spaceing between vertices in data
-                              0 //start at offset 0 in buffer
+                              ((char *)0) + offset //start at offset in buffer
                              );
 
     //draw primitive
@@ -160,7 +246,8 @@ void glDrawArraysColors(QOpenGLFunctions *gl,
                         QOpenGLBuffer &vertexBuffer,
                         GLenum GL_type,
                         int count,
-                        float pointSize)
+                        float pointSize,
+                        int offset)
 {
     //bind shader
     assert(interpColorShader->bind());
@@ -182,7 +269,7 @@ void glDrawArraysColors(QOpenGLFunctions *gl,
                               GL_type, //type of data GL_FLAOT or GL_DOUBLE
                               GL_FALSE, //not normalized vertices!
                               7*sizeof(float), //vertex+color
-                              0 //start at offset 0 in buffer
+                              ((char *)0) + offset //start at offset in buffer
                              );
 
     gl->glVertexAttribPointer(interpColorShader->attributeLocation("color"),
@@ -190,7 +277,7 @@ void glDrawArraysColors(QOpenGLFunctions *gl,
                               GL_type, //type of data GL_FLAOT or GL_DOUBLE
                               GL_FALSE, //not normalized vertices!
                               7*sizeof(float), //vertex+color
-                              ((float *)0) + 3 //start at 3rd float in buffer
+                              ((char *)0) + offset + 3*sizeof(float) //start at 3rd float
                              );
 
     //draw primitive
@@ -254,44 +341,162 @@ void glDrawArraysTexture(QOpenGLFunctions *gl,
     gl->glDisable(GL_TEXTURE_2D);
 }
 
-void drawText(QOpenGLFunctions *gl, QMatrix4x4 mvp, double x, double y, QString text, double size, bool colorize, QColor color)
+//Buffer should consist of 9D values.  3D for x,y,z, 2D for
+//texture x,y coordinate and 4 for color: r,g,b,a.
+void glDrawArraysColorsTexture(QOpenGLFunctions *gl,
+                               QMatrix4x4 mvp,
+                               GLenum operation,
+                               QOpenGLBuffer &vertexBuffer,
+                               GLenum GL_type,
+                               int count)
 {
-    //GL.Color3(0.95f, 0.95f, 0.40f);
+    gl->glEnable(GL_TEXTURE_2D);
+    //bind shader
+    assert(colorsTexShader->bind());
+    //set mvp matrix
+    colorsTexShader->setUniformValue("texture", 0);
+    colorsTexShader->setUniformValue("mvpMatrix", mvp);
+
+    vertexBuffer.bind();
+
+    //enable the vertex attribute array in shader
+    colorsTexShader->enableAttributeArray("vertex");
+    colorsTexShader->enableAttributeArray("texcoord_src");
+    colorsTexShader->enableAttributeArray("color");
+
+    //use attribute array from buffer, using non-normalized vertices
+    gl->glVertexAttribPointer(colorsTexShader->attributeLocation("vertex"),
+                              3, //3D vertices
+                              GL_type, //type of data GL_FLAOT or GL_DOUBLE
+                              GL_FALSE, //not normalized vertices!
+                              9*sizeof(float), //vertex+texcoord+color
+                              0 //start at offset 0 in buffer
+                             );
 
-    GLHelperTexture gldraw;
-    VertexTexcoord vt;
+    gl->glVertexAttribPointer(colorsTexShader->attributeLocation("texcoord_src"),
+                              2, //2D coordinate
+                              GL_type, //type of data GL_FLAOT or GL_DOUBLE
+                              GL_FALSE, //not normalized vertices!
+                              9*sizeof(float), //vertex+texcoord+color
+                              ((float *)0) + 3 //start at 3rd float in buffer
+                             );
+
+    gl->glVertexAttribPointer(colorsTexShader->attributeLocation("color"),
+                              4, //4D color
+                              GL_type, //type of data GL_FLAOT or GL_DOUBLE
+                              GL_FALSE, //not normalized vertices!
+                              9*sizeof(float), //vertex+texcoord+color
+                              ((float *)0) + 5 //start at 5th float in buffer
+                             );
+
+    //draw primitive
+    gl->glDrawArrays(operation,0,count);
+    //release buffer
+    vertexBuffer.release();
+    //release shader
+    colorsTexShader->release();
+    gl->glDisable(GL_TEXTURE_2D);
+}
 
+//Two triangles per glyph at size 1, so a whole string is one
+//GL_TRIANGLES draw. flipV puts the top of the glyph at y = 0 for
+//drawText3D() and drawTextVehicle().
+static void layoutText(QVector<VertexTexcoord> &vertices, const QString &text, bool flipV)
+{
     double u_step = (double)GlyphWidth / (double)textureWidth;
     double v_step = (double)GlyphHeight / (double)textureHeight;
+    double x = 0;
+
+    vertices.reserve(vertices.size() + text.length() * 6);
 
     for (int n = 0; n < text.length(); n++)
     {
-        gldraw.clear();
         char idx = text.at(n).toLatin1();
         double u = (double)(idx % GlyphsPerLine) * u_step;
         double v = (double)(idx / GlyphsPerLine) * v_step;
+        double v0 = flipV ? v + v_step : v;
+        double v1 = flipV ? v : v + v_step;
+
+        VertexTexcoord bl = { QVector3D(x, 0, 0), QVector2D(u, v0) };
+        VertexTexcoord br = { QVector3D(x + GlyphWidth, 0, 0), QVector2D(u + u_step, v0) };
+        VertexTexcoord tl = { QVector3D(x, GlyphHeight, 0), QVector2D(u, v1) };
+        VertexTexcoord tr = { QVector3D(x + GlyphWidth, GlyphHeight, 0), QVector2D(u + u_step, v1) };
+
+        vertices.append(bl);
+        vertices.append(br);
+        vertices.append(tl);
+        vertices.append(tl);
+        vertices.append(br);
+        vertices.append(tr);
+
+        x += CharXSpacing;
+    }
+}
 
-        vt.texcoord = QVector2D(u, v);
-        vt.vertex = QVector3D(x, y, 0);
-        gldraw.append(vt);
+//find the cached layout of text, uploading it the first time
+static TextLayout *textLayout(const QString &text, bool flipV)
+{
+    QHash<QString, TextLayout *> &layouts = textLayouts[flipV ? 1 : 0];
+    TextLayout *layout = layouts.value(text, 0);
 
-        vt.texcoord = QVector2D(u + u_step, v);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y, 0);
-        gldraw.append(vt);
+    if (!layout)
+    {
+        QVector<VertexTexcoord> vertices;
+        layoutText(vertices, text, flipV);
+
+        layout = new TextLayout;
+        layout->count = vertices.size();
+        layout->buffer.create();
+        glFrameStats.buffersCreated++;
+        layout->buffer.bind();
+        layout->buffer.allocate(vertices.constData(), vertices.size() * (int)sizeof(VertexTexcoord));
+        layout->buffer.release();
+        layouts[text] = layout;
+    }
+
+    layout->lastUsed = textFrame;
+    return layout;
+}
+
+static void drawTextLayout(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, const QString &text,
+                           bool flipV, bool colorize, QColor color)
+{
+    if (text.isEmpty()) return;
+
+    TextLayout *layout = textLayout(text, flipV);
 
-        vt.texcoord = QVector2D(u, v + v_step);
-        vt.vertex = QVector3D(x, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
+    texture[Textures::FONT]->bind();
+    glDrawArraysTexture(gl, mvp, GL_TRIANGLES, layout->buffer, GL_FLOAT,
+                        layout->count, colorize, color);
+    texture[Textures::FONT]->release();
+}
+
+static void destroyTextLayout(TextLayout *layout)
+{
+    if (layout->buffer.isCreated())
+        layout->buffer.destroy();
+    delete layout;
+}
 
-        vt.texcoord = QVector2D(u + u_step, v + v_step);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
+void drawText(QOpenGLFunctions *gl, QMatrix4x4 mvp, double x, double y, QString text, double size, bool colorize, QColor color)
+{
+    //GL.Color3(0.95f, 0.95f, 0.40f);
 
-        x += CharXSpacing * size;
-        gldraw.draw(gl, mvp, Textures::FONT, GL_TRIANGLE_STRIP, colorize, color);
-}    }
+    if (!colorize) color = QColor::fromRgbF(1,1,1);
 
+    //HUD text all goes out in endTextBatch(). Anything drawn with
+    //another matrix while the batch is open is drawn right away.
+    if (textBatchOpen && (textBatch.isEmpty() || mvp == textBatchMvp))
+    {
+        if (textBatch.isEmpty()) textBatchMvp = mvp;
+        textBatch.append({ text, x, y, size, color });
+        return;
+    }
 
+    mvp.translate(x, y, 0);
+    mvp.scale(size);
+    drawTextLayout(gl, mvp, text, false, colorize, color);
+}
 
 void drawText3D(const CCamera &camera, QOpenGLFunctions *gl,
                 QMatrix4x4 mvp, double x1, double y1, QString text,
@@ -299,11 +504,6 @@ void drawText3D(const CCamera &camera, QOpenGLFunctions *gl,
 {
     USE_SETTINGS;
 
-    GLHelperTexture gldraw;
-    VertexTexcoord vt;
-
-    double x = 0, y = 0;
-
     mvp.translate(x1, y1, 0);
 
     if (SETTINGS_DISPLAY_CAMPITCH < -45)
@@ -323,45 +523,16 @@ void drawText3D(const CCamera &camera, QOpenGLFunctions *gl,
         size /= 1000;
     }
 
-    double u_step = (double)GlyphWidth / (double)textureWidth;
-    double v_step = (double)GlyphHeight / (double)textureHeight;
-
-
-    for (int n = 0; n < text.length(); n++)
-    {
-        char idx = text.at(n).toLatin1();
-        double u = (double)(idx % GlyphsPerLine) * u_step;
-        double v = (double)(idx / GlyphsPerLine) * v_step;
-        gldraw.clear();
-
-        vt.texcoord = QVector2D(u, v + v_step);
-        vt.vertex = QVector3D(x, y, 0);
-        gldraw.append(vt);
-
-        vt.texcoord = QVector2D(u + u_step, v + v_step);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y, 0);
-        gldraw.append(vt);
-
-        vt.texcoord = QVector2D(u, v);
-        vt.vertex = QVector3D(x, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
-
-        vt.texcoord = QVector2D(u + u_step, v);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
-        gldraw.draw(gl, mvp, Textures::FONT, GL_TRIANGLE_STRIP, colorize, color);
-
-        x += CharXSpacing * size;
-    }
-
+    //the size follows the zoom, so it goes in the matrix rather than
+    //the cached layout
+    mvp.scale(size);
+    drawTextLayout(gl, mvp, text, true, colorize, color);
 }
 
 void drawTextVehicle(const CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 mvp,
                      double x, double y, QString text, double size, bool colorize, QColor color)
 {
     USE_SETTINGS;
-    GLHelperTexture gldraw;
-    VertexTexcoord vt;
 
     size *= -camera.camSetDistance;
     size = pow(size, 0.8)/800;
@@ -397,52 +568,287 @@ void drawTextVehicle(const CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 mvp
         }
     }
 
-    double u_step = (double)GlyphWidth / (double)textureWidth;
-    double v_step = (double)GlyphHeight / (double)textureHeight;
+    mvp.translate(x, y, 0);
+    mvp.scale(size);
+    drawTextLayout(gl, mvp, text, true, colorize, color);
+}
 
+void beginTextBatch()
+{
+    textBatchOpen = true;
+    textBatch.clear();
 
-    for (int n = 0; n < text.length(); n++)
+    if (++textFrame % TEXTSWEEPFRAMES) return;
+
+    //drop layouts of strings that have not been drawn for a while,
+    //like old pass numbers
+    for (int i = 0; i < 2; i++)
     {
-        char idx = text.at(n).toLatin1();
-        double u = (double)(idx % GlyphsPerLine) * u_step;
-        double v = (double)(idx / GlyphsPerLine) * v_step;
+        QHash<QString, TextLayout *>::iterator it = textLayouts[i].begin();
+        while (it != textLayouts[i].end())
+        {
+            if (textFrame - it.value()->lastUsed >= TEXTSWEEPFRAMES)
+            {
+                destroyTextLayout(it.value());
+                it = textLayouts[i].erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
 
-        vt.texcoord = QVector2D(u, v + v_step);
-        vt.vertex = QVector3D(x, y, 0);
-        gldraw.append(vt);
+void endTextBatch(QOpenGLFunctions *gl)
+{
+    textBatchOpen = false;
+    if (textBatch.isEmpty()) return;
+
+    if (textBatch != textBatchUploaded || !textBatchBuffer.isCreated())
+    {
+        QVector<VertexTexcoordColor> vertices;
+        QVector<VertexTexcoord> glyphs;
+
+        foreach (const TextBatchEntry &entry, textBatch)
+        {
+            QVector4D color(entry.color.redF(), entry.color.greenF(),
+                            entry.color.blueF(), entry.color.alphaF());
+
+            glyphs.clear();
+            layoutText(glyphs, entry.text, false);
+            foreach (const VertexTexcoord &vt, glyphs)
+            {
+                vertices.append({ QVector3D(entry.x + vt.vertex.x() * entry.size,
+                                            entry.y + vt.vertex.y() * entry.size, 0),
+                                  vt.texcoord, color });
+            }
+        }
+
+        if (!textBatchBuffer.isCreated())
+        {
+            textBatchBuffer.create();
+            glFrameStats.buffersCreated++;
+        }
+        textBatchBuffer.bind();
+        if (vertices.size() > textBatchCapacity)
+        {
+            textBatchCapacity = vertices.size() * 2;
+            textBatchBuffer.allocate(textBatchCapacity * (int)sizeof(VertexTexcoordColor));
+        }
+        textBatchBuffer.write(0, vertices.constData(), vertices.size() * (int)sizeof(VertexTexcoordColor));
+        textBatchBuffer.release();
+
+        textBatchCount = vertices.size();
+        textBatchUploaded = textBatch;
+    }
+
+    if (textBatchCount < 3) return;
+
+    texture[Textures::FONT]->bind();
+    glDrawArraysColorsTexture(gl, textBatchMvp, GL_TRIANGLES, textBatchBuffer,
+                              GL_FLOAT, textBatchCount);
+    texture[Textures::FONT]->release();
+}
+
+void destroyTextBuffers()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        foreach (TextLayout *layout, textLayouts[i])
+            destroyTextLayout(layout);
+        textLayouts[i].clear();
+    }
+
+    if (textBatchBuffer.isCreated()) textBatchBuffer.destroy();
+    textBatchUploaded.clear();
+    textBatchCount = 0;
+    textBatchCapacity = 0;
+}
+
+void beginGLFrame()
+{
+    frameStatsLock.lock();
+    lastFrameStats = glFrameStats;
+    frameStatsLock.unlock();
 
-        vt.texcoord = QVector2D(u + u_step, v + v_step);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y, 0);
-        gldraw.append(vt);
+    glFrameStats.buffersCreated = 0;
+    glFrameStats.streamDraws = 0;
+    glFrameStats.streamBytes = 0;
+    glFrameStats.streamOrphans = 0;
+    glFrameStats.geometryBytes = 0;
 
-        vt.texcoord = QVector2D(u, v);
-        vt.vertex = QVector3D(x, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
+    streamCurrent = (streamCurrent + 1) % STREAMBUFFERS;
+    streamOffset = 0;
 
-        vt.texcoord = QVector2D(u + u_step, v);
-        vt.vertex = QVector3D(x + GlyphWidth * size, y + GlyphHeight * size, 0);
-        gldraw.append(vt);
+    if (++geometryFrame % GEOMETRYSWEEPFRAMES) return;
 
-        x += CharXSpacing * size;
+    //lines of closed fields and objects that were moved or deleted
+    QHash<const void *, GeometryBuffer *>::iterator i = geometryBuffers.begin();
+    while (i != geometryBuffers.end())
+    {
+        if (geometryFrame - i.value()->lastUsed >= GEOMETRYSWEEPFRAMES)
+        {
+            if (i.value()->buffer.isCreated()) i.value()->buffer.destroy();
+            delete i.value();
+            i = geometryBuffers.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
     }
-    gldraw.draw(gl, mvp, Textures::FONT, GL_TRIANGLE_STRIP, colorize, color);
+}
+
+GLFrameStats lastGLFrameStats()
+{
+    QMutexLocker locker(&frameStatsLock);
+    return lastFrameStats;
+}
+
+QString glFrameStatsString()
+{
+    GLFrameStats stats = lastGLFrameStats();
+    return QString("frame buffers created=%1 stream draws=%2 bytes=%3 orphans=%4 static bytes=%5")
+            .arg(stats.buffersCreated)
+            .arg(stats.streamDraws)
+            .arg(stats.streamBytes)
+            .arg(stats.streamOrphans)
+            .arg(stats.geometryBytes);
+}
+
+//Copy data to the end of this frame's stream buffer and return its
+//byte offset. When the buffer is full it is orphaned: allocating it
+//again hands back fresh storage without waiting for draws still
+//reading the old one.
+static int streamWrite(const void *data, int bytes)
+{
+    QOpenGLBuffer &buffer = streamBuffers[streamCurrent];
+    int &capacity = streamCapacity[streamCurrent];
+
+    if (!buffer.isCreated())
+    {
+        buffer.create();
+        buffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        glFrameStats.buffersCreated++;
+        capacity = 0;
+    }
+
+    buffer.bind();
+
+    if (bytes > capacity)
+    {
+        //a long boundary or path, grow to fit it
+        capacity = qMax(STREAMBUFFERSIZE, bytes);
+        buffer.allocate(capacity);
+        streamOffset = 0;
+    }
+    else if (streamOffset + bytes > capacity)
+    {
+        buffer.allocate(capacity);
+        streamOffset = 0;
+        glFrameStats.streamOrphans++;
+    }
+
+    int offset = streamOffset;
+    buffer.write(offset, data, bytes);
+    buffer.release();
+
+    //keep every draw starting on a 16 byte boundary
+    streamOffset += (bytes + 15) & ~15;
+
+    glFrameStats.streamDraws++;
+    glFrameStats.streamBytes += bytes;
+
+    return offset;
+}
+
+void destroyStreamBuffers()
+{
+    for (int i = 0; i < STREAMBUFFERS; i++)
+    {
+        if (streamBuffers[i].isCreated()) streamBuffers[i].destroy();
+        streamCapacity[i] = 0;
+    }
+    streamOffset = 0;
+}
+
+int nextGeometryGeneration()
+{
+    return geometryGeneration.fetchAndAddOrdered(1) + 1;
+}
+
+bool isGeometryCurrent(const void *owner, int generation)
+{
+    GeometryBuffer *gb = geometryBuffers.value(owner, 0);
+    return gb && gb->generation == generation;
+}
+
+void uploadGeometry(const void *owner, int generation, const QVector<QVector3D> &vertices)
+{
+    GeometryBuffer *gb = geometryBuffers.value(owner, 0);
+    if (!gb)
+    {
+        gb = new GeometryBuffer;
+        gb->capacity = 0;
+        gb->buffer.create();
+        glFrameStats.buffersCreated++;
+        geometryBuffers[owner] = gb;
+    }
+
+    int bytes = vertices.size() * (int)sizeof(QVector3D);
+
+    gb->buffer.bind();
+    if (bytes > gb->capacity)
+    {
+        gb->capacity = bytes;
+        gb->buffer.allocate(vertices.constData(), bytes);
+    }
+    else if (bytes > 0)
+    {
+        gb->buffer.write(0, vertices.constData(), bytes);
+    }
+    gb->buffer.release();
+
+    gb->generation = generation;
+    gb->count = vertices.size();
+    gb->lastUsed = geometryFrame;
+
+    glFrameStats.geometryBytes += bytes;
+}
+
+void drawGeometry(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, const void *owner,
+                  QColor color, GLenum operation, float pointSize)
+{
+    GeometryBuffer *gb = geometryBuffers.value(owner, 0);
+    if (!gb || gb->count < 1) return;
+
+    gb->lastUsed = geometryFrame;
+    glDrawArraysColor(gl, mvp, operation, color, gb->buffer, GL_FLOAT,
+                      gb->count, pointSize);
+}
+
+void destroyGeometryBuffers()
+{
+    foreach (GeometryBuffer *gb, geometryBuffers)
+    {
+        if (gb->buffer.isCreated()) gb->buffer.destroy();
+        delete gb;
+    }
+    geometryBuffers.clear();
 }
 
 GLHelperOneColor::GLHelperOneColor() {
 }
 
 void GLHelperOneColor::draw(QOpenGLFunctions *gl, QMatrix4x4 mvp, QColor color, GLenum operation, float point_size) {
-    QOpenGLBuffer vertexBuffer;
-
-    vertexBuffer.create();
-    vertexBuffer.bind();
-    vertexBuffer.allocate(data(), size()*sizeof(QVector3D));
-    vertexBuffer.release();
+    if (size() < 1) return;
 
+    int offset = streamWrite(constData(), size()*sizeof(QVector3D));
 
     glDrawArraysColor(gl, mvp,operation,
-                      color, vertexBuffer, GL_FLOAT,
-                      size(),point_size);
+                      color, streamBuffers[streamCurrent], GL_FLOAT,
+                      size(),point_size, offset);
 
 }
 
@@ -450,17 +856,13 @@ GLHelperColors::GLHelperColors() {
 }
 
 void GLHelperColors::draw(QOpenGLFunctions *gl, QMatrix4x4 mvp, GLenum operation, float point_size) {
-    QOpenGLBuffer vertexBuffer;
-
-    vertexBuffer.create();
-    vertexBuffer.bind();
-    vertexBuffer.allocate(data(), size()*sizeof(ColorVertex));
-    vertexBuffer.release();
+    if (size() < 1) return;
 
+    int offset = streamWrite(constData(), size()*sizeof(ColorVertex));
 
     glDrawArraysColors(gl, mvp,operation,
-                       vertexBuffer, GL_FLOAT,
-                       size(),point_size);
+                       streamBuffers[streamCurrent], GL_FLOAT,
+                       size(),point_size, offset);
 
 }
 
@@ -472,6 +874,7 @@ void GLHelperTexture::draw(QOpenGLFunctions *gl, QMatrix4x4 mvp, Textures textur
 {
     QOpenGLBuffer vertexBuffer;
     vertexBuffer.create();
+    glFrameStats.buffersCreated++;
     vertexBuffer.bind();
     vertexBuffer.allocate(data(),size() * sizeof(VertexTexcoord));
     vertexBuffer.release();
@@ -22,6 +22,12 @@ struct VertexTexcoord {
     QVector2D texcoord;
 };
 
+struct VertexTexcoordColor {
+    QVector3D vertex;
+    QVector2D texcoord;
+    QVector4D color;
+};
+
 enum Textures {
     SKY=0,
     FLOOR=1,
@@ -39,6 +45,25 @@ enum Textures {
 extern bool isFontOn;
 extern QVector<QOpenGLTexture *> texture;
 
+//Per frame counters for the render thread. Anything that creates a
+//GL buffer object bumps buffersCreated on glFrameStats.
+struct GLFrameStats {
+    int buffersCreated;
+    int streamDraws;
+    int streamBytes;
+    int streamOrphans;
+    int geometryBytes;
+};
+
+extern GLFrameStats glFrameStats;
+
+//call at the start of every frame, from the render thread
+void beginGLFrame();
+
+//counters of the last finished frame, safe from any thread
+GLFrameStats lastGLFrameStats();
+QString glFrameStatsString();
+
 
 //thinking about putting GL buffer drawing routines here
 //like Draw box, etc. Do I put the shaders as module globals here?
@@ -50,12 +75,12 @@ void destroyShaders();
 void destroyTextures();
 
 //Simple wrapper to draw primitives using lists of Vec3 or QVector3Ds
-//with a single color.
+//with a single color. offset is in bytes from the start of the buffer.
 void glDrawArraysColor(QOpenGLFunctions *gl, QMatrix4x4 mvp,
                        GLenum operation, QColor color,
                        QOpenGLBuffer &vertexBuffer, GLenum glType,
                        int count,
-                       float pointSize=1.0f);
+                       float pointSize=1.0f, int offset=0);
 //Simple wrapper to draw primitives using lists of vec3s or QVector3Ds
 //with a color per vertex. Buffer format is 7 values per vertice:
 //x,y,z,r,g,b,a
@@ -63,7 +88,7 @@ void glDrawArraysColors(QOpenGLFunctions *gl, QMatrix4x4 mvp,
                        GLenum operation,
                        QOpenGLBuffer &vertexBuffer, GLenum glType,
                        int count,
-                       float pointSize=1.0f);
+                       float pointSize=1.0f, int offset=0);
 
 //Buffer format is 5 values per vertice:
 //x,y,z,texX,texY
@@ -71,12 +96,48 @@ void glDrawArraysTexture(QOpenGLFunctions *gl, QMatrix4x4 mvp,
                          GLenum operation,
                          QOpenGLBuffer &vertexBuffer, GLenum glType,
                          int count, bool useColor, QColor color);
+
+//Buffer format is 9 values per vertice:
+//x,y,z,texX,texY,r,g,b,a
+void glDrawArraysColorsTexture(QOpenGLFunctions *gl, QMatrix4x4 mvp,
+                               GLenum operation,
+                               QOpenGLBuffer &vertexBuffer, GLenum glType,
+                               int count);
 //draw arrays
 
 void drawText(QOpenGLFunctions *gl, QMatrix4x4 mvp, double x, double y, QString text, double size = 1.0, bool colorize = false, QColor color = QColor::fromRgbF(1,1,1));
 void drawText3D(const CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 mvp, double x1, double y1, QString text, double size = 1.0, bool colorize = false, QColor color = QColor::fromRgbF(1,1,1));
 void drawTextVehicle(const CCamera &camera, QOpenGLFunctions *gl, QMatrix4x4 mvp, double x, double y, QString text, double size = 1.0, bool colorize = false, QColor color = QColor::fromRgbF(1,1,1));
 
+//Between these two calls drawText() only records the string, and
+//endTextBatch() draws everything recorded in one call. The batch is
+//only uploaded again when the text, position, size or color changed
+//since the last frame.
+void beginTextBatch();
+void endTextBatch(QOpenGLFunctions *gl);
+
+//assume valid OpenGL context
+void destroyTextBuffers();
+
+//Field layers that only change on edit or load (boundaries, headlands,
+//turn lines, geofences, tram outline) keep their vertices on the GPU,
+//one buffer per owning object. The owner takes a new generation from
+//nextGeometryGeneration() whenever it rebuilds its points, and only
+//uploads when isGeometryCurrent() says the GPU copy is older.
+int nextGeometryGeneration();
+bool isGeometryCurrent(const void *owner, int generation);
+void uploadGeometry(const void *owner, int generation, const QVector<QVector3D> &vertices);
+void drawGeometry(QOpenGLFunctions *gl, const QMatrix4x4 &mvp, const void *owner,
+                  QColor color, GLenum operation, float pointSize);
+
+//assume valid OpenGL context
+void destroyGeometryBuffers();
+
+//GLHelperOneColor and GLHelperColors write their vertices into a
+//small ring of stream buffers, one per frame, instead of creating a
+//buffer object for every draw. Assume valid OpenGL context.
+void destroyStreamBuffers();
+
 class GLHelperOneColor: public QVector<QVector3D>
 {
 public:
@@ -495,6 +495,18 @@ Item {
                 anchors.leftMargin: 10
             }
 
+            Text {
+                id: fieldLoadProgress
+                objectName: "fieldLoadProgress"
+                visible: false
+                text: ""
+                font.pixelSize: 24
+                color: "white"
+                anchors.horizontalCenter: parent.horizontalCenter
+                anchors.top: parent.top
+                anchors.topMargin: 20
+            }
+
             /*
             Column {
                 id: zoomButtons
@@ -17,8 +17,8 @@ int main(int argc, char *argv[]) {
                      "$GPRMC,225616.4,A,4952.005620,asdfasdfsdf*10\r\n");
                      //"$GPRMC,225616.4,A,4952.005620,N,11143.030382,W,4.51,15.7,011116,0.0,E,D*10\r\n");
 
-    cnmea.rawBuffer = nmea1;
-    cnmea.parseNMEA();
+    cnmea.appendRaw(nmea1);
+    cnmea.parseNMEA(0, 0);
     std::cout << cnmea.latitude << ", " << cnmea.longitude << std::endl;
     std::cout << cnmea.updatedGGA << ", " << cnmea.updatedRMC <<std::endl;
     //GGA should update but RMC won't.